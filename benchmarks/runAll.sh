@@ -10,12 +10,35 @@ $LFCG src/PingPongUc.ulf
 $LFC src/ReactionLatencyC.lf
 $LFCG src/ReactionLatencyUc.ulf
 
+$LFCG src/EventQueueUc.ulf
+$LFCG src/EventPayloadPoolUc.ulf
+$LFCG src/TimerBankUc.ulf
+$LFCG src/AsyncIngressUc.ulf
+$LFCG src/FanOutUc.ulf
+$LFCG src/LevelParallelUc.ulf
+$LFCG src/ChainReleaseUc.ulf
+$LFCG src/FederatedStpCheckUc.ulf
+$LFCG src/DeadlineCheckUc.ulf
+$LFCG src/TimerJitterUc.ulf
+$LFCG src/RtLatencyUc.ulf
+
 echo "Running benchmarks..."
 
 ping_pong_c_result=$(bin/PingPongC | grep -E "Time: *.")
 ping_pong_uc_result=$(bin/PingPongUc | grep -E "Time: *.")
 latency_c_result=$(bin/ReactionLatencyC | grep -E " latency: *.")
 latency_uc_result=$(bin/ReactionLatencyUc | grep -E "latency: *.")
+event_queue_uc_result=$(bin/EventQueueUc | grep -E "nsec/op")
+event_payload_pool_uc_result=$(bin/EventPayloadPoolUc | grep -E "nsec/op")
+timer_bank_uc_result=$(bin/TimerBankUc | grep -E "nsec/tag")
+async_ingress_uc_result=$(bin/AsyncIngressUc | grep -E "nsec/event")
+fan_out_uc_result=$(bin/FanOutUc | grep -E "nsec/tag")
+level_parallel_uc_result=$(bin/LevelParallelUc | grep -E "nsec/tag")
+chain_release_uc_result=$(bin/ChainReleaseUc | grep -E "nsec/tag")
+federated_stp_check_uc_result=$(bin/FederatedStpCheckUc | grep -E "nsec/tag")
+deadline_check_uc_result=$(bin/DeadlineCheckUc | grep -E "nsec/tag")
+timer_jitter_uc_result=$(bin/TimerJitterUc | grep -E "wakeup error")
+rt_latency_uc_result=$(bin/RtLatencyUc | grep -E "wakeup latency")
 
 
 # Create or clear the output file
@@ -29,8 +52,8 @@ echo "" >> "$output_file"
 echo "## Performance:" >> "$output_file"
 echo "" >> "$output_file"
 
-benchmarks=("PingPongUc" "PingPongC" "ReactionLatencyUc" "ReactionLatencyC")
-results=("$ping_pong_uc_result" "$ping_pong_c_result" "$latency_uc_result" "$latency_c_result")
+benchmarks=("PingPongUc" "PingPongC" "ReactionLatencyUc" "ReactionLatencyC" "EventQueueUc" "EventPayloadPoolUc" "TimerBankUc" "AsyncIngressUc" "FanOutUc" "LevelParallelUc" "ChainReleaseUc" "FederatedStpCheckUc" "DeadlineCheckUc" "TimerJitterUc" "RtLatencyUc")
+results=("$ping_pong_uc_result" "$ping_pong_c_result" "$latency_uc_result" "$latency_c_result" "$event_queue_uc_result" "$event_payload_pool_uc_result" "$timer_bank_uc_result" "$async_ingress_uc_result" "$fan_out_uc_result" "$level_parallel_uc_result" "$chain_release_uc_result" "$federated_stp_check_uc_result" "$deadline_check_uc_result" "$timer_jitter_uc_result" "$rt_latency_uc_result")
 echo $latency_uc_result >> test.md
 
 for i in "${!benchmarks[@]}"; do
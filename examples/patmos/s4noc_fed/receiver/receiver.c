@@ -156,14 +156,14 @@ LF_FEDERATED_CONNECTION_BUNDLE_CTOR_SIGNATURE(Receiver, Sender) {
 typedef struct {                                                                                                     
   StartupCoordinator super;                                                                                          
   StartupEvent events[STARTUP_EVENT_SLOTS];                   // Startup event buffer
-  bool used[STARTUP_EVENT_SLOTS];                             // Tracks which events are in use
+  size_t free_list[STARTUP_EVENT_SLOTS];                      // Tracks which events are free
   NeighborState neighbors[NUM_NEIGHBORS];               // State for neighbors
 } ReceiverStartupCoordinator;
 
 
 void ReceiverStartupCoordinator_ctor(ReceiverStartupCoordinator *self, Environment *env) {
   StartupCoordinator_ctor(&self->super, env, self->neighbors, NUM_NEIGHBORS, NUM_NEIGHBORS, JOIN_IMMEDIATELY,
-                          sizeof(StartupEvent), (void *)self->events, self->used, STARTUP_EVENT_SLOTS);
+                          sizeof(StartupEvent), (void *)self->events, self->free_list, STARTUP_EVENT_SLOTS);
 }
 
   /* Clock synchronization: manages clock alignment with sender (if enabled) */
@@ -171,12 +171,12 @@ void ReceiverStartupCoordinator_ctor(ReceiverStartupCoordinator *self, Environme
     ClockSynchronization super;             // Base clock sync structure
     ClockSyncEvent events[CLOCK_SYNC_EVENT_SLOTS];               // Clock sync event buffer
     NeighborClock neighbor_clocks[NUM_NEIGHBOR_CLOCKS];       // Clock info for neighbors
-    bool used[CLOCK_SYNC_EVENT_SLOTS];                           // Tracks which events are in use
+    size_t free_list[CLOCK_SYNC_EVENT_SLOTS];                    // Tracks which events are free
   } ReceiverClockSynchronization;
 
   void ReceiverClockSynchronization_ctor(ReceiverClockSynchronization *self, Environment *env) {
     ClockSynchronization_ctor(&self->super, env, self->neighbor_clocks, NUM_NEIGHBOR_CLOCKS, CLOCK_SYNC_ALLOW_PHYS_TIME_ELAPSE,                   
-                              sizeof(ClockSyncEvent), (void *)self->events, self->used, CLOCK_SYNC_EVENT_SLOTS,                   
+                              sizeof(ClockSyncEvent), (void *)self->events, self->free_list, CLOCK_SYNC_EVENT_SLOTS,                   
                               CLOCK_SYNC_DEFAULT_PERIOD, CLOCK_SYNC_DEFAULT_MAX_ADJ, CLOCK_SYNC_DEFAULT_KP,            
                               CLOCK_SYNC_DEFAULT_KI);                                                                  
   }
@@ -226,8 +226,9 @@ static ArbitraryEvent events[NUM_EVENTS];    // Event queue buffer
 static EventQueue event_queue;              // Event queue structure
 static ArbitraryEvent system_events[NUM_SYSTEM_EVENTS];  // System event buffer
 static EventQueue system_event_queue;       // System event queue structure
-static Reaction *reactions[NUM_REACTIONS][NUM_REACTIONS];  // Reaction queue buffer
-static int level_size[NUM_REACTIONS];        // Reaction priority levels
+static Reaction *level_head[NUM_REACTIONS]; // First queued reaction per level
+static Reaction *level_tail[NUM_REACTIONS]; // Last queued reaction per level
+static uint32_t ready_levels[REACTION_QUEUE_READY_WORDS(NUM_REACTIONS)]; // Bitmap of non-empty levels
 static ReactionQueue reaction_queue;        // Reaction queue structure
 
 /* Cleanup function: called when receiver shuts down */
@@ -241,7 +242,7 @@ void lf_start_receiver() {
   // Initialize event and reaction queues
   EventQueue_ctor(&event_queue, events, NUM_EVENTS);
   EventQueue_ctor(&system_event_queue, system_events, NUM_SYSTEM_EVENTS);
-  ReactionQueue_ctor(&reaction_queue, (Reaction **)reactions, level_size, NUM_REACTIONS);
+  ReactionQueue_ctor(&reaction_queue, level_head, level_tail, ready_levels, NUM_REACTIONS);
   
   // Create scheduler
   DynamicScheduler_ctor(&scheduler, _lf_environment, &event_queue, &system_event_queue, &reaction_queue, TIMEOUT,
@@ -57,10 +57,17 @@ struct Action {
   lf_ret_t (*schedule)(Action* self, interval_t offset, const void* value);
 };
 
+/**
+ * @brief Let an action whose value type is `Token*` hold references to its tokens. Each scheduled event holds a
+ * reference, which moves to the value of the action when the event is handled and is dropped at the end of the tag.
+ * Called by the generated constructor.
+ */
+void Action_enable_tokens(Action* self);
+
 void Action_ctor(Action* self, ActionType type, ActionPolicy policy, interval_t min_offset, interval_t min_spacing,
                  Reactor* parent, Reaction** sources, size_t sources_size, Reaction** effects, size_t effects_size,
                  Reaction** observers, size_t observers_size, void* value_ptr, size_t value_size, void* payload_buf,
-                 bool* payload_used_buf, size_t event_bound);
+                 size_t* payload_free_list_buf, size_t event_bound);
 
 struct LogicalAction {
   Action super;
@@ -69,7 +76,7 @@ struct LogicalAction {
 void LogicalAction_ctor(LogicalAction* self, ActionPolicy policy, interval_t min_offset, interval_t min_spacing,
                         Reactor* parent, Reaction** sources, size_t sources_size, Reaction** effects,
                         size_t effects_size, Reaction** observers, size_t observers_size, void* value_ptr,
-                        size_t value_size, void* payload_buf, bool* payload_used_buf, size_t event_bound);
+                        size_t value_size, void* payload_buf, size_t* payload_free_list_buf, size_t event_bound);
 
 struct PhysicalAction {
   Action super;
@@ -79,5 +86,5 @@ struct PhysicalAction {
 void PhysicalAction_ctor(PhysicalAction* self, ActionPolicy policy, interval_t min_offset, interval_t min_spacing,
                          Reactor* parent, Reaction** sources, size_t sources_size, Reaction** effects,
                          size_t effects_size, Reaction** observers, size_t observers_size, void* value_ptr,
-                         size_t value_size, void* payload_buf, bool* payload_used_buf, size_t event_bound);
+                         size_t value_size, void* payload_buf, size_t* payload_free_list_buf, size_t event_bound);
 #endif
@@ -33,12 +33,25 @@ void Connection_ctor(Connection* self, TriggerType type, Reactor* parent, Port**
                      EventPayloadPool* payload_pool, void (*prepare)(Trigger*, Event*), void (*cleanup)(Trigger*),
                      void (*trigger_downstreams)(Connection*, tag_t, const void*, size_t));
 
+/**
+ * @brief A connection which triggers its downstream ports at the same tag. In aliasing mode, a downstream input whose
+ * value reaches it only through aliasing logical connections does not get a copy of the value. Its `value_ptr` points
+ * into the buffer of the final upstream output instead, and must be read with `lf_get`. The aliases are resolved when
+ * the program is assembled.
+ */
 struct LogicalConnection {
   Connection super;
+  bool aliasing; // Whether the downstream inputs alias the buffer of the final upstream output.
 };
 
 void LogicalConnection_ctor(LogicalConnection* self, Reactor* parent, Port** downstreams, size_t num_downstreams);
 
+/**
+ * @brief A connection which triggers its downstream ports `delay` after the value was written. A logical delayed
+ * connection with a payload buffer keeps its values in a FIFO ring, in the order of their tags. Only the value at the
+ * head of the ring has an event in the event queue, the event for the next value is scheduled when the head is
+ * handled. Physical and void delayed connections schedule one event per value.
+ */
 struct DelayedConnection {
   Connection super;
   interval_t delay;
@@ -47,10 +60,13 @@ struct DelayedConnection {
   void* staged_payload_ptr;
   tag_t intended_tag;
   bool has_staged_value; // Track staging separately from payload pointer (needed for void ports)
+  tag_t* ring_tags;      // Tags of the values in the ring, NULL if each value is scheduled as its own event.
+  size_t ring_head;      // Index of the oldest value in the ring.
+  size_t ring_size;      // Number of values in the ring.
 };
 
 void DelayedConnection_ctor(DelayedConnection* self, Reactor* parent, Port** downstreams, size_t num_downstreams,
                             interval_t delay, ConnectionType type, size_t payload_size, void* payload_buf,
-                            bool* payload_used_buf, size_t payload_buf_capacity);
+                            size_t* payload_free_list_buf, tag_t* payload_tags_buf, size_t payload_buf_capacity);
 
 #endif
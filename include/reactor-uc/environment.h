@@ -10,6 +10,7 @@
 
 #include "reactor-uc/builtin_triggers.h"
 #include "reactor-uc/error.h"
+#include "reactor-uc/port.h"
 #include "reactor-uc/reactor.h"
 #include "reactor-uc/scheduler.h"
 #include "reactor-uc/queues.h"
@@ -28,6 +29,10 @@ struct Environment {
                   // before handling events.
   BuiltinTrigger* startup;  // A pointer to a startup trigger, if the program has one.
   BuiltinTrigger* shutdown; // A pointer to a chain of shutdown triggers, if the program has one.
+#if PORT_FANOUT_TABLE_SIZE > 0
+  FanoutRecord fanout_records[PORT_FANOUT_TABLE_SIZE]; // Storage for the fan-out tables of all ports.
+  size_t fanout_records_used;                          // Number of records taken by the fan-out tables.
+#endif
   /**
    * @private
    * @brief Assemble the program by computing levels for each reaction and setting up the scheduler.
@@ -5,6 +5,7 @@
 #include "reactor-uc/tag.h"
 #include "reactor-uc/platform.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #define EVENT_INIT(Tag, Trigger, Payload)                                                                              \
   {.super.type = EVENT, .super.tag = Tag, .intended_tag = Tag, .trigger = Trigger, .super.payload = Payload}
@@ -46,15 +47,31 @@ typedef struct {
   };
 } ArbitraryEvent;
 
+/** Marks an allocated payload in `EventPayloadPool::free_list`. */
+#define EVENT_PAYLOAD_POOL_USED SIZE_MAX
+
 struct EventPayloadPool {
   char* buffer;
-  bool* used;
+  /**
+   * One entry per payload. For a free payload, the index of the next free payload in the same partition, or `capacity`
+   * at the end of the list. For an allocated payload, EVENT_PAYLOAD_POOL_USED.
+   */
+  size_t* free_list;
+  /** Index of the first free payload in `[reserved, capacity)`, or `capacity` if there is none. */
+  size_t free_head;
+  /** Index of the first free payload in `[0, reserved)`, or `capacity` if there is none. */
+  size_t reserved_free_head;
   /** Number of bytes per payload */
   size_t payload_size;
   /**  Max number of allocated payloads*/
   size_t capacity;
   /** Number of payloads reserved to be allocated through `allocate_reserved` */
   size_t reserved;
+  /**
+   * Whether each payload is a `Token*` holding a reference to its token. Allocated payloads start out as NULL, and
+   * freeing a payload releases its token.
+   */
+  bool holds_tokens;
 
   MUTEX_T mutex;
 
@@ -71,8 +88,8 @@ struct SystemEventHandler {
   EventPayloadPool payload_pool;
 };
 
-void EventPayloadPool_ctor(EventPayloadPool* self, char* buffer, bool* used, size_t element_size, size_t capacity,
-                           size_t reserved);
+void EventPayloadPool_ctor(EventPayloadPool* self, char* buffer, size_t* free_list, size_t element_size,
+                           size_t capacity, size_t reserved);
 
 /**
  * @brief Get the tag of an arbitrary event.
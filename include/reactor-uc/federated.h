@@ -127,6 +127,6 @@ struct FederatedInputConnection {
 
 void FederatedInputConnection_ctor(FederatedInputConnection* self, Reactor* parent, interval_t delay, bool is_physical,
                                    interval_t max_wait, Port** downstreams, size_t downstreams_size, void* payload_buf,
-                                   bool* payload_used_buf, size_t payload_size, size_t payload_buf_capacity);
+                                   size_t* payload_free_list_buf, size_t payload_size, size_t payload_buf_capacity);
 
 #endif
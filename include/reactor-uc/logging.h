@@ -36,6 +36,31 @@
 #define LF_TIMESTAMP_LOGS 0
 #endif
 
+/**
+ * With LF_LOG_DEFERRED, log messages below the error level are not formatted by the thread logging them. Instead, the
+ * format string, the timestamp and the raw arguments are written into a lock-free ring buffer, which is formatted and
+ * printed by `log_flush`. On POSIX, a background thread calls `log_flush` periodically and when the program exits.
+ * Errors are printed synchronously, after the buffered messages. Messages logged while the buffer is full are dropped
+ * and counted. Only the conversions of printf without `%n` and `%L` are supported, and `%s` arguments are copied into
+ * the record, truncated to LF_LOG_DEFERRED_STRING_SIZE bytes in total.
+ */
+#if defined(LF_LOG_DEFERRED)
+/** The number of records in the ring buffer. Must be a power of two.*/
+#ifndef LF_LOG_DEFERRED_BUFFER_SIZE
+#define LF_LOG_DEFERRED_BUFFER_SIZE 256
+#endif
+
+/** The maximum number of arguments of a log message, further arguments are printed as `?`.*/
+#ifndef LF_LOG_DEFERRED_MAX_ARGS
+#define LF_LOG_DEFERRED_MAX_ARGS 8
+#endif
+
+/** The number of bytes in each record for copies of the `%s` arguments, including their terminators.*/
+#ifndef LF_LOG_DEFERRED_STRING_SIZE
+#define LF_LOG_DEFERRED_STRING_SIZE 64
+#endif
+#endif
+
 // The default log level for any unspecified module
 #ifndef LF_LOG_LEVEL_ALL
 #ifndef NDEBUG
@@ -175,4 +200,9 @@
 void log_message(int level, const char* module, const char* fmt, ...);
 #endif
 
+/**
+ * @brief Format and print all deferred log messages. Does nothing unless LF_LOG_DEFERRED is defined.
+ */
+void log_flush(void);
+
 #endif
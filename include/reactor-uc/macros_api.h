@@ -37,14 +37,21 @@
     _port->set(_port, array);                                                                                          \
   } while (0)
 
+/// @private
+static inline void* lf_get_value_ptr(Trigger* trigger, void* value) {
+  return trigger->type == TRIG_INPUT ? ((Port*)trigger)->value_ptr : value;
+}
+
 /**
  * @brief Get the value of an input port.
  *
- * This macro retrieves a pointer to the value of the input port.
+ * This macro retrieves a pointer to the value of the input port. An input connected through an aliasing logical
+ * connection has no copy of the value, the pointer then points into the buffer of the upstream output and the value
+ * must not be modified through it.
  *
  * @param port The input port.
  */
-#define lf_get(trigger) (&(trigger)->value)
+#define lf_get(trigger) ((__typeof__(&(trigger)->value))lf_get_value_ptr((Trigger*)(trigger), &(trigger)->value))
 
 /**
  * @brief Return whether the trigger is present at the current logical tag.
@@ -121,4 +128,56 @@ lf_ret_t lf_schedule_with_value(Action* action, interval_t offset, const void* v
  */
 #define lf_set(...) LF_SET_CHOOSER(__VA_ARGS__)(__VA_ARGS__)
 
+/**
+ * @brief Take a token from a pool defined with LF_DEFINE_TOKEN_POOL_STRUCT. The buffer is written through
+ * `token->value` before the token is set on a port or scheduled on an action. NULL if the pool is exhausted.
+ *
+ * @param pool Pointer to the token pool.
+ */
+#define lf_new_token(pool) TokenPool_acquire(&(pool)->super)
+
+/**
+ * @brief Set a token on an output port of type `Token*`. Only the pointer is passed on, every downstream port reading
+ * the value takes a reference to the token, which returns to its pool at the end of the tag unless a delayed connection
+ * or an action still holds it.
+ *
+ * @param port The output port.
+ * @param token The token to set.
+ */
+#define lf_set_token(port, token)                                                                                      \
+  do {                                                                                                                 \
+    Token* __token = (token);                                                                                          \
+    Port* _port = (Port*)(port);                                                                                       \
+    validate(_port->holds_tokens);                                                                                     \
+    _port->set(_port, &__token);                                                                                       \
+  } while (0)
+
+/**
+ * @brief Get the token of a port or action of type `Token*`. It is valid until the end of the tag, a reaction which
+ * keeps it longer takes its own reference with `Token_retain`.
+ */
+#define lf_get_token(trigger) ((trigger)->value)
+
+/**
+ * @brief Schedule a token on an action of type `Token*`. The event holds a reference to the token until it is handled.
+ *
+ * @param action The action to schedule.
+ * @param offset The offset from the current logical tag to schedule the event.
+ * @param token The token to schedule.
+ */
+#define lf_schedule_token(action, offset, token)                                                                       \
+  ({                                                                                                                   \
+    Token* __token = (token);                                                                                          \
+    Action* __a = (Action*)(action);                                                                                   \
+    validate(__a->payload_pool.holds_tokens);                                                                          \
+    __a->schedule(__a, (offset), &__token);                                                                            \
+  })
+
+/**
+ * @brief Get the time which was left until the deadline of the current reaction when it was released. This is the
+ * value its deadline was checked against, so reading it does not sample physical time again. FOREVER if the reaction
+ * has no deadline.
+ */
+#define lf_deadline_slack() (_self->deadline_slack)
+
 #endif
@@ -148,6 +148,9 @@
     Port_ctor(&self->super, TRIG_OUTPUT, parent, &self->value, sizeof(self->value), external.parent_effects,           \
               external.parent_effects_size, self->sources, SourceSize, external.parent_observers,                      \
               external.parent_observers_size, external.conns_out, external.conns_out_size);                            \
+    if (LF_IS_TOKEN(self->value)) {                                                                                    \
+      Port_enable_tokens(&self->super);                                                                                \
+    }                                                                                                                  \
   }
 
 #define LF_DEFINE_OUTPUT_VOID_CTOR(ReactorName, PortName, SourceSize)                                                  \
@@ -209,6 +212,9 @@
     Port_ctor(&self->super, TRIG_INPUT, parent, &self->value, sizeof(self->value), self->effects, (EffectSize),        \
               external.parent_sources, external.parent_sources_size, self->observers, ObserverSize,                    \
               (Connection**)&self->conns_out, NumConnsOut);                                                            \
+    if (LF_IS_TOKEN(self->value)) {                                                                                    \
+      Port_enable_tokens(&self->super);                                                                                \
+    }                                                                                                                  \
   }
 
 #define LF_DEFINE_INPUT_VOID_CTOR(ReactorName, PortName, EffectSize, ObserverSize, NumConnsOut)                        \
@@ -315,7 +321,7 @@
     ActionType super;                                                                                                  \
     BufferType value;                                                                                                  \
     BufferType payload_buf[(MaxPendingEvents)];                                                                        \
-    bool payload_used_buf[(MaxPendingEvents)];                                                                         \
+    size_t payload_free_list_buf[(MaxPendingEvents)];                                                                  \
     Reaction* sources[(SourceSize)];                                                                                   \
     Reaction* effects[(EffectSize)];                                                                                   \
     Reaction* observers[(ObserverSize)];                                                                               \
@@ -327,7 +333,7 @@
     ActionType super;                                                                                                  \
     BufferType value[(ArrayLength)];                                                                                   \
     BufferType payload_buf[(ArrayLength)][(MaxPendingEvents)];                                                         \
-    bool payload_used_buf[(MaxPendingEvents)];                                                                         \
+    size_t payload_free_list_buf[(MaxPendingEvents)];                                                                  \
     Reaction* sources[(SourceSize)];                                                                                   \
     Reaction* effects[(EffectSize)];                                                                                   \
     Reaction* observers[(ObserverSize)];                                                                               \
@@ -348,7 +354,10 @@
                                          interval_t min_spacing) {                                                     \
     ActionType##_ctor(&self->super, ActionPolicy, min_delay, min_spacing, parent, self->sources, (SourceSize),         \
                       self->effects, (EffectSize), self->observers, ObserverSize, &self->value, sizeof(self->value),   \
-                      (void*)&self->payload_buf, self->payload_used_buf, (MaxPendingEvents));                          \
+                      (void*)&self->payload_buf, self->payload_free_list_buf, (MaxPendingEvents));                     \
+    if (LF_IS_TOKEN(self->value)) {                                                                                    \
+      Action_enable_tokens((Action*)&self->super);                                                                     \
+    }                                                                                                                  \
   }
 
 #define LF_DEFINE_ACTION_CTOR_VOID(ReactorName, ActionName, ActionType, ActionPolicy, EffectSize, SourceSize,          \
@@ -414,6 +423,13 @@
                            sizeof(self->downstreams) / sizeof(self->downstreams[0]));                                  \
   }
 
+#define LF_DEFINE_ALIASING_LOGICAL_CONNECTION_CTOR(ParentName, ConnName, DownstreamSize)                               \
+  void ParentName##_##ConnName##_ctor(ParentName##_##ConnName* self, Reactor* parent) {                                \
+    LogicalConnection_ctor(&self->super, parent, self->downstreams,                                                    \
+                           sizeof(self->downstreams) / sizeof(self->downstreams[0]));                                  \
+    self->super.aliasing = true;                                                                                       \
+  }
+
 #define LF_LOGICAL_CONNECTION_INSTANCE(ParentName, ConnName, BankWidth, PortWidth)                                     \
   ParentName##_##ConnName ConnName[BankWidth][PortWidth];
 
@@ -467,7 +483,8 @@
   typedef struct {                                                                                                     \
     DelayedConnection super;                                                                                           \
     BufferType payload_buf[(BufferSize)];                                                                              \
-    bool payload_used_buf[(BufferSize)];                                                                               \
+    size_t payload_free_list_buf[(BufferSize)];                                                                        \
+    tag_t payload_tags[(BufferSize)];                                                                                  \
     Port* downstreams[(DownstreamSize)];                                                                               \
   } ParentName##_##ConnName;
 
@@ -476,7 +493,8 @@
   typedef struct {                                                                                                     \
     DelayedConnection super;                                                                                           \
     BufferType payload_buf[(BufferSize)][(ArrayLength)];                                                               \
-    bool payload_used_buf[(BufferSize)];                                                                               \
+    size_t payload_free_list_buf[(BufferSize)];                                                                        \
+    tag_t payload_tags[(BufferSize)];                                                                                  \
     Port* downstreams[(DownstreamSize)];                                                                               \
   } ParentName##_##ConnName;
 
@@ -489,14 +507,15 @@
 #define LF_DEFINE_DELAYED_CONNECTION_CTOR(ParentName, ConnName, DownstreamSize, BufferSize, IsPhysical)                \
   void ParentName##_##ConnName##_ctor(ParentName##_##ConnName* self, Reactor* parent, interval_t delay) {              \
     DelayedConnection_ctor(&self->super, parent, self->downstreams, DownstreamSize, delay, IsPhysical,                 \
-                           sizeof(self->payload_buf[0]), (void*)self->payload_buf, self->payload_used_buf,             \
-                           BufferSize);                                                                                \
+                           sizeof(self->payload_buf[0]), (void*)self->payload_buf, self->payload_free_list_buf,        \
+                           self->payload_tags, BufferSize);                                                            \
+    self->super.payload_pool.holds_tokens = LF_IS_TOKEN(self->payload_buf[0]);                                         \
   }
 
 #define LF_DEFINE_DELAYED_CONNECTION_VOID_CTOR(ParentName, ConnName, DownstreamSize, IsPhysical)                       \
   void ParentName##_##ConnName##_ctor(ParentName##_##ConnName* self, Reactor* parent, interval_t delay) {              \
     DelayedConnection_ctor(&self->super, parent, self->downstreams, DownstreamSize, delay, IsPhysical, 0, NULL, NULL,  \
-                           0);                                                                                         \
+                           NULL, 0);                                                                                   \
   }
 
 // FIXME: Duplicated
@@ -585,7 +604,7 @@ typedef struct FederatedInputConnection FederatedInputConnection;
   typedef struct {                                                                                                     \
     FederatedInputConnection super;                                                                                    \
     BufferType payload_buf[(BufferSize)];                                                                              \
-    bool payload_used_buf[(BufferSize)];                                                                               \
+    size_t payload_free_list_buf[(BufferSize)];                                                                        \
     Port* downstreams[1];                                                                                              \
   } ReactorName##_##InputName##_conn;
 
@@ -593,7 +612,7 @@ typedef struct FederatedInputConnection FederatedInputConnection;
   typedef struct {                                                                                                     \
     FederatedInputConnection super;                                                                                    \
     BufferType payload_buf[(BufferSize)][(ArrayLength)];                                                               \
-    bool payload_used_buf[(BufferSize)];                                                                               \
+    size_t payload_free_list_buf[(BufferSize)];                                                                        \
     Port* downstreams[1];                                                                                              \
   } ReactorName##_##InputName##_conn;
 
@@ -607,7 +626,7 @@ typedef struct FederatedInputConnection FederatedInputConnection;
                                                   MaxWait)                                                             \
   void ReactorName##_##InputName##_conn_ctor(ReactorName##_##InputName##_conn* self, Reactor* parent) {                \
     FederatedInputConnection_ctor(&self->super, parent, Delay, IsPhysical, MaxWait, (Port**)&self->downstreams, 1,     \
-                                  (void*)&self->payload_buf, (bool*)&self->payload_used_buf,                           \
+                                  (void*)&self->payload_buf, self->payload_free_list_buf,                              \
                                   sizeof(self->payload_buf[0]), BufferSize);                                           \
   }
 
@@ -623,14 +642,14 @@ typedef struct FederatedInputConnection FederatedInputConnection;
   typedef struct {                                                                                                     \
     StartupCoordinator super;                                                                                          \
     StartupEvent events[(NumEvents)];                                                                                  \
-    bool used[(NumEvents)];                                                                                            \
+    size_t free_list[(NumEvents)];                                                                                     \
     NeighborState neighbors[NumNeighbors];                                                                             \
   } ReactorName##StartupCoordinator;
 
 #define LF_DEFINE_STARTUP_COORDINATOR_CTOR(ReactorName, NumNeighbors, LongestPath, NumEvents, JoiningPolicy)           \
   void ReactorName##StartupCoordinator_ctor(ReactorName##StartupCoordinator* self, Environment* env) {                 \
     StartupCoordinator_ctor(&self->super, env, self->neighbors, NumNeighbors, LongestPath, JoiningPolicy,              \
-                            sizeof(StartupEvent), (void*)self->events, self->used, (NumEvents));                       \
+                            sizeof(StartupEvent), (void*)self->events, self->free_list, (NumEvents));                  \
   }
 
 #define LF_DEFINE_STARTUP_COORDINATOR(ReactorName) ReactorName##StartupCoordinator startup_coordinator;
@@ -642,13 +661,13 @@ typedef struct FederatedInputConnection FederatedInputConnection;
   typedef struct {                                                                                                     \
     ShutdownCoordinator super;                                                                                         \
     ShutdownEvent events[(NumEvents)];                                                                                 \
-    bool used[(NumEvents)];                                                                                            \
+    size_t free_list[(NumEvents)];                                                                                     \
   } ReactorName##ShutdownCoordinator;
 
 #define LF_DEFINE_SHUTDOWN_COORDINATOR_CTOR(ReactorName, LongestPath, NumEvents)                                       \
   void ReactorName##ShutdownCoordinator_ctor(ReactorName##ShutdownCoordinator* self, Environment* env) {               \
-    ShutdownCoordinator_ctor(&self->super, env, LongestPath, sizeof(ShutdownEvent), (void*)self->events, self->used,   \
-                             (NumEvents));                                                                             \
+    ShutdownCoordinator_ctor(&self->super, env, LongestPath, sizeof(ShutdownEvent), (void*)self->events,               \
+                             self->free_list, (NumEvents));                                                            \
   }
 
 #define LF_DEFINE_SHUTDOWN_COORDINATOR(ReactorName) ReactorName##ShutdownCoordinator shutdown_coordinator;
@@ -661,20 +680,20 @@ typedef struct FederatedInputConnection FederatedInputConnection;
     ClockSynchronization super;                                                                                        \
     ClockSyncEvent events[(NumEvents)];                                                                                \
     NeighborClock neighbor_clocks[(NumNeighbors)];                                                                     \
-    bool used[(NumEvents)];                                                                                            \
+    size_t free_list[(NumEvents)];                                                                                     \
   } ReactorName##ClockSynchronization;
 
 #define LF_DEFINE_CLOCK_SYNC_CTOR(ReactorName, NumNeighbors, NumEvents, IsGrandmaster, Period, MaxAdj, Kp, Ki)         \
   void ReactorName##ClockSynchronization_ctor(ReactorName##ClockSynchronization* self, Environment* env) {             \
     ClockSynchronization_ctor(&self->super, env, self->neighbor_clocks, NumNeighbors, IsGrandmaster,                   \
-                              sizeof(ClockSyncEvent), (void*)self->events, self->used, (NumEvents), Period, MaxAdj,    \
-                              Kp, Ki);                                                                                 \
+                              sizeof(ClockSyncEvent), (void*)self->events, self->free_list, (NumEvents), Period,       \
+                              MaxAdj, Kp, Ki);                                                                         \
   }
 
 #define LF_DEFINE_CLOCK_SYNC_DEFAULTS_CTOR(ReactorName, NumNeighbors, NumEvents, IsGrandmaster)                        \
   void ReactorName##ClockSynchronization_ctor(ReactorName##ClockSynchronization* self, Environment* env) {             \
     ClockSynchronization_ctor(&self->super, env, self->neighbor_clocks, NumNeighbors, IsGrandmaster,                   \
-                              sizeof(ClockSyncEvent), (void*)self->events, self->used, (NumEvents),                    \
+                              sizeof(ClockSyncEvent), (void*)self->events, self->free_list, (NumEvents),               \
                               CLOCK_SYNC_DEFAULT_PERIOD, CLOCK_SYNC_DEFAULT_MAX_ADJ, CLOCK_SYNC_DEFAULT_KP,            \
                               CLOCK_SYNC_DEFAULT_KI);                                                                  \
   }
@@ -715,41 +734,83 @@ typedef struct FederatedInputConnection FederatedInputConnection;
     self->_children[_child_idx++] = &self->instanceName[i].super;                                                      \
   }
 
+#if defined(EVENT_QUEUE_DARY)
+#define LF_DEFINE_EVENT_QUEUE(Name, NumEvents)                                                                         \
+  typedef struct {                                                                                                     \
+    union {                                                                                                            \
+      EventQueue super;                                                                                                \
+      DaryEventQueue dary;                                                                                             \
+    };                                                                                                                 \
+    ArbitraryEvent events[(NumEvents)];                                                                                \
+    tag_t keys[(NumEvents)];                                                                                           \
+    size_t heap[(NumEvents)];                                                                                          \
+    size_t heap_pos[(NumEvents)];                                                                                      \
+    size_t index[2 * (NumEvents) + 1];                                                                                 \
+    size_t index_pos[(NumEvents) + 1];                                                                                 \
+  } Name##_t;                                                                                                          \
+  static Name##_t Name;
+
+#define LF_INITIALIZE_EVENT_QUEUE(Name, NumEvents)                                                                     \
+  DaryEventQueue_ctor(&Name.dary, Name.events, NumEvents, Name.keys, Name.heap, Name.heap_pos, Name.index,             \
+                      Name.index_pos, 2 * (NumEvents) + 1);
+#elif defined(EVENT_QUEUE_RADIX)
+#define LF_DEFINE_EVENT_QUEUE(Name, NumEvents)                                                                         \
+  typedef struct {                                                                                                     \
+    union {                                                                                                            \
+      EventQueue super;                                                                                                \
+      RadixEventQueue radix;                                                                                           \
+    };                                                                                                                 \
+    ArbitraryEvent events[(NumEvents)];                                                                                \
+    size_t next[(NumEvents)];                                                                                          \
+    size_t prev[(NumEvents)];                                                                                          \
+    uint8_t bucket[(NumEvents)];                                                                                       \
+    size_t index[2 * (NumEvents) + 1];                                                                                 \
+    size_t index_pos[(NumEvents) + 1];                                                                                 \
+  } Name##_t;                                                                                                          \
+  static Name##_t Name;
+
+#define LF_INITIALIZE_EVENT_QUEUE(Name, NumEvents)                                                                     \
+  RadixEventQueue_ctor(&Name.radix, Name.events, NumEvents, Name.next, Name.prev, Name.bucket, Name.index,             \
+                       Name.index_pos, 2 * (NumEvents) + 1);
+#else
 #define LF_DEFINE_EVENT_QUEUE(Name, NumEvents)                                                                         \
   typedef struct {                                                                                                     \
     EventQueue super;                                                                                                  \
     ArbitraryEvent events[(NumEvents)];                                                                                \
+    size_t index[2 * (NumEvents) + 1];                                                                                 \
+    size_t index_pos[(NumEvents) + 1];                                                                                 \
   } Name##_t;                                                                                                          \
   static Name##_t Name;
 
+#define LF_INITIALIZE_EVENT_QUEUE(Name, NumEvents)                                                                     \
+  EventQueue_ctor_indexed(&Name.super, Name.events, NumEvents, Name.index, Name.index_pos, 2 * (NumEvents) + 1);
+#endif
+
 #define LF_DEFINE_REACTION_QUEUE(Name, NumReactions)                                                                   \
   typedef struct {                                                                                                     \
     ReactionQueue super;                                                                                               \
-    Reaction* reactions[(NumReactions)][(NumReactions)];                                                               \
-    int level_size[(NumReactions)];                                                                                    \
+    Reaction* level_head[(NumReactions)];                                                                              \
+    Reaction* level_tail[(NumReactions)];                                                                              \
+    uint32_t ready[REACTION_QUEUE_READY_WORDS(NumReactions)];                                                          \
   } Name##_t;                                                                                                          \
   static Name##_t Name;
 
-#define LF_INITIALIZE_EVENT_QUEUE(Name, NumEvents) EventQueue_ctor(&Name.super, Name.events, NumEvents);
-
 #define LF_INITIALIZE_REACTION_QUEUE(Name, NumReactions)                                                               \
-  ReactionQueue_ctor(&Name.super, (Reaction**)Name.reactions, Name.level_size, NumReactions);
+  ReactionQueue_ctor(&Name.super, Name.level_head, Name.level_tail, Name.ready, NumReactions);
 
 #define LF_ENTRY_POINT(MainReactorName, NumEvents, NumReactions, Timeout, KeepAlive, Fast)                             \
   static MainReactorName main_reactor;                                                                                 \
   static Environment env;                                                                                              \
   Environment* _lf_environment = &env;                                                                                 \
-  static ArbitraryEvent events[NumEvents];                                                                             \
-  static EventQueue event_queue;                                                                                       \
-  static Reaction* reactions[NumReactions][NumReactions];                                                              \
-  static int level_size[NumReactions];                                                                                 \
-  static ReactionQueue reaction_queue;                                                                                 \
+  LF_DEFINE_EVENT_QUEUE(event_queue, NumEvents)                                                                        \
+  LF_DEFINE_REACTION_QUEUE(reaction_queue, NumReactions)                                                               \
   static DynamicScheduler scheduler;                                                                                   \
   void lf_exit(void) { Environment_free(&env); }                                                                       \
   void lf_start() {                                                                                                    \
-    EventQueue_ctor(&event_queue, events, NumEvents);                                                                  \
-    ReactionQueue_ctor(&reaction_queue, (Reaction**)reactions, level_size, NumReactions);                              \
-    DynamicScheduler_ctor(&scheduler, _lf_environment, &event_queue, NULL, &reaction_queue, (Timeout), (KeepAlive));   \
+    LF_INITIALIZE_EVENT_QUEUE(event_queue, NumEvents)                                                                  \
+    LF_INITIALIZE_REACTION_QUEUE(reaction_queue, NumReactions)                                                         \
+    DynamicScheduler_ctor(&scheduler, _lf_environment, &event_queue.super, NULL, &reaction_queue.super, (Timeout),     \
+                          (KeepAlive));                                                                                \
     Environment_ctor(&env, (Reactor*)&main_reactor, &scheduler.super, Fast);                                           \
     MainReactorName##_ctor(&main_reactor, NULL, &env);                                                                 \
     env.scheduler->duration = Timeout;                                                                                 \
@@ -760,26 +821,41 @@ typedef struct FederatedInputConnection FederatedInputConnection;
     lf_exit();                                                                                                         \
   }
 
+// Entry point of a program executed by the StaticScheduler. `Schedule` is declared here and must be defined after the
+// macro as an array of NumWorkers instruction lists, so that the instructions can refer to `main_reactor` and to the
+// registers of `scheduler`.
+#define LF_ENTRY_POINT_STATIC(MainReactorName, Schedule, NumWorkers, Timeout, Fast)                                    \
+  static MainReactorName main_reactor;                                                                                 \
+  static Environment env;                                                                                              \
+  Environment* _lf_environment = &env;                                                                                 \
+  static StaticScheduler scheduler;                                                                                    \
+  static const inst_t* Schedule[NumWorkers];                                                                           \
+  void lf_exit(void) { Environment_free(&env); }                                                                       \
+  void lf_start() {                                                                                                    \
+    StaticScheduler_ctor(&scheduler, _lf_environment, Schedule, (NumWorkers), (Timeout));                              \
+    Environment_ctor(&env, (Reactor*)&main_reactor, &scheduler.super, Fast);                                           \
+    MainReactorName##_ctor(&main_reactor, NULL, &env);                                                                 \
+    env.assemble(&env);                                                                                                \
+    env.start(&env);                                                                                                   \
+    lf_exit();                                                                                                         \
+  }
+
 #define LF_ENTRY_POINT_FEDERATED(FederateName, NumEvents, NumSystemEvents, NumReactions, Timeout, KeepAlive,           \
                                  NumBundles, DoClockSync)                                                              \
   static FederateName main_reactor;                                                                                    \
   static FederatedEnvironment env;                                                                                     \
   Environment* _lf_environment = &env.super;                                                                           \
   static DynamicScheduler scheduler;                                                                                   \
-  static ArbitraryEvent events[(NumEvents)];                                                                           \
-  static EventQueue event_queue;                                                                                       \
-  static ArbitraryEvent system_events[(NumSystemEvents)];                                                              \
-  static EventQueue system_event_queue;                                                                                \
-  static Reaction* reactions[(NumReactions)][(NumReactions)];                                                          \
-  static int level_size[(NumReactions)];                                                                               \
-  static ReactionQueue reaction_queue;                                                                                 \
+  LF_DEFINE_EVENT_QUEUE(event_queue, NumEvents)                                                                        \
+  LF_DEFINE_EVENT_QUEUE(system_event_queue, NumSystemEvents)                                                           \
+  LF_DEFINE_REACTION_QUEUE(reaction_queue, NumReactions)                                                               \
   void lf_exit(void) { FederatedEnvironment_free(&env); }                                                              \
   void lf_start() {                                                                                                    \
-    EventQueue_ctor(&event_queue, events, (NumEvents));                                                                \
-    EventQueue_ctor(&system_event_queue, system_events, (NumSystemEvents));                                            \
-    ReactionQueue_ctor(&reaction_queue, (Reaction**)reactions, level_size, (NumReactions));                            \
-    DynamicScheduler_ctor(&scheduler, _lf_environment, &event_queue, &system_event_queue, &reaction_queue, (Timeout),  \
-                          (KeepAlive));                                                                                \
+    LF_INITIALIZE_EVENT_QUEUE(event_queue, NumEvents)                                                                  \
+    LF_INITIALIZE_EVENT_QUEUE(system_event_queue, NumSystemEvents)                                                     \
+    LF_INITIALIZE_REACTION_QUEUE(reaction_queue, NumReactions)                                                         \
+    DynamicScheduler_ctor(&scheduler, _lf_environment, &event_queue.super, &system_event_queue.super,                  \
+                          &reaction_queue.super, (Timeout), (KeepAlive));                                              \
     FederatedEnvironment_ctor(&env, (Reactor*)&main_reactor, &scheduler.super, false,                                  \
                               (FederatedConnectionBundle**)&main_reactor._bundles, (NumBundles),                       \
                               &main_reactor.startup_coordinator.super, &main_reactor.shutdown_coordinator.super,       \
@@ -2,7 +2,9 @@
 #define REACTOR_UC_PLATFORM_POSIX_H
 
 #include <pthread.h>
+#include <sched.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "reactor-uc/platform.h"
 
 typedef struct {
@@ -10,13 +12,89 @@ typedef struct {
   pthread_mutex_t lock;
 } MutexPosix;
 
+#if defined(PLATFORM_POSIX_EVENT_LOOP) && !defined(__linux__)
+#error "The POSIX event loop is built on epoll and only supported on Linux"
+#endif
+
+// Default of `PlatformPosix::spin_wait_threshold`.
+#ifndef PLATFORM_POSIX_SPIN_WAIT_THRESHOLD
+#define PLATFORM_POSIX_SPIN_WAIT_THRESHOLD 0
+#endif
+
+/**
+ * @brief How a thread is scheduled by the OS. A negative `policy` leaves the policy and priority of the thread as they
+ * are, which by default are inherited from the thread which created it. A negative `cpu` leaves the affinity as it is.
+ */
+typedef struct {
+  int policy; // SCHED_OTHER, SCHED_FIFO or SCHED_RR.
+  int priority;
+  int cpu; // The only CPU the thread may run on. Only supported on Linux.
+} ThreadProfilePosix;
+
+/**
+ * @brief The real-time execution profile of a program. The default profile changes nothing, so the program runs like
+ * any other process. Real-time policies and locking memory usually require CAP_SYS_NICE and CAP_IPC_LOCK, or
+ * suitable rlimits.
+ */
+typedef struct {
+  ThreadProfilePosix scheduler; // The thread which executes the environment.
+  ThreadProfilePosix channel;   // The worker threads of the TcpIpChannels.
+  bool lock_memory;             // Lock all current and future pages of the process into RAM.
+  size_t prefault_stack_size;   // Bytes of stack of the scheduler thread which are touched up front.
+} RtProfilePosix;
+
+#define THREAD_PROFILE_POSIX_UNCHANGED {.policy = -1, .priority = 0, .cpu = -1}
+#define RT_PROFILE_POSIX_DEFAULT                                                                                       \
+  {.scheduler = THREAD_PROFILE_POSIX_UNCHANGED,                                                                        \
+   .channel = THREAD_PROFILE_POSIX_UNCHANGED,                                                                          \
+   .lock_memory = false,                                                                                               \
+   .prefault_stack_size = 0}
+
 typedef struct {
   Platform super;
-  pthread_cond_t cond;
+  pthread_cond_t cond; // Waits on the monotonic clock, except on macOS. Not used on Linux, which blocks on a futex.
   MutexPosix mutex;
   bool new_async_event;
+  // Set while the scheduler is blocked in `wait_until_interruptible`, so `notify` only has to wake it up then. It is
+  // the futex word on Linux, unless the event loop is used.
+  int sleeping;
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  // The scheduler blocks in `epoll_wait` on the timer for the wakeup time, on the eventfd which `notify` writes to and
+  // on the sockets of all registered network channels.
+  int epoll_fd;
+  int timer_fd;
+  int event_fd;
+#endif
+  // How long before a wakeup time the platform stops sleeping and busy-waits instead. Sleeping overshoots the wakeup
+  // time by the latency of the OS, which spinning avoids at the cost of keeping a core busy. 0 disables spinning.
+  interval_t spin_wait_threshold;
+  RtProfilePosix rt_profile;
 } PlatformPosix;
 
+/**
+ * @brief Apply @p profile to the process and to the calling thread, which should be the one executing the
+ * environment. The channel profile is stored and applied by each TcpIpChannel worker thread when it starts, so this
+ * should be called before the reactors are constructed. Every part of the profile is attempted even if another part
+ * fails.
+ *
+ * @return LF_OK if the whole profile was applied, LF_ERR otherwise.
+ */
+lf_ret_t PlatformPosix_set_rt_profile(PlatformPosix* self, const RtProfilePosix* profile);
+
+/** @brief Apply @p profile to the calling thread. */
+lf_ret_t PlatformPosix_apply_thread_profile(const ThreadProfilePosix* profile);
+
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+/**
+ * @brief Let the scheduler wake up when @p fd becomes readable. A wait which is ended by it returns
+ * LF_SLEEP_INTERRUPTED, after which the scheduler polls the network channels on its own thread.
+ */
+lf_ret_t PlatformPosix_register_fd(PlatformPosix* self, int fd);
+
+/** @brief Stop waking up the scheduler for @p fd. Must be called before @p fd is closed. */
+void PlatformPosix_unregister_fd(PlatformPosix* self, int fd);
+#endif
+
 #define PLATFORM_T PlatformPosix
 #define MUTEX_T MutexPosix
 
@@ -14,6 +14,8 @@
 #define TCP_IP_CHANNEL_WORKER_THREAD_MAIN_LOOP_SLEEP MSEC(100)
 #define TCP_IP_CHANNEL_BUFFERSIZE 1024
 #define TCP_IP_CHANNEL_NUM_RETRIES 255
+// How long a send on a full, non-blocking socket waits for room before it counts as a failed attempt.
+#define TCP_IP_CHANNEL_SEND_POLL_TIMEOUT MSEC(4)
 #define TCP_IP_CHANNEL_RECV_THREAD_STACK_SIZE 2048
 #define TCP_IP_CHANNEL_RECV_THREAD_STACK_GUARD_SIZE 128
 
@@ -21,7 +23,16 @@ typedef struct TcpIpChannel TcpIpChannel;
 typedef struct FederatedConnectionBundle FederatedConnectionBundle;
 
 struct TcpIpChannel {
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  // In the event loop of the POSIX platform, the channel is polled by the scheduler thread instead of being served by a
+  // worker thread.
+  union {
+    NetworkChannel super;
+    PolledNetworkChannel polled;
+  };
+#else
   NetworkChannel super;
+#endif
 
   int fd;
   int client;
@@ -42,10 +53,12 @@ struct TcpIpChannel {
   bool is_server;
   bool has_warned_about_connection_failure;
 
+#if !defined(PLATFORM_POSIX_EVENT_LOOP)
   // required for callbacks
   pthread_t worker_thread;
   pthread_attr_t worker_thread_attr;
   char worker_thread_stack[TCP_IP_CHANNEL_RECV_THREAD_STACK_SIZE];
+#endif
 
   FederatedConnectionBundle* federated_connection;
   void (*receive_callback)(FederatedConnectionBundle* conn, const FederateMessage* message);
@@ -6,9 +6,26 @@
 #include "reactor-uc/reactor.h"
 #include "reactor-uc/trigger.h"
 
+// Number of records in the flattened fan-out tables of all ports together, see Reactor::calculate_fanouts. A port
+// whose table does not fit walks the connection graph on every write instead. Set with the PORT_FANOUT_TABLE_SIZE CMake
+// option.
+#ifndef PORT_FANOUT_TABLE_SIZE
+#define PORT_FANOUT_TABLE_SIZE 0
+#endif
+
 typedef struct Connection Connection;
 typedef struct Port Port;
 
+/**
+ * @brief A record in the flattened fan-out table of a port. Either `port` is a port downstream of it through same-tag
+ * logical connections, which stores the value and triggers its effects, or `conn` is a connection of another kind, e.g.
+ * delayed or federated, whose `trigger_downstreams` is called.
+ */
+typedef struct {
+  Port* port;
+  Connection* conn;
+} FanoutRecord;
+
 struct Port {
   Trigger super;
   void* value_ptr;    // Pointer to the `buffer` field in the user Input port struct.
@@ -22,6 +39,11 @@ struct Port {
   Connection** conns_out;      // Connections going out of the port.
   size_t conns_out_size;       // Number of connections going out of the port.
   size_t conns_out_registered; // Number of connections that have been registered for cleanup.
+  bool holds_tokens;           // Whether the value is a `Token*` to which the port holds a reference.
+  bool is_alias;               // Whether `value_ptr` points into the buffer of the final upstream output.
+  bool has_aliases;            // Whether downstream inputs alias the buffer of this port.
+  FanoutRecord* fanout;        // Flattened downstreams of the port, or NULL if the connection graph is walked instead.
+  size_t fanout_size;          // Number of records in `fanout`.
 
   void (*set)(Port* self, const void* value);
 };
@@ -45,6 +67,32 @@ typedef struct {
   size_t parent_sources_size;
 } InputExternalCtorArgs;
 
+/**
+ * @brief Write a value into the buffer of a port. A port which holds tokens takes a reference to the token instead of
+ * copying its buffer, and drops the reference to the token it held before.
+ */
+void Port_store_value(Port* self, const void* value);
+
+/**
+ * @brief Let a port whose value type is `Token*` hold references to its tokens. Called by the generated constructor.
+ */
+void Port_enable_tokens(Port* self);
+
+/**
+ * @brief Point an input port at the buffer of its final upstream output, if every connection on the way to the output
+ * is an aliasing LogicalConnection. Called for every port when the program is assembled.
+ */
+void Port_resolve_alias(Port* self);
+
+/**
+ * @brief Flatten all downstreams of a port which is written by reactions into a fan-out table taken from `records`.
+ * @param records The unused records of the table of the environment.
+ * @param records_size The number of unused records.
+ * @return The number of records taken, 0 if the port has no table because it is not written by reactions or its table
+ * does not fit.
+ */
+size_t Port_calculate_fanout(Port* self, FanoutRecord* records, size_t records_size);
+
 void Port_ctor(Port* self, TriggerType type, Reactor* parent, void* value_ptr, size_t value_size, Reaction** effects,
                size_t effects_size, Reaction** sources, size_t sources_size, Reaction** observers,
                size_t observers_size, Connection** conns_out, size_t conns_out_size);
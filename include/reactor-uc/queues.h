@@ -8,11 +8,45 @@
 #include "reactor-uc/trigger.h"
 #include "reactor-uc/platform.h"
 
+// The EventQueue implementation instantiated by the LF_DEFINE_EVENT_QUEUE macros. Selected with the EVENT_QUEUE
+// CMake option.
+#if !defined(EVENT_QUEUE_BINARY) && !defined(EVENT_QUEUE_DARY) && !defined(EVENT_QUEUE_RADIX)
+#define EVENT_QUEUE_BINARY
+#endif
+
+// Number of children per node in the DaryEventQueue. With 4, the keys of all children of a node fill a single
+// 64-byte cache line.
+#ifndef EVENT_QUEUE_DARY_ARITY
+#define EVENT_QUEUE_DARY_ARITY 4
+#endif
+
+// Capacity of the IngressQueue of the scheduler, must be a power of two. 0 disables the ingress queue and events
+// scheduled from asynchronous context go directly into the event queue. Set with the EVENT_INGRESS_SIZE CMake option.
+#ifndef EVENT_INGRESS_SIZE
+#define EVENT_INGRESS_SIZE 0
+#endif
+
+#if EVENT_INGRESS_SIZE > 0
+#include <stdatomic.h>
+#endif
+
+// One bucket for keys equal to the last extracted key, plus one per bit of the 96-bit (time, microstep) key.
+#define RADIX_EVENT_QUEUE_NUM_BUCKETS 97
+
 typedef struct EventQueue EventQueue;
+typedef struct DaryEventQueue DaryEventQueue;
+typedef struct RadixEventQueue RadixEventQueue;
 typedef struct ReactionQueue ReactionQueue;
+typedef struct TimerQueue TimerQueue;
+typedef struct IngressQueue IngressQueue;
+typedef struct Timer Timer;
 
 /**
  * @brief Min-heap priority event queue ordered by tag.
+ *
+ * The queue can optionally keep an index from (trigger or handler, tag) to heap positions, which makes
+ * `find_equal_same_tag` and `remove` O(1) lookups instead of a linear scan over the heap. See
+ * EventQueue_ctor_indexed.
  */
 struct EventQueue {
   /** @brief Return the tag of the earliest event in the queue, or FOREVER_TAG
@@ -28,6 +62,12 @@ struct EventQueue {
    * LF_EVENT_QUEUE_EMPTY if the queue is empty.
    */
   lf_ret_t (*pop)(EventQueue* self, AbstractEvent* event);
+  /**
+   * @brief Remove up to @p max events with tag @p tag from the head of the queue in a single critical section and
+   * copy them into @p events. Returns the number of events removed, which is less than @p max only if no event at
+   * @p tag is left in the queue.
+   */
+  size_t (*pop_all_at_tag)(EventQueue* self, tag_t tag, ArbitraryEvent* events, size_t max);
   /** @brief Return true if the queue contains no events. */
   bool (*empty)(EventQueue* self);
   /** @brief Restore the heap invariant for the entire queue. Should be called after bulk
@@ -46,6 +86,9 @@ struct EventQueue {
   size_t capacity;       /**< @brief Maximum number of events the queue can hold. */
   ArbitraryEvent* array; /**< @brief Backing array of the event queue. */
   MUTEX_T mutex;         /**< @brief Mutex protecting concurrent access. */
+  size_t* index;         /**< @brief Open-addressing table of heap positions + 1 (0 is empty), or NULL. */
+  size_t* index_pos;     /**< @brief Slot in `index` occupied by the event at each heap position. */
+  size_t index_capacity; /**< @brief Number of slots in `index`. */
 };
 
 /**
@@ -56,20 +99,189 @@ struct EventQueue {
  */
 void EventQueue_ctor(EventQueue* self, ArbitraryEvent* array, size_t capacity);
 
+/**
+ * @brief Initialize an EventQueue that indexes its events by trigger (or handler) and tag.
+ *
+ * The index is kept in sync with every heap swap, so cancelling or replacing a pending event costs an O(1) lookup plus
+ * an O(log n) re-heapify. Events must not be re-tagged in place while they are in the queue.
+ *
+ * @param self           The EventQueue to initialize.
+ * @param array          Backing array of at least @p capacity ArbitraryEvent elements.
+ * @param capacity       Maximum number of events the queue can hold.
+ * @param index          Hash table of @p index_capacity slots. About twice @p capacity keeps probe sequences short.
+ * @param index_pos      Array of at least @p capacity elements.
+ * @param index_capacity Number of slots in @p index. Must exceed @p capacity, or be 0 to disable the index.
+ */
+void EventQueue_ctor_indexed(EventQueue* self, ArbitraryEvent* array, size_t capacity, size_t* index,
+                             size_t* index_pos, size_t index_capacity);
+
+/**
+ * @brief d-ary min-heap event queue that keeps tags in a separate, dense key array.
+ *
+ * Event bodies stay where they were inserted in `super.array` (which is kept compact), and the heap only orders
+ * indices into it together with a copy of their tags. Sifting therefore moves and compares 16-byte keys instead of
+ * whole ArbitraryEvents, and all children of a node are adjacent in `keys`. The arity is set at compile time with
+ * EVENT_QUEUE_DARY_ARITY.
+ *
+ * `heapify(idx)` refers to heap positions, and `build_heap` treats the first `size` elements of `super.array` as
+ * unordered event bodies. The optional index from EventQueue_ctor_indexed maps to body positions here.
+ */
+struct DaryEventQueue {
+  EventQueue super;
+  tag_t* keys;      /**< @brief Tag of the event at each heap position. */
+  size_t* heap;     /**< @brief Position in `super.array` of the event at each heap position. */
+  size_t* heap_pos; /**< @brief Heap position of the event at each position in `super.array`. */
+};
+
+/**
+ * @brief Initialize a DaryEventQueue.
+ * @param self           The DaryEventQueue to initialize.
+ * @param array          Backing array of at least @p capacity ArbitraryEvent elements.
+ * @param capacity       Maximum number of events the queue can hold.
+ * @param keys           Array of at least @p capacity tags.
+ * @param heap           Array of at least @p capacity elements.
+ * @param heap_pos       Array of at least @p capacity elements.
+ * @param index          Optional (trigger, tag) index, see EventQueue_ctor_indexed. May be NULL.
+ * @param index_pos      Array of at least @p capacity elements, or NULL if there is no index.
+ * @param index_capacity Number of slots in @p index, or 0 to disable the index.
+ */
+void DaryEventQueue_ctor(DaryEventQueue* self, ArbitraryEvent* array, size_t capacity, tag_t* keys, size_t* heap,
+                         size_t* heap_pos, size_t* index, size_t* index_pos, size_t index_capacity);
+
+/**
+ * @brief Monotone radix-heap event queue.
+ *
+ * The scheduler never processes a tag earlier than the current one, so the queue only has to support extracting keys
+ * that are not smaller than the last extracted key. Events are kept in buckets by the highest bit in which their tag
+ * differs from `last`, the smallest tag that was moved to the head. Insert and remove are O(1). Moving a new tag to
+ * the head redistributes one bucket, and since an event can only move to a lower bucket, this is amortized
+ * O(log(key range)) per event. Many events at the same tag, as produced by timers sharing a period, are popped in O(1)
+ * each.
+ *
+ * Inserting an event earlier than `last` is allowed but redistributes the whole queue. `heapify(idx)` re-buckets the
+ * event at position `idx` of `super.array` after its tag was changed, and `build_heap` buckets the first `size`
+ * elements of `super.array`. Event bodies are kept compact in `super.array`, so the optional index from
+ * EventQueue_ctor_indexed maps to body positions, as in the DaryEventQueue.
+ */
+struct RadixEventQueue {
+  EventQueue super;
+  tag_t last;      /**< @brief Lower bound on all tags in the queue. */
+  size_t* next;    /**< @brief Next body in the same bucket, per body. */
+  size_t* prev;    /**< @brief Previous body in the same bucket, per body. */
+  uint8_t* bucket; /**< @brief Bucket of each body. */
+  /** @brief First body in each bucket. */
+  size_t head[RADIX_EVENT_QUEUE_NUM_BUCKETS];
+  /** @brief Bitmap of non-empty buckets. */
+  uint32_t nonempty[(RADIX_EVENT_QUEUE_NUM_BUCKETS + 31) / 32];
+};
+
+/**
+ * @brief Initialize a RadixEventQueue.
+ * @param self           The RadixEventQueue to initialize.
+ * @param array          Backing array of at least @p capacity ArbitraryEvent elements.
+ * @param capacity       Maximum number of events the queue can hold.
+ * @param next           Array of at least @p capacity elements.
+ * @param prev           Array of at least @p capacity elements.
+ * @param bucket         Array of at least @p capacity elements.
+ * @param index          Optional (trigger, tag) index, see EventQueue_ctor_indexed. May be NULL.
+ * @param index_pos      Array of at least @p capacity elements, or NULL if there is no index.
+ * @param index_capacity Number of slots in @p index, or 0 to disable the index.
+ */
+void RadixEventQueue_ctor(RadixEventQueue* self, ArbitraryEvent* array, size_t capacity, size_t* next, size_t* prev,
+                          uint8_t* bucket, size_t* index, size_t* index_pos, size_t index_capacity);
+
+/**
+ * @brief Queue of pending Timers, grouped by (period, next tag).
+ *
+ * Timers with the same period that are due at the same tag form a group, and the groups are kept in a list
+ * sorted by tag. All timers due at a tag are thus fired with a single pop and periodic timers are re-armed
+ * by moving their whole group, instead of inserting one event per timer and period into the EventQueue.
+ * The bookkeeping is intrusive in Timer, so the queue needs no storage of its own.
+ */
+struct TimerQueue {
+  /** @brief Return the tag of the earliest pending timer, or FOREVER_TAG if empty. */
+  tag_t (*next_tag)(TimerQueue* self);
+  /** @brief Return true if no timer is pending. */
+  bool (*empty)(TimerQueue* self);
+  /** @brief Arm @p timer to fire at @p tag. The timer must not already be pending. */
+  void (*insert)(TimerQueue* self, Timer* timer, tag_t tag);
+  /**
+   * @brief Remove all timers due at @p tag and re-arm the periodic ones at their next tag. Returns the heads
+   * of the fired groups chained through `Timer::fired_next`, the members of a group are chained through
+   * `Timer::group_next`. Returns NULL if no timer is due at @p tag.
+   */
+  Timer* (*pop)(TimerQueue* self, tag_t tag);
+
+  Timer* head;   /**< @brief Head of the earliest group, groups are chained through `Timer::next_group`. */
+  MUTEX_T mutex; /**< @brief Mutex protecting concurrent access. */
+};
+
+void TimerQueue_ctor(TimerQueue* self);
+
+#if EVENT_INGRESS_SIZE > 0
+/** @brief A slot of the IngressQueue. `seq` tells producers and the consumer whose turn it is to use the slot. */
+typedef struct {
+  atomic_size_t seq;
+  Event event;
+} IngressSlot;
+
+/**
+ * @brief Bounded lock-free ring of events with multiple producers and a single consumer.
+ *
+ * Asynchronous contexts push events here instead of locking the scheduler and the event queue, and the scheduler
+ * drains them into its event queue. Each slot carries a sequence number, so a producer only contends with other
+ * producers on the CAS of `head`, and the consumer never contends at all.
+ */
+struct IngressQueue {
+  /** @brief Copy @p event into the queue. Safe to call concurrently. Returns LF_EVENT_QUEUE_FULL if full. */
+  lf_ret_t (*push)(IngressQueue* self, const Event* event);
+  /** @brief Move the oldest event into @p event. Must only be called by the consumer. Returns false if empty. */
+  bool (*pop)(IngressQueue* self, Event* event);
+
+  IngressSlot* slots; /**< @brief Backing array of `capacity` slots. */
+  size_t capacity;    /**< @brief Number of slots, a power of two. */
+  atomic_size_t head; /**< @brief Position of the next push. */
+  size_t tail;        /**< @brief Position of the next pop. Only accessed by the consumer. */
+};
+
+void IngressQueue_ctor(IngressQueue* self, IngressSlot* slots, size_t capacity);
+#endif
+
+/**
+ * @brief Queue of the reactions triggered at the current tag, popped in order of increasing level.
+ *
+ * The queue keeps one FIFO bucket per level, chained through Reaction::next_ready. Since a reaction can be queued at
+ * most once per tag, the memory needed is one head and one tail pointer per level plus the link in each reaction.
+ * Non-empty levels are marked in a bitmap, so pop skips empty levels a word at a time. Duplicates are detected by
+ * stamping each queued reaction with the epoch of the queue, which is advanced on every reset.
+ */
 struct ReactionQueue {
   lf_ret_t (*insert)(ReactionQueue* self, Reaction* reaction);
   Reaction* (*pop)(ReactionQueue* self);
+  /** @brief Return the level of the reaction which `pop` would return next, or -1 if the queue is empty. */
+  int (*next_level)(ReactionQueue* self);
+  /**
+   * @brief Remove and return the lowest-level reaction which does not share a chain with any reaction queued at a
+   * lower level, nor with any of the @p executing_size reactions in @p executing at a lower level. NULL entries in
+   * @p executing are skipped. Returns NULL if no queued reaction is released.
+   */
+  Reaction* (*pop_released)(ReactionQueue* self, Reaction** executing, size_t executing_size);
   bool (*empty)(ReactionQueue* self);
   void (*reset)(ReactionQueue* self);
 
-  int* level_size;
+  Reaction** level_head; /**< @brief First queued reaction of each level. Only valid if the level is ready. */
+  Reaction** level_tail; /**< @brief Last queued reaction of each level. Only valid if the level is ready. */
+  uint32_t* ready;       /**< @brief Bitmap of the levels with queued reactions, REACTION_QUEUE_READY_WORDS long. */
+  size_t epoch;          /**< @brief Stamp of the current tag, compared against Reaction::enqueued_epoch. */
   int curr_level;
   int max_active_level;
-  int curr_index;
-  Reaction** array;
-  size_t capacity;
+  size_t capacity; /**< @brief Number of levels, bounded by the number of reactions in the program. */
 };
 
-void ReactionQueue_ctor(ReactionQueue* self, Reaction** array, int* level_size, size_t capacity);
+/** @brief Number of words in the ready bitmap of a ReactionQueue with @p capacity levels. */
+#define REACTION_QUEUE_READY_WORDS(capacity) (((capacity) + 31) / 32)
+
+void ReactionQueue_ctor(ReactionQueue* self, Reaction** level_head, Reaction** level_tail, uint32_t* ready,
+                        size_t capacity);
 
 #endif
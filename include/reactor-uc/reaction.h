@@ -7,6 +7,10 @@
 typedef struct Reaction Reaction;
 typedef struct Reactor Reactor;
 typedef struct Trigger Trigger;
+typedef struct Port Port;
+
+// Bit of `Reaction::stp_inputs` which is shared by all inputs at index 63 or above in the triggers of the parent.
+#define REACTION_STP_INPUTS_OVERFLOW_BIT 63
 
 struct Reaction {
   Reactor* parent;
@@ -14,15 +18,39 @@ struct Reaction {
   void (*deadline_violation_handler)(Reaction* self);
   void (*stp_violation_handler)(Reaction* self);
   interval_t deadline;
+  // Time left until the deadline when the reaction was last released, i.e. its deadline minus the lag at that point.
+  // FOREVER for reactions without a deadline.
+  interval_t deadline_slack;
   int level; // Negative level means it is invalid.
   size_t index;
   Trigger** effects;
   size_t effects_size;
   size_t effects_registered;
+  Reaction* next_ready;  // Next reaction at the same level in the ReactionQueue.
+  size_t enqueued_epoch; // Epoch of the ReactionQueue when this reaction was last queued.
+  // Bitmask of the chains through the reaction graph which pass through this reaction. A reaction shares at least one
+  // bit with every reaction downstream of it, so reactions with disjoint chain IDs are independent.
+  uint64_t chain_id;
+  // Bitmask over `parent->triggers` of the inputs which trigger or are observed by this reaction. These are the inputs
+  // which are checked for safe-to-process violations before the reaction executes. Only set if the reaction has an
+  // `stp_violation_handler`.
+  uint64_t stp_inputs;
   size_t (*calculate_level)(Reaction* self);
   size_t (*get_level)(Reaction* self);
 };
 
+/**
+ * @brief Merge the chain ID of `self` into the chain IDs of its direct upstream reactions. Returns true if any of them
+ * changed.
+ */
+bool Reaction_propagate_chain_id(Reaction* self);
+
+/** @brief Returns true if `port` triggers `self` or is observed by it. */
+bool Reaction_depends_on(Reaction* self, Port* port);
+
+/** @brief Compute `stp_inputs` of `self` from the inputs of its parent reactor. */
+void Reaction_calculate_stp_inputs(Reaction* self);
+
 void Reaction_ctor(Reaction* self, Reactor* parent, void (*body)(Reaction* self), Trigger** effects,
                    size_t effects_size, size_t index, void (*deadline_violation_handler)(Reaction*),
                    interval_t deadline, void (*stp_violation_handler)(Reaction*));
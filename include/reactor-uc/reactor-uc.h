@@ -18,6 +18,7 @@
 #include "reactor-uc/reactor.h"
 #include "reactor-uc/tag.h"
 #include "reactor-uc/timer.h"
+#include "reactor-uc/token.h"
 #include "reactor-uc/trigger.h"
 #include "reactor-uc/queues.h"
 #include "reactor-uc/macros_internal.h"
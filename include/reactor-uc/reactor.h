@@ -16,6 +16,28 @@ struct Reactor {
   void (*register_startup)(Reactor* self, BuiltinTrigger* startup);
   void (*register_shutdown)(Reactor* self, BuiltinTrigger* shutdown);
   lf_ret_t (*calculate_levels)(Reactor* self);
+  /**
+   * @brief Assign a chain ID to every reaction in this reactor and its children. Each reaction gets its own bit, which
+   * is then merged into all reactions upstream of it. Must be called on the main reactor after the levels are known.
+   */
+  lf_ret_t (*calculate_chain_ids)(Reactor* self);
+  /**
+   * @brief Compute, for every reaction with a safe-to-process violation handler in this reactor and its children, the
+   * inputs which must be checked before the reaction executes.
+   */
+  lf_ret_t (*calculate_stp_inputs)(Reactor* self);
+  /**
+   * @brief Point the input ports of this reactor and its children which are only reached through aliasing logical
+   * connections at the buffer of their final upstream output. Must be called on the main reactor once all connections
+   * are made.
+   */
+  lf_ret_t (*resolve_aliases)(Reactor* self);
+  /**
+   * @brief Flatten the downstreams of every port of this reactor and its children which is written by reactions into a
+   * fan-out table, so that writing the port does not walk the connection graph. The tables are taken from the storage
+   * of the environment. Must be called on the main reactor once all connections are made.
+   */
+  lf_ret_t (*calculate_fanouts)(Reactor* self);
   Reactor* parent;
   Reactor** children;
   size_t children_size;
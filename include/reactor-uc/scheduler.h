@@ -21,6 +21,14 @@ struct Scheduler {
    */
   lf_ret_t (*schedule_at)(Scheduler* self, Event* event);
 
+  /**
+   * @brief Schedules an event from asynchronous or channel context. Unlike `schedule_at`, the event may be handed
+   * over to the scheduler thread without taking any lock. The tag is then checked when the scheduler takes the event
+   * over: an event that is behind the current tag by then is handled at the next microstep, and an event after the
+   * stop tag is dropped.
+   */
+  lf_ret_t (*schedule_at_async)(Scheduler* self, Event* event);
+
   lf_ret_t (*schedule_system_event_at)(Scheduler* self, SystemEvent* event);
 
   /**
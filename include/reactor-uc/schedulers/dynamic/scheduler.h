@@ -8,9 +8,81 @@
 #include "reactor-uc/scheduler.h"
 #include "reactor-uc/platform.h"
 
+// Number of events the scheduler pops from the event queue per critical section. The events are buffered on the
+// stack of the scheduler.
+#ifndef SCHEDULER_EVENT_BATCH_SIZE
+#define SCHEDULER_EVENT_BATCH_SIZE 8
+#endif
+
+// Upper bound on the number of threads, including the scheduler thread, which execute the reactions of a level in
+// parallel. With 1, reactions are always executed by the scheduler thread and no worker pool is compiled in.
+#ifndef SCHEDULER_MAX_WORKERS
+#define SCHEDULER_MAX_WORKERS 1
+#endif
+
+// Number of workers the scheduler starts out with. Can be changed at runtime with DynamicScheduler_set_num_workers.
+#ifndef SCHEDULER_WORKERS
+#define SCHEDULER_WORKERS 1
+#endif
+
 typedef struct DynamicScheduler DynamicScheduler;
 typedef struct Environment Environment;
 
+/** @brief How often physical time is sampled to check the deadlines of the reactions. */
+typedef enum {
+  DEADLINE_CHECK_REACTION, // Before every reaction with a deadline.
+  // Once per level. A reaction sees the lag at the time the first reaction with a deadline of its level was released,
+  // so a violation can be detected late by up to the time it took to execute the reactions before it.
+  DEADLINE_CHECK_LEVEL,
+} DeadlineCheckGranularity;
+
+// Granularity the scheduler starts out with. Can be changed at runtime with DynamicScheduler_set_deadline_check.
+#ifndef SCHEDULER_DEADLINE_CHECK
+#define SCHEDULER_DEADLINE_CHECK DEADLINE_CHECK_REACTION
+#endif
+
+/** @brief When the worker pool may start executing a queued reaction. */
+typedef enum {
+  WORKER_POOL_LEVEL_BARRIER, // Once every reaction at a lower level has completed.
+  WORKER_POOL_CHAIN_RELEASE, // Once no reaction at a lower level which shares a chain with it is queued or executing.
+} WorkerPoolPolicy;
+
+#if SCHEDULER_MAX_WORKERS > 1
+#if !defined(PLATFORM_POSIX)
+#error "The worker pool of the DynamicScheduler is only supported on POSIX"
+#endif
+typedef struct {
+  DynamicScheduler* scheduler;
+  pthread_t thread;
+  size_t id;         // Index of the worker. The scheduler thread is worker 0.
+  size_t generation; // The last tag generation seen by this worker.
+} WorkerThread;
+
+/**
+ * @brief Threads which help the scheduler thread execute the reactions of a tag. With WORKER_POOL_LEVEL_BARRIER, the
+ * reactions of a level are executed in parallel and a level is only opened once every reaction of the previous level
+ * has completed. With WORKER_POOL_CHAIN_RELEASE, a reaction is released as soon as no reaction upstream of it, as
+ * approximated by the chain IDs, is queued or executing.
+ */
+typedef struct {
+  WorkerThread threads[SCHEDULER_MAX_WORKERS - 1];
+  size_t threads_started;
+  pthread_mutex_t lock; // Protects the fields below, the reaction queue and the cleanup list while `parallel` is set.
+  pthread_cond_t cond;  // Signalled when a tag starts, a level is opened or completed and when the workers terminate.
+  size_t num_workers;   // Number of workers, including the scheduler thread, used from the next tag on.
+  size_t tag_workers;   // Number of workers executing the current tag.
+  WorkerPoolPolicy policy;     // Policy used from the next tag on.
+  WorkerPoolPolicy tag_policy; // Policy of the current tag.
+  Reaction* executing[SCHEDULER_MAX_WORKERS]; // The reaction each worker is executing, or NULL.
+  size_t tag_generation;
+  size_t helpers_pending; // Number of helper threads which have not yet left the current tag.
+  size_t in_flight;       // Number of reactions being executed at `level`.
+  int level;              // The level whose reactions can currently be executed, with WORKER_POOL_LEVEL_BARRIER.
+  bool parallel;          // Whether the current tag is executed by the worker pool.
+  bool terminate;
+} WorkerPool;
+#endif
+
 struct DynamicScheduler {
   Scheduler super;
   MUTEX_T mutex;
@@ -18,6 +90,12 @@ struct DynamicScheduler {
   EventQueue* event_queue;
   ReactionQueue* reaction_queue;
   EventQueue* system_event_queue;
+  TimerQueue timer_queue; // Pending timers. These bypass the event queue.
+#if EVENT_INGRESS_SIZE > 0
+  // Events scheduled from asynchronous context which are yet to be moved into the event queue.
+  IngressQueue ingress;
+  IngressSlot ingress_slots[EVENT_INGRESS_SIZE];
+#endif
 
   // The following two fields are used to implement a linked list of Triggers
   // that are registered for cleanup at the end of the current tag.
@@ -26,6 +104,13 @@ struct DynamicScheduler {
   tag_t stop_tag; // The tag at which the program should stop. This is set by the user or by the scheduler.
   bool shutdown_requested;
   tag_t current_tag; // The current logical tag. Set by the scheduler and read by user in the reaction bodies.
+  DeadlineCheckGranularity deadline_check;     // Granularity used from the next tag on.
+  DeadlineCheckGranularity tag_deadline_check; // Granularity of the current tag.
+  interval_t lag_sample;                       // The lag sampled for `lag_sample_level`, with DEADLINE_CHECK_LEVEL.
+  int lag_sample_level;                        // Level the lag was last sampled for, or -1.
+#if SCHEDULER_MAX_WORKERS > 1
+  WorkerPool workers;
+#endif
 
   /**
    * @brief After completing all reactions at a tag, this function is called to
@@ -44,4 +129,23 @@ void DynamicScheduler_ctor(DynamicScheduler* self, Environment* env, EventQueue*
                            EventQueue* system_event_queue, ReactionQueue* reaction_queue, interval_t duration,
                            bool keep_alive);
 
+/**
+ * @brief Set the number of threads, including the scheduler thread, which execute the reactions of each level in
+ * parallel. Takes effect at the next tag. Must be called from a reaction or before the program starts. Returns
+ * LF_INVALID_VALUE if @p num_workers is 0 or exceeds SCHEDULER_MAX_WORKERS.
+ */
+lf_ret_t DynamicScheduler_set_num_workers(DynamicScheduler* self, size_t num_workers);
+
+/**
+ * @brief Set when the worker pool may start executing a queued reaction. Takes effect at the next tag. Must be called
+ * from a reaction or before the program starts. Has no effect while a single worker is used.
+ */
+lf_ret_t DynamicScheduler_set_worker_policy(DynamicScheduler* self, WorkerPoolPolicy policy);
+
+/**
+ * @brief Set how often physical time is sampled to check deadlines. Takes effect at the next tag. Must be called from
+ * a reaction or before the program starts.
+ */
+lf_ret_t DynamicScheduler_set_deadline_check(DynamicScheduler* self, DeadlineCheckGranularity granularity);
+
 #endif // SCHEDULER_H
@@ -11,40 +11,40 @@
  * and return values.
  */
 
-#ifndef LF_PRINT_DEBUG
-#define LF_PRINT_DEBUG(A, ...) {};
-#endif
-
 /**
  * @brief Wrapper function for peeking a priority queue.
  */
 void push_pop_peek_pqueue(void* self);
 
-void execute_inst_ADD(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_ADDI(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+void execute_inst_ADD(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_ADDI(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                       bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_ADV(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_ADVI(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
                        bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_BEQ(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_BGE(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_BLT(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_BNE(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_DU(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                     size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_EXE(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_WLT(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_WU(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                     size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_JAL(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_JALR(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+void execute_inst_BEQ(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_BGE(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_BLT(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_BNE(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_DU(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                     bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_EXE(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_WLT(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_WU(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                     bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_JAL(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_JALR(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
                        bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
-void execute_inst_STP(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
+void execute_inst_STP(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop);
 
 #endif
@@ -7,17 +7,87 @@
 #include "reactor-uc/error.h"
 #include "reactor-uc/queues.h"
 #include "reactor-uc/scheduler.h"
+#include "reactor-uc/platform.h"
+#include "reactor-uc/schedulers/static/scheduler_instructions.h"
+
+// Upper bound on the number of workers which execute a static schedule. Worker 0 runs on the thread which starts the
+// program, every other worker gets its own thread.
+#ifndef SCHEDULER_MAX_WORKERS
+#define SCHEDULER_MAX_WORKERS 1
+#endif
+
+// Whether the workers dispatch on the opcode of each instruction with computed gotos, which is a GNU extension. With 0,
+// the function of each instruction is called instead.
+#ifndef SCHEDULER_STATIC_THREADED_DISPATCH
+#if defined(__GNUC__)
+#define SCHEDULER_STATIC_THREADED_DISPATCH 1
+#else
+#define SCHEDULER_STATIC_THREADED_DISPATCH 0
+#endif
+#endif
+
+#if SCHEDULER_MAX_WORKERS > 1
+#if !defined(PLATFORM_POSIX)
+#error "The workers of the StaticScheduler are only supported on POSIX"
+#endif
+#include <pthread.h>
+#endif
 
 typedef struct StaticScheduler StaticScheduler;
 typedef struct Environment Environment;
 
+/**
+ * @brief A scheduler which executes a schedule computed at compile time instead of popping events and reactions off
+ * queues. Every worker interprets its own list of instructions. Timers and startup reactions are encoded in the
+ * schedule, so `schedule_at` only accepts events and ignores them. The workers synchronize with each other through
+ * registers and the WU instruction, and one worker advances logical time with ADV or ADVI once every worker is done
+ * with the current tag.
+ */
 struct StaticScheduler {
-  Scheduler* super;
+  Scheduler super;
   Environment* env;
-  const inst_t** static_schedule;
-  size_t* pc;
+  const inst_t** static_schedule; // One list of instructions per worker.
+  size_t num_workers;
+  size_t pc[SCHEDULER_MAX_WORKERS]; // The program counter of each worker.
+#if SCHEDULER_MAX_WORKERS > 1
+  pthread_t threads[SCHEDULER_MAX_WORKERS - 1];
+  pthread_mutex_t cleanup_lock; // Protects the cleanup list, which reactions on different workers append to.
+#endif
+
+  // The following two fields are used to implement a linked list of Triggers
+  // that are registered for cleanup when logical time is advanced.
+  Trigger* cleanup_ll_head;
+  Trigger* cleanup_ll_tail;
+
+  // Registers the instructions of the schedule can refer to.
+  reg_t start_time_reg; // The start time of the program.
+  reg_t stop_time_reg;  // The time of the last tag to execute. Lowered by `request_shutdown`.
+  reg_t time_reg;       // The time of the current tag. Advanced with ADV and ADVI.
+
+  // Stamp of the current tag, compared against Reaction::enqueued_epoch by conditional EXE instructions.
+  size_t epoch;
+
+  /**
+   * @brief Called by ADV and ADVI before logical time is advanced to reset is_present fields and increment index
+   * pointers of the EventPayloadPool.
+   */
+  void (*clean_up_timestep)(Scheduler* self);
 };
 
-void StaticScheduler_ctor(StaticScheduler* self, Environment* env, const inst_t** static_schedule);
+void StaticScheduler_ctor(StaticScheduler* self, Environment* env, const inst_t** static_schedule, size_t num_workers,
+                          interval_t duration);
+
+/**
+ * @brief Interpret the instructions of @p worker_number until they hand over a reaction to execute, which is returned,
+ * or until the STP instruction is reached, in which case NULL is returned.
+ */
+Reaction* lf_sched_get_ready_reaction(StaticScheduler* scheduler, size_t worker_number);
+
+/**
+ * @brief Order every run of consecutive EXE instructions in @p instructions by the level of their reactions, so that
+ * reactions execute after the reactions upstream of them in the same tag. Must be called after the environment has
+ * been assembled, which computes the levels, and before the schedule is started.
+ */
+void StaticScheduler_sort_by_level(inst_t* instructions, size_t size);
 
 #endif // STATIC_SCHEDULER_H
@@ -8,6 +8,8 @@
 #include "reactor-uc/reaction.h"
 #include "reactor-uc/platform.h"
 
+typedef struct StaticScheduler StaticScheduler;
+
 typedef enum {
   ADD,
   ADDI,
@@ -50,8 +52,8 @@ typedef union {
 /**
  * @brief Virtual instruction function pointer
  */
-typedef void (*function_virtual_instruction_t)(Platform* platform, size_t worker_number, operand_t op1, operand_t op2,
-                                               operand_t op3, bool debug, size_t* program_counter,
+typedef void (*function_virtual_instruction_t)(StaticScheduler* scheduler, size_t worker_number, operand_t op1,
+                                               operand_t op2, operand_t op3, bool debug, size_t* program_counter,
                                                Reaction** returned_reaction, bool* exit_loop);
 
 /**
@@ -59,14 +61,17 @@ typedef void (*function_virtual_instruction_t)(Platform* platform, size_t worker
  * There is an opcode and three operands. The operands are unions so they
  * can be either a pointer or an immediate
  *
+ * The opcode and the operands come first, so the interpreter which dispatches
+ * on the opcode reads a single 32-byte block per instruction. `func` is only
+ * read by the interpreter which calls it.
  */
 typedef struct inst_t {
-  function_virtual_instruction_t func;
   opcode_t opcode;
+  bool debug;
   operand_t op1;
   operand_t op2;
   operand_t op3;
-  bool debug;
+  function_virtual_instruction_t func;
 } inst_t;
 
 #endif
\ No newline at end of file
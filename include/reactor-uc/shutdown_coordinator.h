@@ -29,6 +29,6 @@ struct ShutdownCoordinator {
 };
 
 void ShutdownCoordinator_ctor(ShutdownCoordinator* self, Environment* env, size_t longest_path, size_t payload_size,
-                              void* payload_buf, bool* payload_used_buf, size_t payload_buf_capacity);
+                              void* payload_buf, size_t* payload_free_list_buf, size_t payload_buf_capacity);
 
 #endif // REACTOR_UC_SHUTDOWN_COORDINATOR_H
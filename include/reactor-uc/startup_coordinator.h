@@ -57,7 +57,7 @@ struct StartupCoordinator {
 
 void StartupCoordinator_ctor(StartupCoordinator* self, Environment* env, NeighborState* neighbor_state,
                              size_t num_neighbors, size_t longest_path, JoiningPolicy joining_policy,
-                             size_t payload_size, void* payload_buf, bool* payload_used_buf,
+                             size_t payload_size, void* payload_buf, size_t* payload_free_list_buf,
                              size_t payload_buf_capacity);
 
 #endif // REACTOR_UC_STARTUP_COORDINATOR_H
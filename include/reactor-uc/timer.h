@@ -13,6 +13,11 @@ struct Timer {
   interval_t period;
   TriggerEffects effects;
   TriggerObservers observers;
+  // Bookkeeping of the TimerQueue of the scheduler.
+  tag_t next_tag;    // The tag at which the timer fires next.
+  Timer* group_next; // The next timer in the same group.
+  Timer* next_group; // The head of the next group. Only valid on group heads.
+  Timer* fired_next; // The head of the next fired group. Only valid on group heads returned by pop.
 } __attribute__((aligned(MEM_ALIGNMENT)));
 
 void Timer_ctor(Timer* self, Reactor* parent, instant_t offset, interval_t period, Reaction** effects,
@@ -0,0 +1,68 @@
+#ifndef REACTOR_UC_TOKEN_H
+#define REACTOR_UC_TOKEN_H
+
+#include "reactor-uc/error.h"
+#include "reactor-uc/event.h"
+#include "reactor-uc/platform.h"
+#include <stddef.h>
+
+typedef struct Token Token;
+typedef struct TokenPool TokenPool;
+
+/**
+ * @brief A reference-counted buffer from a TokenPool. Ports, actions and delayed connections whose value type is
+ * `Token*` pass the pointer instead of copying the buffer. Each of them holds a reference to the token while it stores
+ * it, and the buffer returns to its pool when the last reference is released. A freshly acquired token has no
+ * references, it must either be set on a port, scheduled on an action or released with `Token_release`.
+ */
+struct Token {
+  TokenPool* pool;
+  size_t ref_count;
+  void* value; // Pointer to the buffer of the token.
+};
+
+struct TokenPool {
+  EventPayloadPool slots; // Each slot holds a Token followed by its buffer.
+  size_t value_offset;    // Offset of the buffer from the start of a slot.
+  MUTEX_T mutex;          // Protects the reference counts.
+};
+
+/**
+ * @brief Take a token with an uninitialized buffer from the pool.
+ * @return The token, or NULL if all tokens of the pool are in use.
+ */
+Token* TokenPool_acquire(TokenPool* self);
+
+void TokenPool_ctor(TokenPool* self, char* slots, size_t* free_list, size_t slot_size, size_t value_offset,
+                    size_t capacity);
+
+/** @brief Take a reference to a token. Does nothing for NULL. Returns the token. */
+Token* Token_retain(Token* self);
+
+/** @brief Drop a reference to a token, the last one returns it to its pool. Does nothing for NULL. */
+void Token_release(Token* self);
+
+/**
+ * @brief Store a token in a slot which holds a reference to the token it stores, e.g. the value of a port. Takes a
+ * reference to the new token before dropping the one to the token previously stored in the slot.
+ */
+void Token_assign(Token** slot, Token* token);
+
+/** Whether an expression, typically the value field of a port or action, holds tokens. */
+#define LF_IS_TOKEN(Value) __builtin_types_compatible_p(__typeof__(Value), Token*)
+
+#define LF_DEFINE_TOKEN_POOL_STRUCT(PoolName, ValueType, Capacity)                                                     \
+  typedef struct {                                                                                                     \
+    TokenPool super;                                                                                                   \
+    struct {                                                                                                           \
+      Token token;                                                                                                     \
+      ValueType value;                                                                                                 \
+    } slots[(Capacity)];                                                                                               \
+    size_t free_list[(Capacity)];                                                                                      \
+  } PoolName;
+
+#define LF_INITIALIZE_TOKEN_POOL(Pool)                                                                                 \
+  TokenPool_ctor(&(Pool)->super, (char*)(Pool)->slots, (Pool)->free_list, sizeof((Pool)->slots[0]),                    \
+                 offsetof(__typeof__((Pool)->slots[0]), value), sizeof((Pool)->slots) / sizeof((Pool)->slots[0]))
+
+#endif
@@ -2,12 +2,17 @@
 #include "reactor-uc/environment.h"
 #include "reactor-uc/logging.h"
 #include "reactor-uc/trigger.h"
+#include "reactor-uc/token.h"
 
 #include <string.h>
 
 void Action_cleanup(Trigger* self) {
   LF_DEBUG(TRIG, "Cleaning up action %p", self);
   self->is_present = false;
+  Action* act = (Action*)self;
+  if (act->payload_pool.holds_tokens) {
+    Token_assign((Token**)act->value_ptr, NULL);
+  }
 }
 
 void Action_prepare(Trigger* self, Event* event) {
@@ -15,7 +20,10 @@ void Action_prepare(Trigger* self, Event* event) {
   Environment* env = self->parent->env;
   Action* act = (Action*)self;
   Scheduler* sched = env->scheduler;
-  if (act->payload_pool.payload_size > 0) {
+  if (act->payload_pool.holds_tokens) {
+    // The value takes its own reference, the one of the event is dropped when its payload is freed below.
+    Token_assign((Token**)act->value_ptr, *(Token**)event->super.payload);
+  } else if (act->payload_pool.payload_size > 0) {
     memcpy(act->value_ptr, event->super.payload, act->payload_pool.payload_size);
   }
 
@@ -106,12 +114,22 @@ lf_ret_t Action_schedule(Action* self, interval_t offset, const void* value) {
   if (value != NULL) {
     ret = self->payload_pool.allocate(&self->payload_pool, &payload);
     validate(ret == LF_OK);
-    memcpy(payload, value, self->payload_pool.payload_size);
+    if (self->payload_pool.holds_tokens) {
+      Token_assign((Token**)payload, *(Token* const*)value);
+    } else {
+      memcpy(payload, value, self->payload_pool.payload_size);
+    }
   }
 
   Event event = EVENT_INIT(tag, (Trigger*)self, payload);
 
-  ret = sched->schedule_at(sched, &event);
+  // Physical actions are scheduled from asynchronous context and go through the lock-free path of the scheduler,
+  // unless the policy has to find the previous event in the event queue.
+  if (self->type == PHYSICAL_ACTION && self->policy != ACTION_POLICY_UPDATE && self->policy != ACTION_POLICY_REPLACE) {
+    ret = sched->schedule_at_async(sched, &event);
+  } else {
+    ret = sched->schedule_at(sched, &event);
+  }
 
   if (ret == LF_OK) {
     self->events_scheduled++;
@@ -127,15 +145,21 @@ lf_ret_t Action_schedule(Action* self, interval_t offset, const void* value) {
   return ret;
 }
 
+void Action_enable_tokens(Action* self) {
+  validate(self->payload_pool.payload_size == sizeof(Token*));
+  self->payload_pool.holds_tokens = true;
+  *(Token**)self->value_ptr = NULL;
+}
+
 void Action_ctor(Action* self, ActionType type, ActionPolicy policy, interval_t min_offset, interval_t min_spacing,
                  Reactor* parent, Reaction** sources, size_t sources_size, Reaction** effects, size_t effects_size,
                  Reaction** observers, size_t observers_size, void* value_ptr, size_t value_size, void* payload_buf,
-                 bool* payload_used_buf, size_t event_bound) {
+                 size_t* payload_free_list_buf, size_t event_bound) {
   int capacity = 0;
   if (payload_buf != NULL) {
     capacity = event_bound;
   }
-  EventPayloadPool_ctor(&self->payload_pool, (char*)payload_buf, payload_used_buf, value_size, capacity, 0);
+  EventPayloadPool_ctor(&self->payload_pool, (char*)payload_buf, payload_free_list_buf, value_size, capacity, 0);
   Trigger_ctor(&self->super, TRIG_ACTION, parent, &self->payload_pool, Action_prepare, Action_cleanup);
 
   self->type = type;
@@ -165,9 +189,9 @@ void Action_ctor(Action* self, ActionType type, ActionPolicy policy, interval_t
 void LogicalAction_ctor(LogicalAction* self, ActionPolicy policy, interval_t min_offset, interval_t min_spacing,
                         Reactor* parent, Reaction** sources, size_t sources_size, Reaction** effects,
                         size_t effects_size, Reaction** observers, size_t observers_size, void* value_ptr,
-                        size_t value_size, void* payload_buf, bool* payload_used_buf, size_t event_bound) {
+                        size_t value_size, void* payload_buf, size_t* payload_free_list_buf, size_t event_bound) {
   Action_ctor(&self->super, LOGICAL_ACTION, policy, min_offset, min_spacing, parent, sources, sources_size, effects,
-              effects_size, observers, observers_size, value_ptr, value_size, payload_buf, payload_used_buf,
+              effects_size, observers, observers_size, value_ptr, value_size, payload_buf, payload_free_list_buf,
               event_bound);
 }
 
@@ -192,9 +216,9 @@ static void PhysicalAction_prepare(Trigger* super, Event* event) {
 void PhysicalAction_ctor(PhysicalAction* self, ActionPolicy policy, interval_t min_offset, interval_t min_spacing,
                          Reactor* parent, Reaction** sources, size_t sources_size, Reaction** effects,
                          size_t effects_size, Reaction** observers, size_t observers_size, void* value_ptr,
-                         size_t value_size, void* payload_buf, bool* payload_used_buf, size_t event_bound) {
+                         size_t value_size, void* payload_buf, size_t* payload_free_list_buf, size_t event_bound) {
   Action_ctor(&self->super, PHYSICAL_ACTION, policy, min_offset, min_spacing, parent, sources, sources_size, effects,
-              effects_size, observers, observers_size, value_ptr, value_size, payload_buf, payload_used_buf,
+              effects_size, observers, observers_size, value_ptr, value_size, payload_buf, payload_free_list_buf,
               event_bound);
   self->super.schedule = PhysicalAction_schedule;
   self->super.super.prepare = PhysicalAction_prepare;
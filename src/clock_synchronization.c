@@ -349,7 +349,7 @@ static void ClockSynchronization_handle_system_event(SystemEventHandler* _self,
 
 void ClockSynchronization_ctor(ClockSynchronization* self, Environment* env, NeighborClock* neighbor_clock,
                                size_t num_neighbors, bool is_grandmaster, size_t payload_size, void* payload_buf,
-                               bool* payload_used_buf, size_t payload_buf_capacity, interval_t period,
+                               size_t* payload_free_list_buf, size_t payload_buf_capacity, interval_t period,
                                interval_t max_adj, float servo_kp, float servo_ki) {
   self->env = env;
   self->neighbor_clock = neighbor_clock;
@@ -361,7 +361,7 @@ void ClockSynchronization_ctor(ClockSynchronization* self, Environment* env, Nei
   self->super.handle = ClockSynchronization_handle_system_event;
   self->period = period;
 
-  EventPayloadPool_ctor(&self->super.payload_pool, (char*)payload_buf, payload_used_buf, payload_size,
+  EventPayloadPool_ctor(&self->super.payload_pool, (char*)payload_buf, payload_free_list_buf, payload_size,
                         payload_buf_capacity, NUM_RESERVED_EVENTS);
 
   for (size_t i = 0; i < num_neighbors; i++) {
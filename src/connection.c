@@ -2,6 +2,7 @@
 #include "reactor-uc/environment.h"
 #include "reactor-uc/event.h"
 #include "reactor-uc/logging.h"
+#include "reactor-uc/token.h"
 #include <assert.h>
 #include <string.h>
 
@@ -48,9 +49,9 @@ void LogicalConnection_trigger_downstreams(Connection* self, tag_t intended_tag,
 
     if (down->effects.size > 0 || down->observers.size > 0) {
       validate(value_size == down->value_size);
-
-      if (value_size > 0) {
-        memcpy(down->value_ptr, value, value_size); // NOLINT
+      // An aliasing input already reads the value from the buffer of the final upstream output.
+      if (!down->is_alias) {
+        Port_store_value(down, value);
       }
 
       // Only call `prepare` and thus trigger downstream reactions once per
@@ -87,6 +88,40 @@ void Connection_ctor(Connection* self, TriggerType type, Reactor* parent, Port**
 void LogicalConnection_ctor(LogicalConnection* self, Reactor* parent, Port** downstreams, size_t num_downstreams) {
   Connection_ctor(&self->super, TRIG_CONN, parent, downstreams, num_downstreams, NULL, NULL, NULL,
                   LogicalConnection_trigger_downstreams);
+  self->aliasing = false;
+}
+
+/** @brief Returns the slot of the value `offset` places behind the head of the ring of a delayed connection. */
+static void* DelayedConnection_ring_slot(DelayedConnection* self, size_t offset) {
+  size_t index = (self->ring_head + offset) % self->payload_pool.capacity;
+  return &self->payload_pool.buffer[index * self->payload_pool.payload_size];
+}
+
+/** @brief Remove the value at the head of the ring and release the token it holds. */
+static void DelayedConnection_ring_pop(DelayedConnection* self) {
+  if (self->payload_pool.holds_tokens) {
+    Token_assign((Token**)DelayedConnection_ring_slot(self, 0), NULL);
+  }
+  self->ring_head = (self->ring_head + 1) % self->payload_pool.capacity;
+  self->ring_size--;
+}
+
+/**
+ * @brief Schedule the event of the value at the head of the ring. Values which can no longer be scheduled, e.g. because
+ * they are after the stop tag, are dropped together with all values behind them.
+ */
+static void DelayedConnection_ring_arm(DelayedConnection* self) {
+  Scheduler* sched = self->super.super.parent->env->scheduler;
+  while (self->ring_size > 0) {
+    Event event = EVENT_INIT(self->ring_tags[self->ring_head], &self->super.super, NULL);
+    lf_ret_t ret = sched->schedule_at(sched, &event);
+    if (ret == LF_OK) {
+      return;
+    }
+    LF_DEBUG(CONN, "Could not schedule delayed connection %p at tag " PRINTF_TAG ", dropping. Error %d", self,
+             event.super.tag, ret);
+    DelayedConnection_ring_pop(self);
+  }
 }
 
 /**
@@ -105,6 +140,17 @@ void DelayedConnection_prepare(Trigger* trigger, Event* event) {
   trigger->is_present = true;
   sched->register_for_cleanup(sched, trigger);
 
+  if (self->ring_tags != NULL) {
+    // The event carries no payload, its value is the head of the ring. Once it is copied into the downstreams, the
+    // event of the next value takes its place in the event queue.
+    assert(self->ring_size > 0 && lf_tag_compare(self->ring_tags[self->ring_head], event->super.tag) == 0);
+    LogicalConnection_trigger_downstreams(&self->super, event->intended_tag, DelayedConnection_ring_slot(self, 0),
+                                          pool->payload_size);
+    DelayedConnection_ring_pop(self);
+    DelayedConnection_ring_arm(self);
+    return;
+  }
+
   LogicalConnection_trigger_downstreams(&self->super, event->intended_tag, event->super.payload, pool->payload_size);
   validate(pool->free(pool, event->super.payload) == LF_OK);
 }
@@ -133,13 +179,39 @@ void DelayedConnection_cleanup(Trigger* trigger) {
       base_tag = self->intended_tag;
     }
     tag_t tag = lf_delay_tag(base_tag, self->delay);
-    Event event = EVENT_INIT(tag, &self->super.super, self->staged_payload_ptr);
-    sched->schedule_at(sched, &event);
+    if (self->ring_tags != NULL) {
+      // The staged value is already in the tail slot of the ring. An event is only scheduled if it is the head.
+      self->ring_tags[(self->ring_head + self->ring_size) % self->payload_pool.capacity] = tag;
+      self->ring_size++;
+      if (self->ring_size == 1) {
+        DelayedConnection_ring_arm(self);
+      }
+    } else {
+      Event event = EVENT_INIT(tag, &self->super.super, self->staged_payload_ptr);
+      sched->schedule_at(sched, &event);
+    }
     self->staged_payload_ptr = NULL;
     self->has_staged_value = false;
   }
 }
 
+/** @brief Get the slot which the value written at the current tag is staged in. */
+static lf_ret_t DelayedConnection_allocate(DelayedConnection* self, void** payload) {
+  EventPayloadPool* pool = &self->payload_pool;
+  if (self->ring_tags == NULL) {
+    return pool->allocate(pool, payload);
+  }
+
+  if (self->ring_size == pool->capacity) {
+    return LF_VALUE_BUFFER_FULL;
+  }
+  *payload = DelayedConnection_ring_slot(self, self->ring_size);
+  if (pool->holds_tokens) {
+    *(Token**)*payload = NULL;
+  }
+  return LF_OK;
+}
+
 void DelayedConnection_trigger_downstreams(Connection* _self, tag_t intended_tag, const void* value,
                                            size_t value_size) {
   DelayedConnection* self = (DelayedConnection*)_self;
@@ -151,7 +223,7 @@ void DelayedConnection_trigger_downstreams(Connection* _self, tag_t intended_tag
   // Check staged_payload_ptr instead of is_present because is_present can be
   // true from prepare() even when staged_payload_ptr is NULL.
   if (self->staged_payload_ptr == NULL) {
-    ret = pool->allocate(pool, &self->staged_payload_ptr);
+    ret = DelayedConnection_allocate(self, &self->staged_payload_ptr);
     if (ret != LF_OK) {
       LF_ERR(CONN, "No more space in event buffer for delayed connection %p, dropping. Capacity is %d", _self,
              self->payload_pool.capacity);
@@ -161,7 +233,10 @@ void DelayedConnection_trigger_downstreams(Connection* _self, tag_t intended_tag
   trigger->is_present = true;
   self->intended_tag = intended_tag;
   self->has_staged_value = true;
-  if (value_size > 0) {
+  if (pool->holds_tokens) {
+    // Overwriting a value staged at the same tag drops the reference to the previous token.
+    Token_assign((Token**)self->staged_payload_ptr, *(Token* const*)value);
+  } else if (value_size > 0) {
     memcpy(self->staged_payload_ptr, value, value_size);
   }
   sched->register_for_cleanup(sched, &_self->super);
@@ -169,14 +244,23 @@ void DelayedConnection_trigger_downstreams(Connection* _self, tag_t intended_tag
 
 void DelayedConnection_ctor(DelayedConnection* self, Reactor* parent, Port** downstreams, size_t num_downstreams,
                             interval_t delay, ConnectionType type, size_t payload_size, void* payload_buf,
-                            bool* payload_used_buf, size_t payload_buf_capacity) {
+                            size_t* payload_free_list_buf, tag_t* payload_tags_buf, size_t payload_buf_capacity) {
 
   self->delay = delay;
   self->staged_payload_ptr = NULL;
   self->has_staged_value = false;
   self->type = type;
-  EventPayloadPool_ctor(&self->payload_pool, (char*)payload_buf, payload_used_buf, payload_size, payload_buf_capacity,
-                        0);
+  // The tags of a physical connection are taken from the physical clock, so only logical connections are known to
+  // produce their values in the order of their tags.
+  if (type == LOGICAL_CONNECTION && payload_size > 0 && payload_buf_capacity > 0) {
+    self->ring_tags = payload_tags_buf;
+  } else {
+    self->ring_tags = NULL;
+  }
+  self->ring_head = 0;
+  self->ring_size = 0;
+  EventPayloadPool_ctor(&self->payload_pool, (char*)payload_buf, payload_free_list_buf, payload_size,
+                        payload_buf_capacity, 0);
   Connection_ctor(&self->super, TRIG_CONN_DELAYED, parent, downstreams, num_downstreams, &self->payload_pool,
                   DelayedConnection_prepare, DelayedConnection_cleanup, DelayedConnection_trigger_downstreams);
 }
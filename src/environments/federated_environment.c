@@ -23,6 +23,10 @@ static void FederatedEnvironment_assemble(Environment* super) {
   // The scheduler will leave the critical section before executing the reactions.
   // Everything else within the runtime happens in a critical section.
   validaten(super->main->calculate_levels(super->main));
+  validaten(super->main->calculate_fanouts(super->main));
+  validaten(super->main->calculate_chain_ids(super->main));
+  validaten(super->main->calculate_stp_inputs(super->main));
+  validaten(super->main->resolve_aliases(super->main));
   lf_ret_t ret;
   FederatedEnvironment_validate(super);
 
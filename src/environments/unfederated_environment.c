@@ -11,6 +11,10 @@ static void Environment_validate(Environment* self) { Reactor_validate(self->mai
 
 static void Environment_assemble(Environment* self) {
   validaten(self->main->calculate_levels(self->main));
+  validaten(self->main->calculate_fanouts(self->main));
+  validaten(self->main->calculate_chain_ids(self->main));
+  validaten(self->main->calculate_stp_inputs(self->main));
+  validaten(self->main->resolve_aliases(self->main));
   Environment_validate(self);
 }
 
@@ -94,6 +98,9 @@ void Environment_ctor(Environment* self, Reactor* main, Scheduler* scheduler, bo
 
   self->startup = NULL;
   self->shutdown = NULL;
+#if PORT_FANOUT_TABLE_SIZE > 0
+  self->fanout_records_used = 0;
+#endif
 }
 
 void Environment_free(Environment* self) {
@@ -1,4 +1,20 @@
 #include "reactor-uc/event.h"
+#include "reactor-uc/token.h"
+
+// Pops the first payload off the free list starting at `head`.
+static lf_ret_t EventPayloadPool_pop(EventPayloadPool* self, size_t* head, void** payload) {
+  size_t index = *head;
+  if (index == self->capacity) {
+    return LF_VALUE_BUFFER_FULL;
+  }
+  *head = self->free_list[index];
+  self->free_list[index] = EVENT_PAYLOAD_POOL_USED;
+  *payload = &self->buffer[index * self->payload_size];
+  if (self->holds_tokens) {
+    *(Token**)*payload = NULL;
+  }
+  return LF_OK;
+}
 
 static lf_ret_t EventPayloadPool_free(EventPayloadPool* self, void* payload) {
   MUTEX_LOCK(self->mutex);
@@ -6,15 +22,22 @@ static lf_ret_t EventPayloadPool_free(EventPayloadPool* self, void* payload) {
     MUTEX_UNLOCK(self->mutex);
     return LF_OK;
   }
-  for (size_t i = 0; i < self->capacity; i++) {
-    if (&self->buffer[i * self->payload_size] == payload) {
-      self->used[i] = false;
-      MUTEX_UNLOCK(self->mutex);
-      return LF_OK;
-    }
+  // The index is computed from the address. Pointers outside the buffer, into the middle of a payload or to a payload
+  // which is not allocated are rejected.
+  size_t offset = (size_t)((char*)payload - self->buffer);
+  size_t index = offset / self->payload_size;
+  if ((char*)payload < self->buffer || index >= self->capacity || offset % self->payload_size != 0 ||
+      self->free_list[index] != EVENT_PAYLOAD_POOL_USED) {
+    MUTEX_UNLOCK(self->mutex);
+    return LF_INVALID_VALUE;
   }
+  size_t* head = index < self->reserved ? &self->reserved_free_head : &self->free_head;
+  self->free_list[index] = *head;
+  *head = index;
+  Token* token = self->holds_tokens ? *(Token**)payload : NULL;
   MUTEX_UNLOCK(self->mutex);
-  return LF_INVALID_VALUE;
+  Token_release(token);
+  return LF_OK;
 }
 
 static lf_ret_t EventPayloadPool_allocate(EventPayloadPool* self, void** payload) {
@@ -24,43 +47,33 @@ static lf_ret_t EventPayloadPool_allocate(EventPayloadPool* self, void** payload
     *payload = NULL;
     return LF_OK;
   }
-  for (size_t i = self->reserved; i < self->capacity; i++) {
-    if (!self->used[i]) {
-      self->used[i] = true;
-      *payload = &self->buffer[i * self->payload_size];
-      MUTEX_UNLOCK(self->mutex);
-      return LF_OK;
-    }
-  }
+  lf_ret_t ret = EventPayloadPool_pop(self, &self->free_head, payload);
   MUTEX_UNLOCK(self->mutex);
-  return LF_VALUE_BUFFER_FULL;
+  return ret;
 }
 
 static lf_ret_t EventPayloadPool_allocate_reserved(EventPayloadPool* self, void** payload) {
   MUTEX_LOCK(self->mutex);
-  for (size_t i = 0; i < self->reserved; i++) {
-    if (!self->used[i]) {
-      self->used[i] = true;
-      *payload = &self->buffer[i * self->payload_size];
-      MUTEX_UNLOCK(self->mutex);
-      return LF_OK;
-    }
-  }
+  lf_ret_t ret = EventPayloadPool_pop(self, &self->reserved_free_head, payload);
   MUTEX_UNLOCK(self->mutex);
-  return LF_VALUE_BUFFER_FULL;
+  return ret;
 }
 
-void EventPayloadPool_ctor(EventPayloadPool* self, char* buffer, bool* used, size_t element_size, size_t capacity,
-                           size_t reserved) {
+void EventPayloadPool_ctor(EventPayloadPool* self, char* buffer, size_t* free_list, size_t element_size,
+                           size_t capacity, size_t reserved) {
   self->buffer = buffer;
-  self->used = used;
+  self->free_list = free_list;
   self->capacity = capacity;
   self->payload_size = element_size;
   self->reserved = reserved;
+  self->holds_tokens = false;
 
-  if (self->used != NULL) {
+  // Initially, each partition is a list of its payloads in ascending order.
+  self->reserved_free_head = reserved > 0 ? 0 : capacity;
+  self->free_head = reserved < capacity ? reserved : capacity;
+  if (self->free_list != NULL) {
     for (size_t i = 0; i < capacity; i++) {
-      self->used[i] = false;
+      self->free_list[i] = (i + 1 == reserved) ? capacity : i + 1;
     }
   }
 
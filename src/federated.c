@@ -159,9 +159,9 @@ void FederatedInputConnection_cleanup(Trigger* trigger) {
 
 void FederatedInputConnection_ctor(FederatedInputConnection* self, Reactor* parent, interval_t delay, bool is_physical,
                                    interval_t max_wait, Port** downstreams, size_t downstreams_size, void* payload_buf,
-                                   bool* payload_used_buf, size_t payload_size, size_t payload_buf_capacity) {
-  EventPayloadPool_ctor(&self->payload_pool, (char*)payload_buf, payload_used_buf, payload_size, payload_buf_capacity,
-                        0);
+                                   size_t* payload_free_list_buf, size_t payload_size, size_t payload_buf_capacity) {
+  EventPayloadPool_ctor(&self->payload_pool, (char*)payload_buf, payload_free_list_buf, payload_size,
+                        payload_buf_capacity, 0);
   Connection_ctor(&self->super, TRIG_CONN_FEDERATED_INPUT, parent, downstreams, downstreams_size, &self->payload_pool,
                   FederatedInputConnection_prepare, FederatedInputConnection_cleanup, NULL);
   Mutex_ctor(&self->mutex.super);
@@ -216,8 +216,11 @@ void FederatedConnectionBundle_handle_tagged_msg(FederatedConnectionBundle* self
 
     if (status == LF_OK) {
       Event event = EVENT_INIT(tag, &input->super.super, payload);
-      ret = sched->schedule_at(sched, &event);
-      LF_INFO(FED, "First schedule_at returned %d for desired tag: " PRINTF_TAG, ret, tag);
+      // With an ingress queue (EVENT_INGRESS_SIZE > 0), this returns LF_OK once the event is queued. The scheduler
+      // checks the tag when it drains the queue, reports safe-to-process violations and drops events after the stop
+      // tag. The cases below only apply when the event is scheduled directly, i.e. without or with a full queue.
+      ret = sched->schedule_at_async(sched, &event);
+      LF_INFO(FED, "schedule_at_async returned %d for desired tag: " PRINTF_TAG, ret, tag);
       switch (ret) {
       case LF_AFTER_STOP_TAG:
         LF_WARN(FED, "Tried scheduling event after stop tag. Dropping");
@@ -3,7 +3,10 @@
 #include "reactor-uc/environment.h"
 
 #include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #define ANSI_COLOR_RED "\x1b[31m"
 #define ANSI_COLOR_GREEN "\x1b[32m"
@@ -20,29 +23,31 @@ void log_printf(const char* fmt, ...) {
   va_end(args);
 }
 
-void log_message(int level, const char* module, const char* fmt, ...) {
-  const char* level_str;
+static const char* log_level_str(int level) {
   switch (level) {
   case LF_LOG_LEVEL_ERROR:
-    level_str = "ERROR";
-    break;
+    return "ERROR";
   case LF_LOG_LEVEL_WARN:
-    level_str = "WARN";
-    break;
+    return "WARN";
   case LF_LOG_LEVEL_INFO:
-    level_str = "INFO";
-    break;
+    return "INFO";
   case LF_LOG_LEVEL_DEBUG:
-    level_str = "DEBUG";
-    break;
+    return "DEBUG";
   default:
-    level_str = "UNKNOWN";
-    break;
+    return "UNKNOWN";
   }
+}
 
-  va_list args;
-  va_start(args, fmt);
+static instant_t log_timestamp(void) {
+#if LF_TIMESTAMP_LOGS == 1
+  if (_lf_environment) {
+    return _lf_environment->platform->get_physical_time(_lf_environment->platform);
+  }
+#endif
+  return 0;
+}
 
+static void log_header(int level, const char* module, instant_t timestamp) {
 #if LF_COLORIZE_LOGS == 1
   switch (level) {
   case LF_LOG_LEVEL_ERROR:
@@ -63,18 +68,14 @@ void log_message(int level, const char* module, const char* fmt, ...) {
 #endif
 
 #if LF_TIMESTAMP_LOGS == 1
-  instant_t timestamp = 0;
-  if (_lf_environment) {
-    timestamp = _lf_environment->platform->get_physical_time(_lf_environment->platform);
-  }
-  log_printf("(" PRINTF_TIME ") [%s] [%s] ", timestamp, level_str, module);
-
+  log_printf("(" PRINTF_TIME ") [%s] [%s] ", timestamp, log_level_str(level), module);
 #else
-
-  log_printf("[%s] [%s] ", level_str, module);
+  (void)timestamp;
+  log_printf("[%s] [%s] ", log_level_str(level), module);
 #endif
+}
 
-  Platform_vprintf(fmt, args);
+static void log_trailer(void) {
 #if LF_COLORIZE_LOGS == 1
   log_printf(ANSI_COLOR_RESET);
 #endif
@@ -84,6 +85,378 @@ void log_message(int level, const char* module, const char* fmt, ...) {
 #else
   log_printf("\n");
 #endif
+}
+
+#if defined(LF_LOG_DEFERRED)
+#if (LF_LOG_DEFERRED_BUFFER_SIZE & (LF_LOG_DEFERRED_BUFFER_SIZE - 1)) != 0 || LF_LOG_DEFERRED_BUFFER_SIZE == 0
+#error "LF_LOG_DEFERRED_BUFFER_SIZE must be a power of two"
+#endif
+
+#define LOG_BUFFER_MASK (LF_LOG_DEFERRED_BUFFER_SIZE - 1)
+
+/** How the argument of a conversion specification is passed, which decides how it is read and printed again. */
+typedef enum {
+  LOG_ARG_NONE,
+  LOG_ARG_INT,
+  LOG_ARG_LONG,
+  LOG_ARG_LLONG,
+  LOG_ARG_INTMAX,
+  LOG_ARG_SIZE,
+  LOG_ARG_PTRDIFF,
+  LOG_ARG_DOUBLE,
+  LOG_ARG_STRING,
+  LOG_ARG_POINTER,
+  LOG_ARG_UNSUPPORTED,
+} LogArgKind;
+
+typedef union {
+  intmax_t i;
+  double d;
+  const void* p;
+  size_t string_offset;
+} LogArg;
+
+typedef struct {
+  const char* fmt;
+  const char* module;
+  instant_t timestamp;
+  int level;
+  size_t nargs;
+  LogArg args[LF_LOG_DEFERRED_MAX_ARGS];
+  char strings[LF_LOG_DEFERRED_STRING_SIZE];
+} LogRecord;
+
+// The ring buffer is a bounded multi-producer queue where each slot carries a sequence number. A producer claims a
+// position with a CAS on `log_write_pos`, fills the slot and publishes it by advancing its sequence. The sequence is
+// stored relative to the index of the slot, so the zero-initialized buffer is empty.
+typedef struct {
+  size_t sequence;
+  LogRecord record;
+} LogSlot;
+
+static LogSlot log_buffer[LF_LOG_DEFERRED_BUFFER_SIZE];
+static size_t log_write_pos = 0;
+static size_t log_read_pos = 0;
+static size_t log_dropped = 0;
+static bool log_flushing = false;
+
+/**
+ * @brief Parses the conversion specification following a `%`.
+ *
+ * @param spec The character after the `%`.
+ * @param end Set to the character after the conversion specifier.
+ * @param stars Set to the number of `*` widths and precisions, which each take an int argument.
+ * @return How the argument of the conversion is passed.
+ */
+static LogArgKind log_parse_spec(const char* spec, const char** end, size_t* stars) {
+  const char* c = spec;
+  *stars = 0;
+  while (*c != '\0' && strchr("-+ #0", *c) != NULL) {
+    c++;
+  }
+  for (int i = 0; i < 2; i++) {
+    if (*c == '*') {
+      (*stars)++;
+      c++;
+    } else {
+      while (*c >= '0' && *c <= '9') {
+        c++;
+      }
+    }
+    if (i == 1 || *c != '.') {
+      break;
+    }
+    c++;
+  }
+
+  LogArgKind integer = LOG_ARG_INT;
+  bool long_double = false;
+  switch (*c) {
+  case 'h':
+    c += c[1] == 'h' ? 2 : 1;
+    break;
+  case 'l':
+    integer = c[1] == 'l' ? LOG_ARG_LLONG : LOG_ARG_LONG;
+    c += c[1] == 'l' ? 2 : 1;
+    break;
+  case 'j':
+    integer = LOG_ARG_INTMAX;
+    c++;
+    break;
+  case 'z':
+    integer = LOG_ARG_SIZE;
+    c++;
+    break;
+  case 't':
+    integer = LOG_ARG_PTRDIFF;
+    c++;
+    break;
+  case 'L':
+    long_double = true;
+    c++;
+    break;
+  default:
+    break;
+  }
+
+  *end = *c == '\0' ? c : c + 1;
+  switch (*c) {
+  case 'd':
+  case 'i':
+  case 'o':
+  case 'u':
+  case 'x':
+  case 'X':
+  case 'c':
+    return integer;
+  case 'f':
+  case 'F':
+  case 'e':
+  case 'E':
+  case 'g':
+  case 'G':
+  case 'a':
+  case 'A':
+    return long_double ? LOG_ARG_UNSUPPORTED : LOG_ARG_DOUBLE;
+  case 's':
+    return integer == LOG_ARG_INT ? LOG_ARG_STRING : LOG_ARG_UNSUPPORTED;
+  case 'p':
+    return LOG_ARG_POINTER;
+  case '%':
+    return LOG_ARG_NONE;
+  default:
+    return LOG_ARG_UNSUPPORTED;
+  }
+}
+
+// Copies a string argument into the record and returns its offset. Once the space is used up, the offset of the last
+// terminator is returned, i.e. an empty string.
+static size_t log_copy_string(LogRecord* record, size_t* used, const char* str) {
+  if (*used == LF_LOG_DEFERRED_STRING_SIZE) {
+    return LF_LOG_DEFERRED_STRING_SIZE - 1;
+  }
+  if (str == NULL) {
+    str = "(null)";
+  }
+  size_t offset = *used;
+  while (*str != '\0' && *used < LF_LOG_DEFERRED_STRING_SIZE - 1) {
+    record->strings[(*used)++] = *str++;
+  }
+  record->strings[(*used)++] = '\0';
+  return offset;
+}
+
+// Reads the arguments of a message without formatting it. Reading stops at the first conversion which is not supported
+// or does not fit, its argument and all following ones are printed as `?`.
+static void log_read_args(LogRecord* record, const char* fmt, va_list args) {
+  size_t used = 0;
+  size_t stars;
+  record->nargs = 0;
+  for (const char* c = strchr(fmt, '%'); c != NULL; c = strchr(c, '%')) {
+    LogArgKind kind = log_parse_spec(c + 1, &c, &stars);
+    if (kind == LOG_ARG_NONE) {
+      continue;
+    }
+    if (kind == LOG_ARG_UNSUPPORTED || record->nargs + stars + 1 > LF_LOG_DEFERRED_MAX_ARGS) {
+      return;
+    }
+    for (; stars > 0; stars--) {
+      record->args[record->nargs++].i = va_arg(args, int);
+    }
+    LogArg* arg = &record->args[record->nargs++];
+    switch (kind) {
+    case LOG_ARG_INT:
+      arg->i = va_arg(args, int);
+      break;
+    case LOG_ARG_LONG:
+      arg->i = va_arg(args, long);
+      break;
+    case LOG_ARG_LLONG:
+      arg->i = va_arg(args, long long);
+      break;
+    case LOG_ARG_INTMAX:
+      arg->i = va_arg(args, intmax_t);
+      break;
+    case LOG_ARG_SIZE:
+      arg->i = (intmax_t)va_arg(args, size_t);
+      break;
+    case LOG_ARG_PTRDIFF:
+      arg->i = va_arg(args, ptrdiff_t);
+      break;
+    case LOG_ARG_DOUBLE:
+      arg->d = va_arg(args, double);
+      break;
+    case LOG_ARG_STRING:
+      arg->string_offset = log_copy_string(record, &used, va_arg(args, const char*));
+      break;
+    case LOG_ARG_POINTER:
+      arg->p = va_arg(args, const void*);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+static void log_defer(int level, const char* module, const char* fmt, va_list args) {
+  size_t pos = __atomic_load_n(&log_write_pos, __ATOMIC_RELAXED);
+  LogSlot* slot;
+  for (;;) {
+    slot = &log_buffer[pos & LOG_BUFFER_MASK];
+    size_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) + (pos & LOG_BUFFER_MASK);
+    intptr_t diff = (intptr_t)(sequence - pos);
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&log_write_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // The buffer is full. Never block the logging thread, the flush reports how many messages were lost.
+      __atomic_add_fetch(&log_dropped, 1, __ATOMIC_RELAXED);
+      return;
+    } else {
+      pos = __atomic_load_n(&log_write_pos, __ATOMIC_RELAXED);
+    }
+  }
+
+  LogRecord* record = &slot->record;
+  record->fmt = fmt;
+  record->module = module;
+  record->level = level;
+  record->timestamp = log_timestamp();
+  log_read_args(record, fmt, args);
+  __atomic_store_n(&slot->sequence, pos + 1 - (pos & LOG_BUFFER_MASK), __ATOMIC_RELEASE);
+}
+
+// Prints a single conversion specification with the arguments stored for it. The `*` widths and precisions are
+// replaced by their values, so the specification can be printed with its argument alone.
+static void log_print_spec(const LogRecord* record, const char* spec, const char* end, LogArgKind kind, size_t stars,
+                           size_t* next_arg) {
+  if (kind == LOG_ARG_NONE) {
+    log_printf("%%");
+    return;
+  }
+  if (kind == LOG_ARG_UNSUPPORTED || *next_arg + stars + 1 > record->nargs) {
+    *next_arg = record->nargs;
+    log_printf("?");
+    return;
+  }
+
+  char buf[32];
+  size_t len = 0;
+  for (const char* c = spec; c < end && len < sizeof(buf) - 1; c++) {
+    if (*c != '*') {
+      buf[len++] = *c;
+      continue;
+    }
+    int value = (int)record->args[(*next_arg)++].i;
+    if (value < 0 && len > 0 && buf[len - 1] == '.') {
+      len--; // A negative precision is taken as if it were omitted.
+      continue;
+    }
+    int n = snprintf(&buf[len], sizeof(buf) - len, "%d", value);
+    len = n > 0 && (size_t)n < sizeof(buf) - len ? len + (size_t)n : sizeof(buf) - 1;
+  }
+  buf[len] = '\0';
+
+  const LogArg* arg = &record->args[(*next_arg)++];
+  switch (kind) {
+  case LOG_ARG_INT:
+    log_printf(buf, (int)arg->i);
+    break;
+  case LOG_ARG_LONG:
+    log_printf(buf, (long)arg->i);
+    break;
+  case LOG_ARG_LLONG:
+    log_printf(buf, (long long)arg->i);
+    break;
+  case LOG_ARG_INTMAX:
+    log_printf(buf, arg->i);
+    break;
+  case LOG_ARG_SIZE:
+    log_printf(buf, (size_t)arg->i);
+    break;
+  case LOG_ARG_PTRDIFF:
+    log_printf(buf, (ptrdiff_t)arg->i);
+    break;
+  case LOG_ARG_DOUBLE:
+    log_printf(buf, arg->d);
+    break;
+  case LOG_ARG_STRING:
+    log_printf(buf, &record->strings[arg->string_offset]);
+    break;
+  case LOG_ARG_POINTER:
+    log_printf(buf, arg->p);
+    break;
+  default:
+    break;
+  }
+}
+
+static void log_print_record(const LogRecord* record) {
+  log_header(record->level, record->module, record->timestamp);
+  size_t next_arg = 0;
+  size_t stars;
+  const char* c = record->fmt;
+  for (const char* percent = strchr(c, '%'); percent != NULL; percent = strchr(c, '%')) {
+    if (percent > c) {
+      log_printf("%.*s", (int)(percent - c), c);
+    }
+    LogArgKind kind = log_parse_spec(percent + 1, &c, &stars);
+    log_print_spec(record, percent, c, kind, stars, &next_arg);
+  }
+  log_printf("%s", c);
+  log_trailer();
+}
+
+void log_flush(void) {
+  // There is a single consumer at a time, e.g. the background thread of the platform or the exit handler.
+  while (__atomic_exchange_n(&log_flushing, true, __ATOMIC_ACQUIRE)) {
+  }
+
+  LogRecord record;
+  for (;;) {
+    size_t index = log_read_pos & LOG_BUFFER_MASK;
+    LogSlot* slot = &log_buffer[index];
+    if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) + index != log_read_pos + 1) {
+      break;
+    }
+    // Copy the record out, so the slot is released before the slow formatting.
+    record = slot->record;
+    __atomic_store_n(&slot->sequence, log_read_pos + LF_LOG_DEFERRED_BUFFER_SIZE - index, __ATOMIC_RELEASE);
+    log_read_pos++;
+    log_print_record(&record);
+  }
+
+  size_t dropped = __atomic_exchange_n(&log_dropped, 0, __ATOMIC_RELAXED);
+  if (dropped > 0) {
+    log_header(LF_LOG_LEVEL_WARN, "LOG", log_timestamp());
+    log_printf("%zu messages were dropped because the log buffer was full", dropped);
+    log_trailer();
+  }
+
+  __atomic_store_n(&log_flushing, false, __ATOMIC_RELEASE);
+}
+#else
+void log_flush(void) {}
+#endif
+
+void log_message(int level, const char* module, const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+
+#if defined(LF_LOG_DEFERRED)
+  if (level > LF_LOG_LEVEL_ERROR) {
+    log_defer(level, module, fmt, args);
+    va_end(args);
+    return;
+  }
+  // Errors are printed right away, as they often precede an exit, but after the messages logged before them.
+  log_flush();
+#endif
+
+  log_header(level, module, log_timestamp());
+  Platform_vprintf(fmt, args);
+  log_trailer();
 
   va_end(args);
 }
@@ -1,18 +1,66 @@
+// Needed for `pthread_setaffinity_np` and the CPU_* macros. Must be defined before any system header is included.
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "reactor-uc/platform/posix/posix.h"
 #include "reactor-uc/logging.h"
 #include <errno.h>
 #include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <time.h>
+#include <unistd.h>
 #include <stdbool.h>
 
+// Linux lets the scheduler block on a futex, which `notify` can wake up without taking a lock, or in the event loop on
+// epoll. Elsewhere it blocks on a condition variable.
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#define PLATFORM_POSIX_FUTEX
+#endif
+
 static PlatformPosix platform;
 
 static instant_t convert_timespec_to_ns(struct timespec tp) { return ((instant_t)tp.tv_sec) * BILLION + tp.tv_nsec; }
 
 void Platform_vprintf(const char* fmt, va_list args) { vprintf(fmt, args); }
 
+#if defined(LF_LOG_DEFERRED)
+// How often the background thread prints the deferred log messages.
+#ifndef PLATFORM_POSIX_LOG_FLUSH_PERIOD
+#define PLATFORM_POSIX_LOG_FLUSH_PERIOD MSEC(10)
+#endif
+
+static void* log_flush_thread(void* arg) {
+  (void)arg;
+  const struct timespec period = {.tv_sec = PLATFORM_POSIX_LOG_FLUSH_PERIOD / BILLION,
+                                  .tv_nsec = PLATFORM_POSIX_LOG_FLUSH_PERIOD % BILLION};
+  for (;;) {
+    log_flush();
+    nanosleep(&period, NULL);
+  }
+  return NULL;
+}
+
+// Started once, by the first platform constructed. The thread is created before any real-time profile is applied, so it
+// keeps the default scheduling and never competes with the scheduler. Messages logged after its last flush are printed
+// by the exit handler.
+static void start_log_flush_thread(void) {
+  pthread_t thread;
+  validaten(pthread_create(&thread, NULL, log_flush_thread, NULL));
+  validaten(pthread_detach(thread));
+  atexit(log_flush);
+}
+#endif
+
 // lf_exit should be defined in main.c and should call Environment_free, if not we provide an empty implementation here.
 __attribute__((weak)) void lf_exit(void) {}
 
@@ -39,32 +87,175 @@ instant_t PlatformPosix_get_physical_time(Platform* super) {
   return convert_timespec_to_ns(tspec);
 }
 
+// Sleeping is done on the monotonic clock, so steps of the realtime clock, on which physical time is measured, do not
+// cut a sleep short or extend it. macOS supports neither `clock_nanosleep` nor `pthread_condattr_setclock`.
+#if defined(__APPLE__)
+#define WAIT_CLOCK CLOCK_REALTIME
+#else
+#define WAIT_CLOCK CLOCK_MONOTONIC
+#endif
+
+static instant_t PlatformPosix_get_wait_clock_time(void) {
+  struct timespec tspec;
+  if (clock_gettime(WAIT_CLOCK, &tspec) != 0) {
+    throw("POSIX could not get the time of the wait clock");
+  }
+  return convert_timespec_to_ns(tspec);
+}
+
+/**
+ * @brief Convert @p wakeup_time, in physical time, to the wait clock. The difference between the clocks is sampled
+ * when the wait begins.
+ */
+static instant_t PlatformPosix_to_wait_clock(Platform* super, instant_t wakeup_time) {
+  if (wakeup_time == FOREVER) {
+    return FOREVER;
+  }
+  interval_t duration = wakeup_time - super->get_physical_time(super);
+  return lf_time_add(PlatformPosix_get_wait_clock_time(), duration);
+}
+
+/** @brief Sleep until @p wakeup, in time of the wait clock. */
+static void PlatformPosix_sleep_until(instant_t wakeup) {
+#if defined(__APPLE__)
+  interval_t duration = wakeup - PlatformPosix_get_wait_clock_time();
+  if (duration > 0) {
+    const struct timespec tspec = convert_ns_to_timespec(duration);
+    nanosleep(&tspec, NULL);
+  }
+#else
+  const struct timespec tspec = convert_ns_to_timespec(wakeup);
+  // An absolute wakeup time can simply be retried when a signal interrupts the sleep.
+  while (clock_nanosleep(WAIT_CLOCK, TIMER_ABSTIME, &tspec, NULL) == EINTR) {
+  }
+#endif
+}
+
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+// The number of ready file descriptors handled per call to `epoll_wait`. Any others are returned by the next call.
+#define PLATFORM_POSIX_EVENT_LOOP_MAX_EVENTS 8
+
+/**
+ * @brief Block until `sleeping` is cleared by `notify`, until @p wakeup, in time of the wait clock, or until the
+ * socket of a network channel becomes readable, which is reported as an asynchronous event.
+ */
+static void PlatformPosix_block(PlatformPosix* self, instant_t wakeup) {
+  // A zero expiration disarms the timer, so a wait until FOREVER only ends on an event.
+  struct itimerspec timer = {0};
+  if (wakeup != FOREVER) {
+    timer.it_value = convert_ns_to_timespec(wakeup);
+  }
+  validaten(timerfd_settime(self->timer_fd, TFD_TIMER_ABSTIME, &timer, NULL));
+
+  struct epoll_event events[PLATFORM_POSIX_EVENT_LOOP_MAX_EVENTS];
+  uint64_t count;
+  while (__atomic_load_n(&self->sleeping, __ATOMIC_ACQUIRE)) {
+    int num_events = epoll_wait(self->epoll_fd, events, PLATFORM_POSIX_EVENT_LOOP_MAX_EVENTS, -1);
+    if (num_events < 0) {
+      validate(errno == EINTR);
+      continue;
+    }
+
+    bool done = false;
+    for (int i = 0; i < num_events; i++) {
+      if (events[i].data.fd == self->timer_fd || events[i].data.fd == self->event_fd) {
+        // Both are non-blocking and only have to be drained, so they are not readable anymore.
+        ssize_t res = read(events[i].data.fd, &count, sizeof(count));
+        (void)res;
+        done |= events[i].data.fd == self->timer_fd;
+      } else {
+        __atomic_store_n(&self->new_async_event, true, __ATOMIC_RELEASE);
+        done = true;
+      }
+    }
+    if (done) {
+      return;
+    }
+  }
+}
+
+static void PlatformPosix_wake(PlatformPosix* self) {
+  const uint64_t one = 1;
+  ssize_t res = write(self->event_fd, &one, sizeof(one));
+  (void)res; // Only fails if the counter would overflow, in which case the eventfd is readable anyway.
+}
+
+lf_ret_t PlatformPosix_register_fd(PlatformPosix* self, int fd) {
+  struct epoll_event event = {.events = EPOLLIN, .data.fd = fd};
+  if (epoll_ctl(self->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+    LF_ERR(PLATFORM, "Could not add fd %d to the event loop errno=%d", fd, errno);
+    return LF_ERR;
+  }
+  return LF_OK;
+}
+
+void PlatformPosix_unregister_fd(PlatformPosix* self, int fd) {
+  // Fails if the fd was not registered, which is harmless.
+  epoll_ctl(self->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+}
+#elif defined(PLATFORM_POSIX_FUTEX)
+/** @brief Block until `sleeping` is cleared by `notify` or until @p wakeup, in time of the wait clock. */
+static void PlatformPosix_block(PlatformPosix* self, instant_t wakeup) {
+  const struct timespec tspec = convert_ns_to_timespec(wakeup);
+  while (__atomic_load_n(&self->sleeping, __ATOMIC_ACQUIRE)) {
+    // FUTEX_WAIT_BITSET takes an absolute timeout on the monotonic clock. EAGAIN, i.e. `sleeping` was cleared before
+    // blocking, EINTR and spurious wakeups are handled by checking the flag again.
+    if (syscall(SYS_futex, &self->sleeping, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, 1,
+                wakeup == FOREVER ? NULL : &tspec, NULL, FUTEX_BITSET_MATCH_ANY) != 0 &&
+        errno == ETIMEDOUT) {
+      return;
+    }
+  }
+}
+
+static void PlatformPosix_wake(PlatformPosix* self) {
+  syscall(SYS_futex, &self->sleeping, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, NULL, NULL, 0);
+}
+#else
+static void PlatformPosix_block(PlatformPosix* self, instant_t wakeup) {
+  const struct timespec tspec = convert_ns_to_timespec(wakeup);
+  MUTEX_LOCK(self->mutex);
+  // `notify` clears the flag before taking the mutex, so checking it under the mutex cannot miss the signal.
+  while (__atomic_load_n(&self->sleeping, __ATOMIC_ACQUIRE)) {
+    int res = pthread_cond_timedwait(&self->cond, &self->mutex.lock, &tspec);
+    if (res == ETIMEDOUT) {
+      break;
+    }
+    validate(res == 0);
+  }
+  MUTEX_UNLOCK(self->mutex);
+}
+
+static void PlatformPosix_wake(PlatformPosix* self) {
+  MUTEX_LOCK(self->mutex);
+  validaten(pthread_cond_signal(&self->cond));
+  MUTEX_UNLOCK(self->mutex);
+}
+#endif
+
 lf_ret_t PlatformPosix_wait_until_interruptible(Platform* super, instant_t wakeup_time) {
   LF_DEBUG(PLATFORM, "Interruptable wait until " PRINTF_TIME, wakeup_time);
-  lf_ret_t ret;
   PlatformPosix* self = (PlatformPosix*)super;
-  MUTEX_LOCK(self->mutex);
+  const instant_t wakeup = PlatformPosix_to_wait_clock(super, wakeup_time);
 
-  if (self->new_async_event) {
-    self->new_async_event = false;
-    MUTEX_UNLOCK(self->mutex);
-    return LF_SLEEP_INTERRUPTED;
+  // Announce that the scheduler is about to block before checking for an event. Both are sequentially consistent, as
+  // are the accesses in `notify`, so either the event is seen here or `notify` sees the flag and wakes us up.
+  __atomic_store_n(&self->sleeping, 1, __ATOMIC_SEQ_CST);
+  if (!__atomic_load_n(&self->new_async_event, __ATOMIC_SEQ_CST)) {
+    PlatformPosix_block(self, wakeup - self->spin_wait_threshold);
   }
+  __atomic_store_n(&self->sleeping, 0, __ATOMIC_RELAXED);
 
-  const struct timespec tspec = convert_ns_to_timespec(wakeup_time);
-  int res = pthread_cond_timedwait(&self->cond, &self->mutex.lock, &tspec);
-  if (res == 0) {
-    LF_DEBUG(PLATFORM, "Wait until interrupted");
-    ret = LF_SLEEP_INTERRUPTED;
-  } else if (res == ETIMEDOUT) {
-    LF_DEBUG(PLATFORM, "Wait until completed");
-    ret = LF_OK;
-  } else {
-    validate(false);
-  }
+  // Spin for the rest of the wait, while still watching for asynchronous events.
+  do {
+    if (__atomic_exchange_n(&self->new_async_event, false, __ATOMIC_ACQUIRE)) {
+      LF_DEBUG(PLATFORM, "Wait until interrupted");
+      return LF_SLEEP_INTERRUPTED;
+    }
+  } while (self->spin_wait_threshold > 0 && PlatformPosix_get_wait_clock_time() < wakeup);
 
-  MUTEX_UNLOCK(self->mutex);
-  return ret;
+  LF_DEBUG(PLATFORM, "Wait until completed");
+  return LF_OK;
 }
 
 lf_ret_t PlatformPosix_wait_for(Platform* super, instant_t duration) {
@@ -83,21 +274,94 @@ lf_ret_t PlatformPosix_wait_for(Platform* super, instant_t duration) {
 
 lf_ret_t PlatformPosix_wait_until(Platform* super, instant_t wakeup_time) {
   LF_DEBUG(PLATFORM, "wait until " PRINTF_TIME, wakeup_time);
-  interval_t sleep_duration = wakeup_time - super->get_physical_time(super);
-  LF_DEBUG(PLATFORM, "wait duration " PRINTF_TIME, sleep_duration);
-  return PlatformPosix_wait_for(super, sleep_duration);
+  PlatformPosix* self = (PlatformPosix*)super;
+  const instant_t wakeup = PlatformPosix_to_wait_clock(super, wakeup_time);
+  const instant_t sleep_until = wakeup - self->spin_wait_threshold;
+
+  if (sleep_until > PlatformPosix_get_wait_clock_time()) {
+    PlatformPosix_sleep_until(sleep_until);
+  }
+  while (PlatformPosix_get_wait_clock_time() < wakeup) {
+  }
+  return LF_OK;
 }
 
 void PlatformPosix_notify(Platform* super) {
   PlatformPosix* self = (PlatformPosix*)super;
-  MUTEX_LOCK(self->mutex);
-  self->new_async_event = true;
-  validaten(pthread_cond_signal(&self->cond));
-  MUTEX_UNLOCK(self->mutex);
+  __atomic_store_n(&self->new_async_event, true, __ATOMIC_SEQ_CST);
+  // Most events arrive while the scheduler is busy, in which case setting the flag is all there is to do.
+  if (__atomic_exchange_n(&self->sleeping, 0, __ATOMIC_SEQ_CST)) {
+    PlatformPosix_wake(self);
+  }
 
   LF_DEBUG(PLATFORM, "New async event");
 }
 
+lf_ret_t PlatformPosix_apply_thread_profile(const ThreadProfilePosix* profile) {
+  lf_ret_t ret = LF_OK;
+  int res;
+
+  if (profile->policy >= 0) {
+    struct sched_param param = {.sched_priority = profile->priority};
+    res = pthread_setschedparam(pthread_self(), profile->policy, &param);
+    if (res != 0) {
+      LF_WARN(PLATFORM, "Could not set scheduling policy %d with priority %d: %s", profile->policy, profile->priority,
+              strerror(res));
+      ret = LF_ERR;
+    }
+  }
+
+  if (profile->cpu >= 0) {
+#if defined(__linux__)
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(profile->cpu, &cpus);
+    res = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (res != 0) {
+      LF_WARN(PLATFORM, "Could not pin thread to CPU %d: %s", profile->cpu, strerror(res));
+      ret = LF_ERR;
+    }
+#else
+    LF_WARN(PLATFORM, "Pinning threads to a CPU is not supported on this platform");
+    ret = LF_ERR;
+#endif
+  }
+
+  return ret;
+}
+
+/** @brief Touch @p size bytes of the stack, so later calls do not page fault when they first grow into it. */
+static void __attribute__((noinline)) PlatformPosix_prefault_stack(size_t size) {
+  unsigned char stack[size];
+  volatile unsigned char* page = stack; // Keeps the writes from being optimized away.
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  for (size_t i = 0; i < size; i += page_size) {
+    page[i] = 0;
+  }
+}
+
+lf_ret_t PlatformPosix_set_rt_profile(PlatformPosix* self, const RtProfilePosix* profile) {
+  lf_ret_t ret = LF_OK;
+  self->rt_profile = *profile;
+
+  if (profile->lock_memory) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      LF_WARN(PLATFORM, "Could not lock memory: %s", strerror(errno));
+      ret = LF_ERR;
+    }
+  }
+
+  // With locked memory, the pages stay resident once they have been touched.
+  if (profile->prefault_stack_size > 0) {
+    PlatformPosix_prefault_stack(profile->prefault_stack_size);
+  }
+
+  if (PlatformPosix_apply_thread_profile(&profile->scheduler) != LF_OK) {
+    ret = LF_ERR;
+  }
+  return ret;
+}
+
 void Platform_ctor(Platform* super) {
   PlatformPosix* self = (PlatformPosix*)super;
   super->get_physical_time = PlatformPosix_get_physical_time;
@@ -110,8 +374,33 @@ void Platform_ctor(Platform* super) {
   signal(SIGTERM, handle_signal);
   Mutex_ctor(&self->mutex.super);
 
+  self->new_async_event = false;
+  self->sleeping = 0;
+  self->spin_wait_threshold = PLATFORM_POSIX_SPIN_WAIT_THRESHOLD;
+  self->rt_profile = (RtProfilePosix)RT_PROFILE_POSIX_DEFAULT;
+
+#if defined(LF_LOG_DEFERRED)
+  static pthread_once_t log_flush_once = PTHREAD_ONCE_INIT;
+  validaten(pthread_once(&log_flush_once, start_log_flush_thread));
+#endif
+
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  self->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  self->timer_fd = timerfd_create(WAIT_CLOCK, TFD_NONBLOCK | TFD_CLOEXEC);
+  self->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  validate(self->epoll_fd >= 0 && self->timer_fd >= 0 && self->event_fd >= 0);
+  validate(PlatformPosix_register_fd(self, self->timer_fd) == LF_OK);
+  validate(PlatformPosix_register_fd(self, self->event_fd) == LF_OK);
+#endif
+
   // Initialize the condition variable used for sleeping.
-  validaten(pthread_cond_init(&self->cond, NULL));
+  pthread_condattr_t cond_attr;
+  validaten(pthread_condattr_init(&cond_attr));
+#if !defined(__APPLE__)
+  validaten(pthread_condattr_setclock(&cond_attr, WAIT_CLOCK));
+#endif
+  validaten(pthread_cond_init(&self->cond, &cond_attr));
+  validaten(pthread_condattr_destroy(&cond_attr));
 }
 
 Platform* Platform_new() { return &platform.super; }
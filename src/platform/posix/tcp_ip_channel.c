@@ -14,6 +14,10 @@
 #include <unistd.h>
 #include <pthread.h>
 
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+#include <poll.h>
+#endif
+
 // For native execution on Linux or macOS we also catch SIGPIPE signals
 #ifdef PLATFORM_POSIX
 #include <signal.h>
@@ -37,7 +41,9 @@
   LF_DEBUG(NET, "TcpIpChannel: [%s] " fmt, self->is_server ? "server" : "client", ##__VA_ARGS__)
 
 // Forward declarations
+#if !defined(PLATFORM_POSIX_EVENT_LOOP)
 static void* _TcpIpChannel_worker_thread(void* untyped_self);
+#endif
 
 static void _TcpIpChannel_update_state_locked(TcpIpChannel* self, NetworkChannelState new_state) {
 
@@ -78,6 +84,19 @@ static NetworkChannelState _TcpIpChannel_get_state(TcpIpChannel* self) {
   return state;
 }
 
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+/** @brief Stop waking up the scheduler for the sockets of the channel, which must be done before closing them. */
+static void _TcpIpChannel_unregister_sockets(TcpIpChannel* self) {
+  PlatformPosix* platform = (PlatformPosix*)_lf_environment->platform;
+  if (self->fd > 0) {
+    PlatformPosix_unregister_fd(platform, self->fd);
+  }
+  if (self->is_server && self->client > 0) {
+    PlatformPosix_unregister_fd(platform, self->client);
+  }
+}
+#endif
+
 static lf_ret_t _TcpIpChannel_reset_socket(TcpIpChannel* self) {
   FD_ZERO(&self->set);
   if (self->fd > 0) {
@@ -109,6 +128,14 @@ static lf_ret_t _TcpIpChannel_reset_socket(TcpIpChannel* self) {
     return LF_ERR;
   }
 
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  // The scheduler thread must never block on the socket.
+  if (fcntl(self->fd, F_SETFL, fcntl(self->fd, F_GETFL) | O_NONBLOCK) < 0) {
+    TCP_IP_CHANNEL_ERR("Error setting socket options: O_NONBLOCK errno=%d", errno);
+    return LF_ERR;
+  }
+#endif
+
   if (socketpair(AF_UNIX, SOCK_STREAM, 0, self->send_failed_event_fds) < 0) {
     TCP_IP_CHANNEL_ERR("Failed to initialize \"send_failed\" socketpair file descriptors");
     return LF_ERR;
@@ -117,6 +144,7 @@ static lf_ret_t _TcpIpChannel_reset_socket(TcpIpChannel* self) {
   return LF_OK;
 }
 
+#if !defined(PLATFORM_POSIX_EVENT_LOOP)
 static void _TcpIpChannel_spawn_worker_thread(TcpIpChannel* self) {
   int res;
   TCP_IP_CHANNEL_DEBUG("Spawning worker thread");
@@ -135,6 +163,7 @@ static void _TcpIpChannel_spawn_worker_thread(TcpIpChannel* self) {
     throw("pthread_create failed");
   }
 }
+#endif
 
 static lf_ret_t _TcpIpChannel_server_bind(TcpIpChannel* self) {
   struct sockaddr_in serv_addr;
@@ -280,14 +309,32 @@ static lf_ret_t TcpIpChannel_send_blocking(NetworkChannel* untyped_self, const F
         TCP_IP_CHANNEL_DEBUG("%d bytes sent", bytes_send);
 
         if (bytes_send < 0) {
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+          if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            // The socket is non-blocking and its buffer is full. The peer may be waiting for us to send before it
+            // reads again, so we wait for room only for a bounded time, and give up once the retries are used up.
+            TCP_IP_CHANNEL_DEBUG("Socket buffer is full, waiting for it to drain");
+            struct pollfd pfd = {.fd = socket, .events = POLLOUT, .revents = 0};
+            poll(&pfd, 1, (int)(TCP_IP_CHANNEL_SEND_POLL_TIMEOUT / MSEC(1)));
+            timeout--;
+            lf_ret = LF_ERR;
+            continue;
+          }
+#endif
           TCP_IP_CHANNEL_ERR("Write failed errno=%d", errno);
+          timeout--;
           switch (errno) {
           case ETIMEDOUT:
           case ENOTCONN: {
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+            // Sending happens on the scheduler thread, which also polls the channel.
+            _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_LOST_CONNECTION);
+#else
             ssize_t bytes_written = write(self->send_failed_event_fds[1], "X", 1);
             if (bytes_written == -1) {
               TCP_IP_CHANNEL_ERR("Failed informing worker thread, that send_blocking failed, errno=%d", errno);
             }
+#endif
             lf_ret = LF_ERR;
             break;
           }
@@ -374,7 +421,7 @@ static lf_ret_t _TcpIpChannel_receive(NetworkChannel* untyped_self, FederateMess
     }
   }
 
-  memcpy(self->read_buffer, self->read_buffer + (self->read_index - bytes_left), bytes_left);
+  memmove(self->read_buffer, self->read_buffer + (self->read_index - bytes_left), bytes_left);
   self->read_index = bytes_left;
 
   if (bytes_left > 0) {
@@ -392,6 +439,10 @@ static void TcpIpChannel_close_connection(NetworkChannel* untyped_self) {
     return;
   }
 
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  _TcpIpChannel_unregister_sockets(self);
+#endif
+
   if (self->is_server && self->client != 0) {
     if (close(self->client) < 0) {
       TCP_IP_CHANNEL_ERR("Error closing client socket %d", errno);
@@ -404,6 +455,94 @@ static void TcpIpChannel_close_connection(NetworkChannel* untyped_self) {
   _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_CLOSED);
 }
 
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+/** @brief Whether @p fd has any of @p events pending, without blocking. */
+static bool _TcpIpChannel_is_ready(int fd, short events) {
+  struct pollfd pfd = {.fd = fd, .events = events, .revents = 0};
+  return poll(&pfd, 1, 0) > 0;
+}
+
+/**
+ * @brief One step of the state machine of the worker thread, which never blocks. It is called by the scheduler thread,
+ * which wakes up when a registered socket becomes readable, so received messages are delivered inline. While the
+ * channel is not connected, it only makes progress when the scheduler polls it, e.g. while the startup coordinator
+ * waits for all neighbors to connect.
+ */
+static lf_ret_t TcpIpChannel_poll(NetworkChannel* untyped_self) {
+  TcpIpChannel* self = (TcpIpChannel*)untyped_self;
+  PlatformPosix* platform = (PlatformPosix*)_lf_environment->platform;
+  const NetworkChannelState state = _TcpIpChannel_get_state(self);
+  lf_ret_t ret;
+
+  switch (state) {
+  case NETWORK_CHANNEL_STATE_OPEN: {
+    if (self->is_server) {
+      if (_TcpIpChannel_server_bind(self) != LF_OK) {
+        _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_CONNECTION_FAILED);
+        break;
+      }
+      // The listening socket becomes readable when a client connects.
+      PlatformPosix_register_fd(platform, self->fd);
+      _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_CONNECTION_IN_PROGRESS);
+    } else {
+      _TcpIpChannel_try_connect_client(untyped_self);
+    }
+  } break;
+
+  case NETWORK_CHANNEL_STATE_CONNECTION_IN_PROGRESS: {
+    if (self->is_server) {
+      if (_TcpIpChannel_is_ready(self->fd, POLLIN)) {
+        PlatformPosix_unregister_fd(platform, self->fd);
+        _TcpIpChannel_try_connect_server(untyped_self);
+      }
+    } else if (_TcpIpChannel_is_ready(self->fd, POLLOUT)) {
+      // The non-blocking connect has completed, successfully or not.
+      int error = 0;
+      socklen_t len = sizeof(error);
+      if (getsockopt(self->fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0 && error == 0) {
+        TCP_IP_CHANNEL_INFO("Connected to server on %s:%d", self->host, self->port);
+        _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_CONNECTED);
+      } else {
+        _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_CONNECTION_FAILED);
+      }
+    }
+  } break;
+
+  case NETWORK_CHANNEL_STATE_LOST_CONNECTION:
+  case NETWORK_CHANNEL_STATE_CONNECTION_FAILED: {
+    _TcpIpChannel_unregister_sockets(self);
+    _TcpIpChannel_reset_socket(self);
+    _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_OPEN);
+  } break;
+
+  case NETWORK_CHANNEL_STATE_CONNECTED: {
+    ret = _TcpIpChannel_receive(untyped_self, &self->output);
+    if (ret == LF_NETWORK_CHANNEL_EMPTY) {
+      return LF_NETWORK_CHANNEL_EMPTY;
+    } else if (ret == LF_OK || ret == LF_NETWORK_CHANNEL_RETRY) {
+      validate(self->receive_callback);
+      self->receive_callback(self->federated_connection, &self->output);
+      return LF_NETWORK_CHANNEL_RETRY;
+    } else {
+      _TcpIpChannel_update_state(self, NETWORK_CHANNEL_STATE_LOST_CONNECTION);
+      return LF_ERR;
+    }
+  }
+
+  case NETWORK_CHANNEL_STATE_UNINITIALIZED:
+  case NETWORK_CHANNEL_STATE_CLOSED:
+    break;
+  }
+
+  // From now on, data on the connection wakes up the scheduler. Accepted sockets do not inherit O_NONBLOCK.
+  if (_TcpIpChannel_get_state(self) == NETWORK_CHANNEL_STATE_CONNECTED) {
+    int socket = self->is_server ? self->client : self->fd;
+    fcntl(socket, F_SETFL, fcntl(socket, F_GETFL) | O_NONBLOCK);
+    PlatformPosix_register_fd(platform, socket);
+  }
+  return LF_NETWORK_CHANNEL_EMPTY;
+}
+#else
 /**
  * @brief Main loop of the TcpIpChannel.
  */
@@ -414,6 +553,11 @@ static void* _TcpIpChannel_worker_thread(void* untyped_self) {
 
   TCP_IP_CHANNEL_DEBUG("Starting worker thread");
 
+#ifdef PLATFORM_POSIX
+  // The stack of the thread is static and has been zeroed before spawning it, so there is nothing to prefault.
+  PlatformPosix_apply_thread_profile(&((PlatformPosix*)_lf_environment->platform)->rt_profile.channel);
+#endif
+
   while (true) {
     // Check if we have any pending cancel requests from the runtime.
     pthread_testcancel();
@@ -511,6 +655,7 @@ static void* _TcpIpChannel_worker_thread(void* untyped_self) {
   TCP_IP_CHANNEL_INFO("Worker thread terminates");
   return NULL;
 }
+#endif
 
 static void TcpIpChannel_register_receive_callback(NetworkChannel* untyped_self,
                                                    void (*receive_callback)(FederatedConnectionBundle* conn,
@@ -524,8 +669,13 @@ static void TcpIpChannel_register_receive_callback(NetworkChannel* untyped_self,
 
 static void TcpIpChannel_free(NetworkChannel* untyped_self) {
   TcpIpChannel* self = (TcpIpChannel*)untyped_self;
-  int err = 0;
   TCP_IP_CHANNEL_DEBUG("Free");
+
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  // There is no worker thread, the sockets are unregistered from the event loop when the connection is closed.
+  self->super.close_connection((NetworkChannel*)self);
+#else
+  int err = 0;
   validate(self->worker_thread != 0);
 
   // The order in which we do the operations is important. We want to cancel and stop the thread before we close the
@@ -556,6 +706,7 @@ static void TcpIpChannel_free(NetworkChannel* untyped_self) {
   if (err != 0) {
     TCP_IP_CHANNEL_ERR("Error destroying pthread attr %d", err);
   }
+#endif
 
   pthread_mutex_destroy(&self->mutex);
 }
@@ -596,12 +747,18 @@ void TcpIpChannel_ctor(TcpIpChannel* self, const char* host, unsigned short port
   self->super.free = TcpIpChannel_free;
   self->super.expected_connect_duration = TCP_IP_CHANNEL_EXPECTED_CONNECT_DURATION; // Needed for Zephyr
   self->super.type = NETWORK_CHANNEL_TYPE_TCP_IP;
-  self->super.mode = NETWORK_CHANNEL_MODE_ASYNC;
   self->receive_callback = NULL;
   self->federated_connection = NULL;
-  self->worker_thread = 0;
   self->has_warned_about_connection_failure = false;
 
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  self->super.mode = NETWORK_CHANNEL_MODE_POLLED;
+  self->polled.poll = TcpIpChannel_poll;
+  _TcpIpChannel_reset_socket(self);
+#else
+  self->super.mode = NETWORK_CHANNEL_MODE_ASYNC;
+  self->worker_thread = 0;
   _TcpIpChannel_reset_socket(self);
   _TcpIpChannel_spawn_worker_thread(self);
+#endif
 }
@@ -2,6 +2,7 @@
 #include "reactor-uc/environment.h"
 #include "reactor-uc/logging.h"
 #include "reactor-uc/scheduler.h"
+#include "reactor-uc/token.h"
 #include <assert.h>
 #include <string.h>
 
@@ -27,16 +28,54 @@ void Port_prepare(Trigger* _self, Event* event) {
   }
 }
 
-void Port_set(Port* self, const void* value) {
-  if (self->effects.size > 0 || self->observers.size > 0) {
-    if (self->value_size > 0) {
-      memcpy(self->value_ptr, value, self->value_size);
+void Port_store_value(Port* self, const void* value) {
+  if (self->holds_tokens) {
+    Token_assign((Token**)self->value_ptr, *(Token* const*)value);
+  } else if (self->value_size > 0) {
+    memcpy(self->value_ptr, value, self->value_size);
+  }
+}
+
+/**
+ * @brief Write a value into every record of the fan-out table of a port. Does the same as walking the connection graph
+ * with LogicalConnection_trigger_downstreams, in the same order.
+ */
+static void Port_trigger_fanout(Port* self, const void* value) {
+  Scheduler* sched = self->super.parent->env->scheduler;
+  tag_t tag = sched->current_tag(sched);
+  for (size_t i = 0; i < self->fanout_size; i++) {
+    const FanoutRecord* record = &self->fanout[i];
+    Port* down = record->port;
+    if (down == NULL) {
+      record->conn->trigger_downstreams(record->conn, tag, value, self->value_size);
+      continue;
     }
+
+    if (!down->is_alias) {
+      Port_store_value(down, value);
+    }
+    if (!down->super.is_present) {
+      down->super.prepare(&down->super, NULL);
+      down->intended_tag = tag;
+    }
+  }
+}
+
+void Port_set(Port* self, const void* value) {
+  // A port holding tokens always keeps a reference until the end of the tag, so that a token which nobody reads
+  // returns to its pool.
+  if (self->effects.size > 0 || self->observers.size > 0 || self->holds_tokens || self->has_aliases) {
+    Port_store_value(self, value);
     if (!self->super.is_present) {
       Port_prepare(&self->super, NULL);
     }
   }
 
+  if (self->fanout != NULL) {
+    Port_trigger_fanout(self, value);
+    return;
+  }
+
   for (size_t i = 0; i < self->conns_out_registered; i++) {
     Connection* conn = self->conns_out[i];
     const Environment* env = self->super.parent->env;
@@ -49,6 +88,91 @@ void Port_cleanup(Trigger* _self) {
   assert(_self->is_registered_for_cleanup);
   LF_DEBUG(TRIG, "Cleaning up port %p", _self);
   _self->is_present = false;
+  Port* self = (Port*)_self;
+  if (self->holds_tokens) {
+    Token_assign((Token**)self->value_ptr, NULL);
+  }
+}
+
+void Port_enable_tokens(Port* self) {
+  validate(self->value_size == sizeof(Token*));
+  self->holds_tokens = true;
+  *(Token**)self->value_ptr = NULL;
+}
+
+void Port_resolve_alias(Port* self) {
+  if (self->super.type != TRIG_INPUT || self->holds_tokens || self->value_size == 0) {
+    return;
+  }
+
+  // Walk upstream as long as the connections are aliasing logical connections. Any other connection, e.g. a delayed or
+  // federated one, writes a copy of the value into the port at the end of it, so the walk stops there.
+  Port* upstream = self;
+  while (upstream->conn_in != NULL) {
+    Connection* conn = upstream->conn_in;
+    if (conn->super.type != TRIG_CONN || !((LogicalConnection*)conn)->aliasing) {
+      return;
+    }
+    upstream = conn->upstream;
+  }
+
+  if (upstream->super.type != TRIG_OUTPUT || upstream->holds_tokens) {
+    return;
+  }
+
+  validate(upstream->value_size == self->value_size);
+  LF_DEBUG(CONN, "Input %p aliases the buffer of output %p", self, upstream);
+  self->value_ptr = upstream->value_ptr;
+  self->is_alias = true;
+  upstream->has_aliases = true;
+}
+
+/**
+ * @brief Append the downstreams of a port to a fan-out table, in the order in which they are visited by
+ * LogicalConnection_trigger_downstreams. Returns false if the table is too small.
+ */
+static bool Port_append_fanout(const Port* self, FanoutRecord* records, size_t records_size, size_t* size) {
+  for (size_t i = 0; i < self->conns_out_registered; i++) {
+    Connection* conn = self->conns_out[i];
+    if (conn->super.type != TRIG_CONN) {
+      if (*size == records_size) {
+        return false;
+      }
+      records[(*size)++] = (FanoutRecord){.port = NULL, .conn = conn};
+      continue;
+    }
+
+    for (size_t j = 0; j < conn->downstreams_registered; j++) {
+      Port* down = conn->downstreams[j];
+      if (down->effects.size > 0 || down->observers.size > 0) {
+        validate(down->value_size == self->value_size);
+        if (*size == records_size) {
+          return false;
+        }
+        records[(*size)++] = (FanoutRecord){.port = down, .conn = NULL};
+      }
+      if (!Port_append_fanout(down, records, records_size, size)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+size_t Port_calculate_fanout(Port* self, FanoutRecord* records, size_t records_size) {
+  // Only ports at the start of the connection graph are written by reactions, the others are written through it.
+  if (self->conn_in != NULL || self->conns_out_registered == 0) {
+    return 0;
+  }
+
+  size_t size = 0;
+  if (!Port_append_fanout(self, records, records_size, &size)) {
+    LF_WARN(CONN, "Fan-out table of port %p does not fit, %zu records left", self, records_size);
+    return 0;
+  }
+  self->fanout = records;
+  self->fanout_size = size;
+  return size;
 }
 
 void Port_ctor(Port* self, TriggerType type, Reactor* parent, void* value_ptr, size_t value_size, Reaction** effects,
@@ -60,6 +184,11 @@ void Port_ctor(Port* self, TriggerType type, Reactor* parent, void* value_ptr, s
   self->conns_out = conns_out;
   self->conns_out_size = conns_out_size;
   self->conns_out_registered = 0;
+  self->holds_tokens = false;
+  self->is_alias = false;
+  self->has_aliases = false;
+  self->fanout = NULL;
+  self->fanout_size = 0;
   self->sources.reactions = sources;
   self->sources.size = sources_size;
   self->sources.num_registered = 0;
@@ -1,10 +1,10 @@
 #include "reactor-uc/queues.h"
 #include "assert.h"
 #include "reactor-uc/logging.h"
+#include "reactor-uc/timer.h"
+#include <stddef.h>
 #include <string.h>
 
-#define ACCESS(arr, size, row, col) (arr)[(row) * (size) + (col)]
-
 /**
  * @brief Return the index of the left child of a node in a binary heap.
  * @param parent_idx Index of the parent node.
@@ -26,10 +26,124 @@ static inline size_t rchild_idx(size_t parent_idx) { return lchild_idx(parent_id
  */
 static inline size_t parent_idx(size_t child_idx) { return (child_idx - 1) / 2; }
 
-static void swap(ArbitraryEvent* ev1, ArbitraryEvent* ev2) {
-  ArbitraryEvent temp = *ev2;
-  *ev2 = *ev1;
-  *ev1 = temp;
+/**
+ * @brief Return the number of bytes to copy for an event of type @p type, or 0 if the type is unknown.
+ */
+static size_t event_type_size(EventType type) {
+  switch (type) {
+  case EVENT:
+    return sizeof(Event);
+  case SYSTEM_EVENT:
+    return sizeof(SystemEvent);
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Return the trigger or system event handler that identifies an event in the index.
+ */
+static inline const void* index_key_ptr(ArbitraryEvent* event) {
+  if (event->event.super.type == EVENT) {
+    return event->event.trigger;
+  }
+  return event->system_event.handler;
+}
+
+/**
+ * @brief Return the home slot of an event in the index, derived from its trigger (or handler) and its tag.
+ */
+static size_t index_home_slot(EventQueue* self, ArbitraryEvent* event) {
+  tag_t tag = get_tag(event);
+  uint64_t h = (uint64_t)(uintptr_t)index_key_ptr(event);
+  h ^= (uint64_t)tag.time * 0x9E3779B97F4A7C15ULL;
+  h ^= (uint64_t)tag.microstep * 0xC2B2AE3D27D4EB4FULL;
+  h ^= h >> 31;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 29;
+  // Map the hash onto [0, index_capacity) with a multiply-shift instead of a division.
+  return (size_t)(((h >> 32) * (uint64_t)self->index_capacity) >> 32);
+}
+
+/** @brief Return the slot following @p slot in the probe sequence. */
+static inline size_t index_next_slot(EventQueue* self, size_t slot) {
+  return slot + 1 == self->index_capacity ? 0 : slot + 1;
+}
+
+/** @brief Record the event at heap position @p idx in the index. */
+static void index_insert(EventQueue* self, size_t idx) {
+  size_t slot = index_home_slot(self, &self->array[idx]);
+  while (self->index[slot] != 0) {
+    slot = index_next_slot(self, slot);
+  }
+  // Slots store heap position + 1 so that 0 can mark an empty slot.
+  self->index[slot] = idx + 1;
+  self->index_pos[idx] = slot;
+}
+
+/**
+ * @brief Drop the event at heap position @p idx from the index. The event must still be stored at @p idx, since its
+ * key is needed to close the gap left in the probe sequence (backward-shift deletion).
+ */
+static void index_erase(EventQueue* self, size_t idx) {
+  size_t hole = self->index_pos[idx];
+  size_t slot = hole;
+  self->index[hole] = 0;
+  while (true) {
+    slot = index_next_slot(self, slot);
+    if (self->index[slot] == 0) {
+      break;
+    }
+    size_t home = index_home_slot(self, &self->array[self->index[slot] - 1]);
+    // Leave the entry where it is if its home lies cyclically within (hole, slot].
+    bool reachable = hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+    if (reachable) {
+      continue;
+    }
+    self->index[hole] = self->index[slot];
+    self->index_pos[self->index[hole] - 1] = hole;
+    self->index[slot] = 0;
+    hole = slot;
+  }
+}
+
+/** @brief Clear the index and re-insert every event in the heap. */
+static void index_rebuild(EventQueue* self) {
+  for (size_t i = 0; i < self->index_capacity; i++) {
+    self->index[i] = 0;
+  }
+  for (size_t i = 0; i < self->size; i++) {
+    index_insert(self, i);
+  }
+}
+
+/** @brief Return the heap position of an event equal to @p event, or -1, using the index. */
+static int index_find(EventQueue* self, ArbitraryEvent* event, bool (*match_fn)(ArbitraryEvent*, ArbitraryEvent*)) {
+  size_t slot = index_home_slot(self, event);
+  while (self->index[slot] != 0) {
+    size_t idx = self->index[slot] - 1;
+    if (match_fn(&self->array[idx], event)) {
+      return (int)idx;
+    }
+    slot = index_next_slot(self, slot);
+  }
+  return -1;
+}
+
+/** @brief Swap the events at heap positions @p i and @p j, keeping the index in sync. */
+static void swap(EventQueue* self, size_t i, size_t j) {
+  ArbitraryEvent temp = self->array[j];
+  self->array[j] = self->array[i];
+  self->array[i] = temp;
+
+  if (self->index != NULL) {
+    size_t slot_i = self->index_pos[i];
+    size_t slot_j = self->index_pos[j];
+    self->index_pos[i] = slot_j;
+    self->index_pos[j] = slot_i;
+    self->index[slot_j] = i + 1;
+    self->index[slot_i] = j + 1;
+  }
 }
 
 static tag_t EventQueue_next_tag(EventQueue* self) {
@@ -51,15 +165,8 @@ static lf_ret_t EventQueue_insert(EventQueue* self, AbstractEvent* event) {
     return LF_EVENT_QUEUE_FULL;
   }
 
-  size_t event_size;
-  switch (event->type) {
-  case EVENT:
-    event_size = sizeof(Event);
-    break;
-  case SYSTEM_EVENT:
-    event_size = sizeof(SystemEvent);
-    break;
-  default:
+  size_t event_size = event_type_size(event->type);
+  if (event_size == 0) {
     LF_ERR(QUEUE, "Unknown event type %d", event->type);
     MUTEX_UNLOCK(self->mutex);
     return LF_ERR;
@@ -68,6 +175,9 @@ static lf_ret_t EventQueue_insert(EventQueue* self, AbstractEvent* event) {
   memcpy(&self->array[self->size], event, event_size);
 
   size_t idx = self->size++;
+  if (self->index != NULL) {
+    index_insert(self, idx);
+  }
   tag_t event_tag = get_tag(&self->array[idx]);
 
   // Bubble up the newly added event
@@ -76,7 +186,7 @@ static lf_ret_t EventQueue_insert(EventQueue* self, AbstractEvent* event) {
     if (lf_tag_compare(event_tag, get_tag(&self->array[p_idx])) >= 0) {
       break;
     }
-    swap(&self->array[idx], &self->array[p_idx]);
+    swap(self, idx, p_idx);
     idx = p_idx;
   };
 
@@ -85,6 +195,9 @@ static lf_ret_t EventQueue_insert(EventQueue* self, AbstractEvent* event) {
 }
 
 static void EventQueue_build_heap(EventQueue* self) {
+  if (self->index != NULL) {
+    index_rebuild(self);
+  }
   for (int i = (self->size / 2) - 1; i >= 0; i--) {
     self->heapify(self, i);
   }
@@ -107,7 +220,7 @@ static void EventQueue_heapify(EventQueue* self, size_t idx) {
     if (smallest == idx) {
       break;
     }
-    swap(&self->array[idx], &self->array[smallest]);
+    swap(self, idx, smallest);
     idx = smallest;
   }
 }
@@ -125,12 +238,16 @@ static int find_matching_event_idx(EventQueue* self, AbstractEvent* event,
 }
 
 static int find_equal_same_tag_idx(EventQueue* self, AbstractEvent* event) {
-  if (event->type == EVENT) {
-    return find_matching_event_idx(self, event, events_same_tag_and_trigger);
+  bool (*match_fn)(ArbitraryEvent*, ArbitraryEvent*) = events_same_tag_and_trigger;
+  if (event->type != EVENT) {
+    validate(event->type == SYSTEM_EVENT);
+    match_fn = events_same_tag_and_handler;
   }
 
-  validate(event->type == SYSTEM_EVENT);
-  return find_matching_event_idx(self, event, events_same_tag_and_handler);
+  if (self->index != NULL) {
+    return index_find(self, (ArbitraryEvent*)event, match_fn);
+  }
+  return find_matching_event_idx(self, event, match_fn);
 }
 
 static ArbitraryEvent* EventQueue_find_equal_same_tag(EventQueue* self, AbstractEvent* event) {
@@ -153,7 +270,7 @@ static void sift_up(EventQueue* self, size_t idx) {
     if (lf_tag_compare(get_tag(&self->array[idx]), get_tag(&self->array[p_idx])) >= 0) {
       break;
     }
-    swap(&self->array[idx], &self->array[p_idx]);
+    swap(self, idx, p_idx);
     idx = p_idx;
   }
 }
@@ -167,7 +284,10 @@ static lf_ret_t EventQueue_remove(EventQueue* self, AbstractEvent* event) {
     return LF_EVENT_NOT_FOUND;
   }
 
-  swap(&self->array[event_idx], &self->array[self->size - 1]);
+  swap(self, event_idx, self->size - 1);
+  if (self->index != NULL) {
+    index_erase(self, self->size - 1);
+  }
   self->size--;
 
   // The relocated element may violate the heap in either direction/
@@ -189,19 +309,15 @@ static lf_ret_t EventQueue_pop(EventQueue* self, AbstractEvent* event) {
   }
 
   ArbitraryEvent ret = self->array[0];
-  swap(&self->array[0], &self->array[self->size - 1]);
+  swap(self, 0, self->size - 1);
+  if (self->index != NULL) {
+    index_erase(self, self->size - 1);
+  }
   self->size--;
   self->heapify(self, 0);
 
-  size_t event_size;
-  switch (ret.event.super.type) {
-  case EVENT:
-    event_size = sizeof(Event);
-    break;
-  case SYSTEM_EVENT:
-    event_size = sizeof(SystemEvent);
-    break;
-  default:
+  size_t event_size = event_type_size(ret.event.super.type);
+  if (event_size == 0) {
     LF_ERR(QUEUE, "Unknown event type %d", ret.event.super.type);
     MUTEX_UNLOCK(self->mutex);
     return LF_ERR;
@@ -212,11 +328,28 @@ static lf_ret_t EventQueue_pop(EventQueue* self, AbstractEvent* event) {
   return LF_OK;
 }
 
+static size_t EventQueue_pop_all_at_tag(EventQueue* self, tag_t tag, ArbitraryEvent* events, size_t max) {
+  MUTEX_LOCK(self->mutex);
+  size_t cnt = 0;
+  while (cnt < max && self->size > 0 && lf_tag_compare(get_tag(&self->array[0]), tag) == 0) {
+    events[cnt++] = self->array[0];
+    swap(self, 0, self->size - 1);
+    if (self->index != NULL) {
+      index_erase(self, self->size - 1);
+    }
+    self->size--;
+    self->heapify(self, 0);
+  }
+  MUTEX_UNLOCK(self->mutex);
+  return cnt;
+}
+
 static bool EventQueue_empty(EventQueue* self) { return self->size == 0; }
 
 void EventQueue_ctor(EventQueue* self, ArbitraryEvent* array, size_t capacity) {
   self->insert = EventQueue_insert;
   self->pop = EventQueue_pop;
+  self->pop_all_at_tag = EventQueue_pop_all_at_tag;
   self->empty = EventQueue_empty;
   self->build_heap = EventQueue_build_heap;
   self->heapify = EventQueue_heapify;
@@ -226,9 +359,714 @@ void EventQueue_ctor(EventQueue* self, ArbitraryEvent* array, size_t capacity) {
   self->size = 0;
   self->capacity = capacity;
   self->array = array;
+  self->index = NULL;
+  self->index_pos = NULL;
+  self->index_capacity = 0;
   Mutex_ctor(&self->mutex.super);
 }
 
+void EventQueue_ctor_indexed(EventQueue* self, ArbitraryEvent* array, size_t capacity, size_t* index,
+                             size_t* index_pos, size_t index_capacity) {
+  EventQueue_ctor(self, array, capacity);
+  if (index_capacity == 0) {
+    return;
+  }
+  // Linear probing needs at least one free slot to terminate a lookup.
+  validate(index_capacity > capacity);
+  self->index = index;
+  self->index_pos = index_pos;
+  self->index_capacity = index_capacity;
+  index_rebuild(self);
+}
+
+#define DARY_FIRST_CHILD(idx) (((idx) * EVENT_QUEUE_DARY_ARITY) + 1)
+#define DARY_PARENT(idx) (((idx) - 1) / EVENT_QUEUE_DARY_ARITY)
+
+/** @brief Place the event body @p body with key @p key at heap position @p pos. */
+static inline void DaryEventQueue_place(DaryEventQueue* self, size_t pos, tag_t key, size_t body) {
+  self->keys[pos] = key;
+  self->heap[pos] = body;
+  self->heap_pos[body] = pos;
+}
+
+/** @brief Move the entry at heap position @p pos up until its parent is not later. Returns its final position. */
+static size_t DaryEventQueue_sift_up(DaryEventQueue* self, size_t pos) {
+  tag_t key = self->keys[pos];
+  size_t body = self->heap[pos];
+  while (pos > 0) {
+    size_t p_pos = DARY_PARENT(pos);
+    if (lf_tag_compare(key, self->keys[p_pos]) >= 0) {
+      break;
+    }
+    DaryEventQueue_place(self, pos, self->keys[p_pos], self->heap[p_pos]);
+    pos = p_pos;
+  }
+  DaryEventQueue_place(self, pos, key, body);
+  return pos;
+}
+
+/** @brief Move the entry at heap position @p pos down until no child is earlier. */
+static void DaryEventQueue_sift_down(DaryEventQueue* self, size_t pos) {
+  size_t size = self->super.size;
+  tag_t key = self->keys[pos];
+  size_t body = self->heap[pos];
+  while (true) {
+    size_t first = DARY_FIRST_CHILD(pos);
+    if (first >= size) {
+      break;
+    }
+    size_t last = first + EVENT_QUEUE_DARY_ARITY;
+    if (last > size) {
+      last = size;
+    }
+    size_t smallest = first;
+    for (size_t child = first + 1; child < last; child++) {
+      if (lf_tag_compare(self->keys[child], self->keys[smallest]) < 0) {
+        smallest = child;
+      }
+    }
+    if (lf_tag_compare(self->keys[smallest], key) >= 0) {
+      break;
+    }
+    DaryEventQueue_place(self, pos, self->keys[smallest], self->heap[smallest]);
+    pos = smallest;
+  }
+  DaryEventQueue_place(self, pos, key, body);
+}
+
+/** @brief Remove the event at heap position @p pos and keep the event bodies compact. */
+static void DaryEventQueue_remove_at(DaryEventQueue* self, size_t pos) {
+  EventQueue* super = &self->super;
+  size_t body = self->heap[pos];
+  size_t last = --super->size;
+
+  if (pos < last) {
+    DaryEventQueue_place(self, pos, self->keys[last], self->heap[last]);
+    if (DaryEventQueue_sift_up(self, pos) == pos) {
+      DaryEventQueue_sift_down(self, pos);
+    }
+  }
+
+  if (super->index != NULL) {
+    index_erase(super, body);
+  }
+
+  // Fill the hole in the body array with the last body so that bodies always occupy [0, size).
+  if (body != last) {
+    super->array[body] = super->array[last];
+    self->heap[self->heap_pos[last]] = body;
+    self->heap_pos[body] = self->heap_pos[last];
+    if (super->index != NULL) {
+      super->index_pos[body] = super->index_pos[last];
+      super->index[super->index_pos[body]] = body + 1;
+    }
+  }
+}
+
+static tag_t DaryEventQueue_next_tag(EventQueue* super) {
+  DaryEventQueue* self = (DaryEventQueue*)super;
+  MUTEX_LOCK(super->mutex);
+  tag_t ret = FOREVER_TAG;
+  if (super->size > 0) {
+    ret = self->keys[0];
+  }
+  MUTEX_UNLOCK(super->mutex);
+  return ret;
+}
+
+static lf_ret_t DaryEventQueue_insert(EventQueue* super, AbstractEvent* event) {
+  DaryEventQueue* self = (DaryEventQueue*)super;
+  LF_DEBUG(QUEUE, "Inserting event with tag " PRINTF_TAG " into DaryEventQueue", event->tag);
+  MUTEX_LOCK(super->mutex);
+  if (super->size >= super->capacity) {
+    LF_ERR(QUEUE, "EventQueue is full has size %d", super->size);
+    MUTEX_UNLOCK(super->mutex);
+    return LF_EVENT_QUEUE_FULL;
+  }
+
+  size_t event_size = event_type_size(event->type);
+  if (event_size == 0) {
+    LF_ERR(QUEUE, "Unknown event type %d", event->type);
+    MUTEX_UNLOCK(super->mutex);
+    return LF_ERR;
+  }
+
+  size_t pos = super->size++;
+  memcpy(&super->array[pos], event, event_size);
+  if (super->index != NULL) {
+    index_insert(super, pos);
+  }
+  DaryEventQueue_place(self, pos, event->tag, pos);
+  DaryEventQueue_sift_up(self, pos);
+
+  MUTEX_UNLOCK(super->mutex);
+  return LF_OK;
+}
+
+static lf_ret_t DaryEventQueue_pop(EventQueue* super, AbstractEvent* event) {
+  DaryEventQueue* self = (DaryEventQueue*)super;
+  LF_DEBUG(QUEUE, "Popping event from DaryEventQueue");
+  MUTEX_LOCK(super->mutex);
+  if (super->size == 0) {
+    LF_ERR(QUEUE, "EventQueue is empty");
+    MUTEX_UNLOCK(super->mutex);
+    return LF_EVENT_QUEUE_EMPTY;
+  }
+
+  ArbitraryEvent* head = &super->array[self->heap[0]];
+  size_t event_size = event_type_size(head->event.super.type);
+  if (event_size == 0) {
+    LF_ERR(QUEUE, "Unknown event type %d", head->event.super.type);
+    MUTEX_UNLOCK(super->mutex);
+    return LF_ERR;
+  }
+  memcpy(event, head, event_size);
+  DaryEventQueue_remove_at(self, 0);
+
+  MUTEX_UNLOCK(super->mutex);
+  return LF_OK;
+}
+
+static size_t DaryEventQueue_pop_all_at_tag(EventQueue* super, tag_t tag, ArbitraryEvent* events, size_t max) {
+  DaryEventQueue* self = (DaryEventQueue*)super;
+  MUTEX_LOCK(super->mutex);
+  size_t cnt = 0;
+  while (cnt < max && super->size > 0 && lf_tag_compare(self->keys[0], tag) == 0) {
+    events[cnt++] = super->array[self->heap[0]];
+    DaryEventQueue_remove_at(self, 0);
+  }
+  MUTEX_UNLOCK(super->mutex);
+  return cnt;
+}
+
+static void DaryEventQueue_build_heap(EventQueue* super) {
+  DaryEventQueue* self = (DaryEventQueue*)super;
+  for (size_t i = 0; i < super->size; i++) {
+    DaryEventQueue_place(self, i, get_tag(&super->array[i]), i);
+  }
+  if (super->index != NULL) {
+    index_rebuild(super);
+  }
+  if (super->size < 2) {
+    return;
+  }
+  // Sift down every inner node, starting from the parent of the last element.
+  for (size_t i = DARY_PARENT(super->size - 1) + 1; i > 0; i--) {
+    DaryEventQueue_sift_down(self, i - 1);
+  }
+}
+
+static void DaryEventQueue_heapify(EventQueue* super, size_t idx) {
+  DaryEventQueue* self = (DaryEventQueue*)super;
+  LF_DEBUG(QUEUE, "Heapifying DaryEventQueue, starting at index %d", idx);
+  if (idx >= super->size) {
+    return;
+  }
+  self->keys[idx] = get_tag(&super->array[self->heap[idx]]);
+  DaryEventQueue_sift_down(self, idx);
+}
+
+static ArbitraryEvent* DaryEventQueue_find_equal_same_tag(EventQueue* super, AbstractEvent* event) {
+  MUTEX_LOCK(super->mutex);
+  int body = find_equal_same_tag_idx(super, event);
+  ArbitraryEvent* found = NULL;
+
+  if (body >= 0) {
+    found = &super->array[body];
+  }
+
+  MUTEX_UNLOCK(super->mutex);
+  return found;
+}
+
+static lf_ret_t DaryEventQueue_remove(EventQueue* super, AbstractEvent* event) {
+  DaryEventQueue* self = (DaryEventQueue*)super;
+  MUTEX_LOCK(super->mutex);
+  int body = find_equal_same_tag_idx(super, event);
+
+  if (body < 0) {
+    MUTEX_UNLOCK(super->mutex);
+    return LF_EVENT_NOT_FOUND;
+  }
+
+  DaryEventQueue_remove_at(self, self->heap_pos[body]);
+  MUTEX_UNLOCK(super->mutex);
+  return LF_OK;
+}
+
+void DaryEventQueue_ctor(DaryEventQueue* self, ArbitraryEvent* array, size_t capacity, tag_t* keys, size_t* heap,
+                         size_t* heap_pos, size_t* index, size_t* index_pos, size_t index_capacity) {
+  EventQueue_ctor_indexed(&self->super, array, capacity, index, index_pos, index_capacity);
+  self->super.insert = DaryEventQueue_insert;
+  self->super.pop = DaryEventQueue_pop;
+  self->super.pop_all_at_tag = DaryEventQueue_pop_all_at_tag;
+  self->super.build_heap = DaryEventQueue_build_heap;
+  self->super.heapify = DaryEventQueue_heapify;
+  self->super.find_equal_same_tag = DaryEventQueue_find_equal_same_tag;
+  self->super.remove = DaryEventQueue_remove;
+  self->super.next_tag = DaryEventQueue_next_tag;
+  self->keys = keys;
+  self->heap = heap;
+  self->heap_pos = heap_pos;
+}
+
+#define RADIX_NIL SIZE_MAX
+
+/** @brief Return the index of the most significant set bit of @p x, which must be non-zero. */
+static inline int msb_index32(uint32_t x) {
+#if defined(__GNUC__)
+  return 31 - __builtin_clz(x);
+#else
+  int idx = 0;
+  while (x >>= 1) {
+    idx++;
+  }
+  return idx;
+#endif
+}
+
+/** @brief Return the index of the least significant set bit of @p x, which must be non-zero. */
+static inline int lsb_index32(uint32_t x) {
+#if defined(__GNUC__)
+  return __builtin_ctz(x);
+#else
+  int idx = 0;
+  while ((x & 1u) == 0) {
+    x >>= 1;
+    idx++;
+  }
+  return idx;
+#endif
+}
+
+/** @brief Return the index of the most significant set bit of @p x, which must be non-zero. */
+static inline int msb_index64(uint64_t x) {
+  if ((x >> 32) != 0) {
+    return 32 + msb_index32((uint32_t)(x >> 32));
+  }
+  return msb_index32((uint32_t)x);
+}
+
+/**
+ * @brief Return the bucket for @p tag relative to @p last, i.e. 0 if they are equal and otherwise one plus the index
+ * of the highest bit in which the 96-bit keys (time with flipped sign bit, microstep) differ.
+ */
+static uint8_t radix_bucket_of(tag_t last, tag_t tag) {
+  uint64_t time_diff = (uint64_t)tag.time ^ (uint64_t)last.time;
+  if (time_diff != 0) {
+    return (uint8_t)(33 + msb_index64(time_diff));
+  }
+  uint32_t microstep_diff = (uint32_t)(tag.microstep ^ last.microstep);
+  if (microstep_diff != 0) {
+    return (uint8_t)(1 + msb_index32(microstep_diff));
+  }
+  return 0;
+}
+
+/** @brief Add the body at @p body to the bucket matching its tag. */
+static void RadixEventQueue_link(RadixEventQueue* self, size_t body) {
+  uint8_t b = radix_bucket_of(self->last, get_tag(&self->super.array[body]));
+  self->bucket[body] = b;
+  self->prev[body] = RADIX_NIL;
+  self->next[body] = self->head[b];
+  if (self->head[b] != RADIX_NIL) {
+    self->prev[self->head[b]] = body;
+  }
+  self->head[b] = body;
+  self->nonempty[b / 32] |= (uint32_t)1 << (b % 32);
+}
+
+/** @brief Take the body at @p body out of its bucket. */
+static void RadixEventQueue_unlink(RadixEventQueue* self, size_t body) {
+  uint8_t b = self->bucket[body];
+  if (self->prev[body] != RADIX_NIL) {
+    self->next[self->prev[body]] = self->next[body];
+  } else {
+    self->head[b] = self->next[body];
+    if (self->head[b] == RADIX_NIL) {
+      self->nonempty[b / 32] &= ~((uint32_t)1 << (b % 32));
+    }
+  }
+  if (self->next[body] != RADIX_NIL) {
+    self->prev[self->next[body]] = self->prev[body];
+  }
+}
+
+/** @brief Lower `last` to @p last and re-bucket every event. O(n), only needed for non-monotone inserts. */
+static void RadixEventQueue_rebase(RadixEventQueue* self, tag_t last) {
+  self->last = last;
+  for (size_t b = 0; b < RADIX_EVENT_QUEUE_NUM_BUCKETS; b++) {
+    self->head[b] = RADIX_NIL;
+  }
+  for (size_t i = 0; i < sizeof(self->nonempty) / sizeof(self->nonempty[0]); i++) {
+    self->nonempty[i] = 0;
+  }
+  for (size_t body = 0; body < self->super.size; body++) {
+    RadixEventQueue_link(self, body);
+  }
+}
+
+/**
+ * @brief Make sure that bucket 0 holds the earliest events, by advancing `last` to the smallest tag in the lowest
+ * non-empty bucket and redistributing that bucket.
+ */
+static void RadixEventQueue_settle(RadixEventQueue* self) {
+  if (self->super.size == 0 || self->head[0] != RADIX_NIL) {
+    return;
+  }
+
+  size_t b = 0;
+  for (size_t i = 0; i < sizeof(self->nonempty) / sizeof(self->nonempty[0]); i++) {
+    if (self->nonempty[i] != 0) {
+      b = i * 32 + (size_t)lsb_index32(self->nonempty[i]);
+      break;
+    }
+  }
+  validate(b > 0);
+
+  size_t body = self->head[b];
+  tag_t min = get_tag(&self->super.array[body]);
+  for (body = self->next[body]; body != RADIX_NIL; body = self->next[body]) {
+    tag_t tag = get_tag(&self->super.array[body]);
+    if (lf_tag_compare(tag, min) < 0) {
+      min = tag;
+    }
+  }
+
+  self->last = min;
+  body = self->head[b];
+  self->head[b] = RADIX_NIL;
+  self->nonempty[b / 32] &= ~((uint32_t)1 << (b % 32));
+  while (body != RADIX_NIL) {
+    size_t next = self->next[body];
+    RadixEventQueue_link(self, body);
+    body = next;
+  }
+}
+
+/** @brief Remove the event at body position @p body and keep the event bodies compact. */
+static void RadixEventQueue_remove_body(RadixEventQueue* self, size_t body) {
+  EventQueue* super = &self->super;
+  RadixEventQueue_unlink(self, body);
+  if (super->index != NULL) {
+    index_erase(super, body);
+  }
+
+  size_t last = --super->size;
+  if (body == last) {
+    return;
+  }
+
+  // Move the last body into the hole and patch every reference to it.
+  super->array[body] = super->array[last];
+  uint8_t b = self->bucket[last];
+  self->bucket[body] = b;
+  self->prev[body] = self->prev[last];
+  self->next[body] = self->next[last];
+  if (self->prev[body] != RADIX_NIL) {
+    self->next[self->prev[body]] = body;
+  } else {
+    self->head[b] = body;
+  }
+  if (self->next[body] != RADIX_NIL) {
+    self->prev[self->next[body]] = body;
+  }
+  if (super->index != NULL) {
+    super->index_pos[body] = super->index_pos[last];
+    super->index[super->index_pos[body]] = body + 1;
+  }
+}
+
+static tag_t RadixEventQueue_next_tag(EventQueue* super) {
+  RadixEventQueue* self = (RadixEventQueue*)super;
+  MUTEX_LOCK(super->mutex);
+  tag_t ret = FOREVER_TAG;
+  if (super->size > 0) {
+    RadixEventQueue_settle(self);
+    ret = self->last;
+  }
+  MUTEX_UNLOCK(super->mutex);
+  return ret;
+}
+
+static lf_ret_t RadixEventQueue_insert(EventQueue* super, AbstractEvent* event) {
+  RadixEventQueue* self = (RadixEventQueue*)super;
+  LF_DEBUG(QUEUE, "Inserting event with tag " PRINTF_TAG " into RadixEventQueue", event->tag);
+  MUTEX_LOCK(super->mutex);
+  if (super->size >= super->capacity) {
+    LF_ERR(QUEUE, "EventQueue is full has size %d", super->size);
+    MUTEX_UNLOCK(super->mutex);
+    return LF_EVENT_QUEUE_FULL;
+  }
+
+  size_t event_size = event_type_size(event->type);
+  if (event_size == 0) {
+    LF_ERR(QUEUE, "Unknown event type %d", event->type);
+    MUTEX_UNLOCK(super->mutex);
+    return LF_ERR;
+  }
+
+  size_t body = super->size++;
+  memcpy(&super->array[body], event, event_size);
+  if (super->index != NULL) {
+    index_insert(super, body);
+  }
+  if (lf_tag_compare(event->tag, self->last) < 0) {
+    RadixEventQueue_rebase(self, event->tag);
+  } else {
+    RadixEventQueue_link(self, body);
+  }
+
+  MUTEX_UNLOCK(super->mutex);
+  return LF_OK;
+}
+
+static lf_ret_t RadixEventQueue_pop(EventQueue* super, AbstractEvent* event) {
+  RadixEventQueue* self = (RadixEventQueue*)super;
+  LF_DEBUG(QUEUE, "Popping event from RadixEventQueue");
+  MUTEX_LOCK(super->mutex);
+  if (super->size == 0) {
+    LF_ERR(QUEUE, "EventQueue is empty");
+    MUTEX_UNLOCK(super->mutex);
+    return LF_EVENT_QUEUE_EMPTY;
+  }
+
+  RadixEventQueue_settle(self);
+  size_t body = self->head[0];
+  ArbitraryEvent* head = &super->array[body];
+  size_t event_size = event_type_size(head->event.super.type);
+  if (event_size == 0) {
+    LF_ERR(QUEUE, "Unknown event type %d", head->event.super.type);
+    MUTEX_UNLOCK(super->mutex);
+    return LF_ERR;
+  }
+  memcpy(event, head, event_size);
+  RadixEventQueue_remove_body(self, body);
+
+  MUTEX_UNLOCK(super->mutex);
+  return LF_OK;
+}
+
+static size_t RadixEventQueue_pop_all_at_tag(EventQueue* super, tag_t tag, ArbitraryEvent* events, size_t max) {
+  RadixEventQueue* self = (RadixEventQueue*)super;
+  MUTEX_LOCK(super->mutex);
+  size_t cnt = 0;
+  RadixEventQueue_settle(self);
+  // After settling, bucket 0 holds exactly the events at the minimum tag.
+  if (super->size > 0 && lf_tag_compare(self->last, tag) == 0) {
+    while (cnt < max && self->head[0] != RADIX_NIL) {
+      size_t body = self->head[0];
+      events[cnt++] = super->array[body];
+      RadixEventQueue_remove_body(self, body);
+    }
+  }
+  MUTEX_UNLOCK(super->mutex);
+  return cnt;
+}
+
+static void RadixEventQueue_build_heap(EventQueue* super) {
+  RadixEventQueue* self = (RadixEventQueue*)super;
+  tag_t min = FOREVER_TAG;
+  for (size_t i = 0; i < super->size; i++) {
+    if (lf_tag_compare(get_tag(&super->array[i]), min) < 0) {
+      min = get_tag(&super->array[i]);
+    }
+  }
+  RadixEventQueue_rebase(self, min);
+  if (super->index != NULL) {
+    index_rebuild(super);
+  }
+}
+
+static void RadixEventQueue_heapify(EventQueue* super, size_t idx) {
+  RadixEventQueue* self = (RadixEventQueue*)super;
+  if (idx >= super->size) {
+    return;
+  }
+  tag_t tag = get_tag(&super->array[idx]);
+  if (lf_tag_compare(tag, self->last) < 0) {
+    RadixEventQueue_rebase(self, tag);
+  } else {
+    RadixEventQueue_unlink(self, idx);
+    RadixEventQueue_link(self, idx);
+  }
+}
+
+static lf_ret_t RadixEventQueue_remove(EventQueue* super, AbstractEvent* event) {
+  RadixEventQueue* self = (RadixEventQueue*)super;
+  MUTEX_LOCK(super->mutex);
+  int body = find_equal_same_tag_idx(super, event);
+
+  if (body < 0) {
+    MUTEX_UNLOCK(super->mutex);
+    return LF_EVENT_NOT_FOUND;
+  }
+
+  RadixEventQueue_remove_body(self, body);
+  MUTEX_UNLOCK(super->mutex);
+  return LF_OK;
+}
+
+void RadixEventQueue_ctor(RadixEventQueue* self, ArbitraryEvent* array, size_t capacity, size_t* next, size_t* prev,
+                          uint8_t* bucket, size_t* index, size_t* index_pos, size_t index_capacity) {
+  EventQueue_ctor_indexed(&self->super, array, capacity, index, index_pos, index_capacity);
+  self->super.insert = RadixEventQueue_insert;
+  self->super.pop = RadixEventQueue_pop;
+  self->super.pop_all_at_tag = RadixEventQueue_pop_all_at_tag;
+  self->super.build_heap = RadixEventQueue_build_heap;
+  self->super.heapify = RadixEventQueue_heapify;
+  // Event bodies are compact in both queues, so the lookup is the same.
+  self->super.find_equal_same_tag = DaryEventQueue_find_equal_same_tag;
+  self->super.remove = RadixEventQueue_remove;
+  self->super.next_tag = RadixEventQueue_next_tag;
+  self->next = next;
+  self->prev = prev;
+  self->bucket = bucket;
+  RadixEventQueue_rebase(self, NEVER_TAG);
+}
+
+/**
+ * @brief Link the group headed by @p group into the sorted list of groups. If a group with the same period is
+ * already due at the same tag, the timers of @p group are appended to it instead, so that there is at most one
+ * group per (period, tag).
+ */
+static void TimerQueue_link_group(TimerQueue* self, Timer* group) {
+  Timer** link = &self->head;
+  while (*link != NULL && lf_tag_compare((*link)->next_tag, group->next_tag) < 0) {
+    link = &(*link)->next_group;
+  }
+
+  for (Timer* other = *link; other != NULL && lf_tag_compare(other->next_tag, group->next_tag) == 0;
+       other = other->next_group) {
+    if (other->period == group->period) {
+      Timer* tail = other;
+      while (tail->group_next != NULL) {
+        tail = tail->group_next;
+      }
+      tail->group_next = group;
+      return;
+    }
+  }
+
+  group->next_group = *link;
+  *link = group;
+}
+
+static tag_t TimerQueue_next_tag(TimerQueue* self) {
+  MUTEX_LOCK(self->mutex);
+  tag_t ret = FOREVER_TAG;
+  if (self->head != NULL) {
+    ret = self->head->next_tag;
+  }
+  MUTEX_UNLOCK(self->mutex);
+  return ret;
+}
+
+static bool TimerQueue_empty(TimerQueue* self) {
+  MUTEX_LOCK(self->mutex);
+  bool ret = self->head == NULL;
+  MUTEX_UNLOCK(self->mutex);
+  return ret;
+}
+
+static void TimerQueue_insert(TimerQueue* self, Timer* timer, tag_t tag) {
+  MUTEX_LOCK(self->mutex);
+  timer->next_tag = tag;
+  timer->group_next = NULL;
+  timer->next_group = NULL;
+  TimerQueue_link_group(self, timer);
+  MUTEX_UNLOCK(self->mutex);
+}
+
+static Timer* TimerQueue_pop(TimerQueue* self, tag_t tag) {
+  MUTEX_LOCK(self->mutex);
+  Timer* fired = NULL;
+  Timer** fired_tail = &fired;
+
+  // Detach all groups due at `tag` first, so that re-arming a group never links it in front of a group which is
+  // still to be detached.
+  while (self->head != NULL && lf_tag_compare(self->head->next_tag, tag) == 0) {
+    Timer* group = self->head;
+    self->head = group->next_group;
+    group->fired_next = NULL;
+    *fired_tail = group;
+    fired_tail = &group->fired_next;
+  }
+
+  for (Timer* group = fired; group != NULL; group = group->fired_next) {
+    if (group->period > NEVER) {
+      group->next_tag = lf_delay_tag(tag, group->period);
+      group->next_group = NULL;
+      TimerQueue_link_group(self, group);
+    }
+  }
+
+  MUTEX_UNLOCK(self->mutex);
+  return fired;
+}
+
+void TimerQueue_ctor(TimerQueue* self) {
+  self->next_tag = TimerQueue_next_tag;
+  self->empty = TimerQueue_empty;
+  self->insert = TimerQueue_insert;
+  self->pop = TimerQueue_pop;
+  self->head = NULL;
+  Mutex_ctor(&self->mutex.super);
+}
+
+#if EVENT_INGRESS_SIZE > 0
+static lf_ret_t IngressQueue_push(IngressQueue* self, const Event* event) {
+  size_t pos = atomic_load_explicit(&self->head, memory_order_relaxed);
+  IngressSlot* slot;
+  for (;;) {
+    slot = &self->slots[pos & (self->capacity - 1)];
+    // The difference is taken as signed so that the comparison survives the wrap-around of the positions.
+    ptrdiff_t diff = (ptrdiff_t)(atomic_load_explicit(&slot->seq, memory_order_acquire) - pos);
+    if (diff == 0) {
+      // The slot is free, claim it by moving the head past it.
+      if (atomic_compare_exchange_weak_explicit(&self->head, &pos, pos + 1, memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // The slot still holds an event from the previous round which the consumer has not popped yet.
+      return LF_EVENT_QUEUE_FULL;
+    } else {
+      // Another producer claimed the slot first.
+      pos = atomic_load_explicit(&self->head, memory_order_relaxed);
+    }
+  }
+
+  slot->event = *event;
+  atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+  return LF_OK;
+}
+
+static bool IngressQueue_pop(IngressQueue* self, Event* event) {
+  IngressSlot* slot = &self->slots[self->tail & (self->capacity - 1)];
+  if (atomic_load_explicit(&slot->seq, memory_order_acquire) != self->tail + 1) {
+    return false;
+  }
+  *event = slot->event;
+  atomic_store_explicit(&slot->seq, self->tail + self->capacity, memory_order_release);
+  self->tail++;
+  return true;
+}
+
+void IngressQueue_ctor(IngressQueue* self, IngressSlot* slots, size_t capacity) {
+  validate(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  self->push = IngressQueue_push;
+  self->pop = IngressQueue_pop;
+  self->slots = slots;
+  self->capacity = capacity;
+  self->tail = 0;
+  atomic_init(&self->head, 0);
+  for (size_t i = 0; i < capacity; i++) {
+    atomic_init(&slots[i].seq, i);
+  }
+}
+#endif
+
 static lf_ret_t ReactionQueue_insert(ReactionQueue* self, Reaction* reaction) {
   validate(reaction);
   validate(reaction->level < (int)self->capacity);
@@ -236,77 +1074,129 @@ static lf_ret_t ReactionQueue_insert(ReactionQueue* self, Reaction* reaction) {
 
   validate(self->curr_level <= reaction->level);
 
-  // checking if the reaction to be inserted is already in the queue
-  // e.g., when a reaction is triggered by two or more inputs.
-  // This needs to be done before checking if the queue is full, because
-  // if the reaction is already in the queue, we don't need to insert it again.
-  for (int i = 0; i < self->level_size[reaction->level]; i++) {
-    if (ACCESS(self->array, self->capacity, reaction->level, i) == reaction) {
-      return LF_OK;
-    }
+  // The reaction might already have been queued at this tag, e.g., when it is triggered by two or more inputs.
+  if (reaction->enqueued_epoch == self->epoch) {
+    return LF_OK;
   }
+  reaction->enqueued_epoch = self->epoch;
 
-  // now we can check if the queue is full
-  validate(self->level_size[reaction->level] < (int)self->capacity);
-
-  ACCESS(self->array, self->capacity, reaction->level, self->level_size[reaction->level]) = reaction;
-  self->level_size[reaction->level]++;
-  if (reaction->level > self->max_active_level) {
-    self->max_active_level = reaction->level;
+  int level = reaction->level;
+  uint32_t bit = (uint32_t)1 << (level % 32);
+  reaction->next_ready = NULL;
+  if (self->ready[level / 32] & bit) {
+    self->level_tail[level]->next_ready = reaction;
+  } else {
+    self->level_head[level] = reaction;
+    self->ready[level / 32] |= bit;
+  }
+  self->level_tail[level] = reaction;
+  if (level > self->max_active_level) {
+    self->max_active_level = level;
   }
   return LF_OK;
 }
 
+/** @brief Return the lowest level with queued reactions, or -1. Levels below curr_level are never ready. */
+static int ReactionQueue_next_ready_level(ReactionQueue* self) {
+  if (self->max_active_level < 0) {
+    return -1;
+  }
+  for (int word = self->curr_level / 32; word <= self->max_active_level / 32; word++) {
+    if (self->ready[word]) {
+      return word * 32 + lsb_index32(self->ready[word]);
+    }
+  }
+  return -1;
+}
+
 static Reaction* ReactionQueue_pop(ReactionQueue* self) {
-  Reaction* ret = NULL;
-  // Check if we can fetch a new reaction from same level
-  if (self->level_size[self->curr_level] > self->curr_index) {
-    ret = ACCESS(self->array, self->capacity, self->curr_level, self->curr_index);
-    self->curr_index++;
-  } else if (self->curr_level < self->max_active_level) {
-    self->curr_level++;
-    self->curr_index = 0;
-    ret = ReactionQueue_pop(self);
-  } else {
-    ret = NULL;
+  int level = ReactionQueue_next_ready_level(self);
+  if (level < 0) {
+    return NULL;
+  }
+  self->curr_level = level;
+  Reaction* ret = self->level_head[level];
+  self->level_head[level] = ret->next_ready;
+  if (!ret->next_ready) {
+    self->ready[level / 32] &= ~((uint32_t)1 << (level % 32));
   }
   return ret;
 }
 
-static bool ReactionQueue_empty(ReactionQueue* self) {
-  if (self->max_active_level < 0 || self->curr_level > self->max_active_level) {
-    return true;
-  }
-  if (self->curr_level == self->max_active_level && self->curr_index >= self->level_size[self->curr_level]) {
-    return true;
+static Reaction* ReactionQueue_pop_released(ReactionQueue* self, Reaction** executing, size_t executing_size) {
+  // Chains of the reactions queued at the levels scanned so far.
+  uint64_t queued_below = 0;
+
+  for (int level = ReactionQueue_next_ready_level(self); level >= 0 && level <= self->max_active_level; level++) {
+    if (!(self->ready[level / 32] & ((uint32_t)1 << (level % 32)))) {
+      continue;
+    }
+
+    uint64_t blocked = queued_below;
+    for (size_t i = 0; i < executing_size; i++) {
+      if (executing[i] && executing[i]->level < level) {
+        blocked |= executing[i]->chain_id;
+      }
+    }
+
+    Reaction* prev = NULL;
+    for (Reaction* reaction = self->level_head[level]; reaction; reaction = reaction->next_ready) {
+      if (!(reaction->chain_id & blocked)) {
+        // Unlink the reaction. Since reactions can be released out of order, curr_level is left where it is.
+        if (prev) {
+          prev->next_ready = reaction->next_ready;
+        } else {
+          self->level_head[level] = reaction->next_ready;
+        }
+        if (self->level_tail[level] == reaction) {
+          self->level_tail[level] = prev;
+        }
+        if (!self->level_head[level]) {
+          self->ready[level / 32] &= ~((uint32_t)1 << (level % 32));
+        }
+        return reaction;
+      }
+      queued_below |= reaction->chain_id;
+      prev = reaction;
+    }
   }
-  return false;
+  return NULL;
 }
 
+static bool ReactionQueue_empty(ReactionQueue* self) { return ReactionQueue_next_ready_level(self) < 0; }
+
 static void ReactionQueue_reset(ReactionQueue* self) {
-  self->curr_index = 0;
-  self->curr_level = 0;
-  for (int i = 0; i <= self->max_active_level; i++) {
-    self->level_size[i] = 0;
+  if (self->max_active_level >= 0) {
+    for (int word = 0; word <= self->max_active_level / 32; word++) {
+      self->ready[word] = 0;
+    }
   }
+  self->curr_level = 0;
   self->max_active_level = -1;
+  self->epoch++;
 }
 
-void ReactionQueue_ctor(ReactionQueue* self, Reaction** array, int* level_size, size_t capacity) {
+void ReactionQueue_ctor(ReactionQueue* self, Reaction** level_head, Reaction** level_tail, uint32_t* ready,
+                        size_t capacity) {
   self->insert = ReactionQueue_insert;
   self->pop = ReactionQueue_pop;
+  self->next_level = ReactionQueue_next_ready_level;
+  self->pop_released = ReactionQueue_pop_released;
   self->empty = ReactionQueue_empty;
   self->reset = ReactionQueue_reset;
-  self->curr_index = 0;
   self->curr_level = 0;
   self->max_active_level = -1;
   self->capacity = capacity;
-  self->level_size = level_size;
-  self->array = array;
+  self->level_head = level_head;
+  self->level_tail = level_tail;
+  self->ready = ready;
+  // Reactions start out with epoch 0, so they are not considered queued before the first reset.
+  self->epoch = 1;
   for (size_t i = 0; i < capacity; i++) {
-    self->level_size[i] = 0;
-    for (size_t j = 0; j < capacity; j++) {
-      ACCESS(self->array, self->capacity, i, j) = NULL;
-    }
+    self->level_head[i] = NULL;
+    self->level_tail[i] = NULL;
+  }
+  for (size_t i = 0; i < REACTION_QUEUE_READY_WORDS(capacity); i++) {
+    self->ready[i] = 0;
   }
 }
@@ -10,17 +10,15 @@ size_t Reaction_get_level(Reaction* self) {
   return self->level;
 }
 
-int calculate_port_level(Port* port) {
-  int current = -1;
+/**
+ * @brief Call `visit` on every reaction which writes to `port`, either directly or through the connection into it.
+ */
+static void Reaction_visit_port_upstreams(Port* port, void (*visit)(Reaction* upstream, void* arg), void* arg) {
   if (port->conn_in) {
     Port* final_upstream_port = port->conn_in->get_final_upstream(port->conn_in);
     if (final_upstream_port) {
       for (size_t k = 0; k < final_upstream_port->sources.size; k++) {
-        Reaction* upstream = final_upstream_port->sources.reactions[k];
-        int upstream_level = upstream->get_level(upstream);
-        if (upstream_level > current) {
-          current = upstream_level;
-        }
+        visit(final_upstream_port->sources.reactions[k], arg);
       }
     }
   }
@@ -28,59 +26,39 @@ int calculate_port_level(Port* port) {
   for (size_t i = 0; i < port->sources.size; i++) {
     Reaction* source = port->sources.reactions[i];
     validate(source);
-    int source_level = source->get_level(source);
-    if (source_level > current) {
-      current = source_level;
-    }
+    visit(source, arg);
   }
-
-  LF_DEBUG(ENV, "Input port %p has level %d", port, current);
-  return current;
 }
 
-size_t Reaction_calculate_trigger_level(Reaction* self, Trigger* trigger) {
-  int max_level = 0;
+static void Reaction_visit_trigger_upstreams(Reaction* self, Trigger* trigger,
+                                             void (*visit)(Reaction* upstream, void* arg), void* arg) {
   if (trigger->type == TRIG_INPUT || trigger->type == TRIG_OUTPUT) {
     Port* port = (Port*)trigger;
     for (size_t j = 0; j < port->effects.size; j++) {
       if (port->effects.reactions[j] == self) {
-        int level_from_port = calculate_port_level(port) + 1;
-        if (level_from_port > max_level) {
-          max_level = level_from_port;
-        }
+        Reaction_visit_port_upstreams(port, visit, arg);
       }
     }
     for (size_t j = 0; j < port->observers.size; j++) {
       if (port->observers.reactions[j] == self) {
-        int level_from_port = calculate_port_level(port) + 1;
-        if (level_from_port > max_level) {
-          max_level = level_from_port;
-        }
+        Reaction_visit_port_upstreams(port, visit, arg);
       }
     }
   }
-  return max_level;
 }
 
-size_t Reaction_calculate_level(Reaction* self) {
-  size_t max_level = 0;
-
-  // Possibly inherit level from reactions within same reactor with precedence.
+/**
+ * @brief Call `visit` on every reaction which must have completed before `self` can execute at the same tag.
+ */
+static void Reaction_visit_upstreams(Reaction* self, void (*visit)(Reaction* upstream, void* arg), void* arg) {
+  // Reactions within the same reactor are executed in order of their index.
   if (self->index >= 1) {
-    Reaction* reaction_prev_index = self->parent->reactions[self->index - 1];
-    size_t prev_level = reaction_prev_index->get_level(reaction_prev_index) + 1;
-    if (prev_level > max_level) {
-      max_level = prev_level;
-    }
+    visit(self->parent->reactions[self->index - 1], arg);
   }
 
   // Find all Input ports with the current reaction as an effect
   for (size_t i = 0; i < self->parent->triggers_size; i++) {
-    Trigger* trigger = self->parent->triggers[i];
-    size_t trigger_from_level = Reaction_calculate_trigger_level(self, trigger);
-    if (trigger_from_level > max_level) {
-      max_level = trigger_from_level;
-    }
+    Reaction_visit_trigger_upstreams(self, self->parent->triggers[i], visit, arg);
   }
 
   // Find all output ports within contained reactors which has marked our reaction
@@ -88,17 +66,73 @@ size_t Reaction_calculate_level(Reaction* self) {
   for (size_t i = 0; i < self->parent->children_size; i++) {
     Reactor* child = self->parent->children[i];
     for (size_t j = 0; j < child->triggers_size; j++) {
-      Trigger* trigger = child->triggers[j];
-      size_t trigger_from_level = Reaction_calculate_trigger_level(self, trigger);
-      if (trigger_from_level > max_level) {
-        max_level = trigger_from_level;
-      }
+      Reaction_visit_trigger_upstreams(self, child->triggers[j], visit, arg);
     }
   }
+}
+
+static void Reaction_update_max_level(Reaction* upstream, void* arg) {
+  size_t* max_level = (size_t*)arg;
+  size_t level = upstream->get_level(upstream) + 1;
+  if (level > *max_level) {
+    *max_level = level;
+  }
+}
 
+size_t Reaction_calculate_level(Reaction* self) {
+  size_t max_level = 0;
+  Reaction_visit_upstreams(self, Reaction_update_max_level, &max_level);
   return max_level;
 }
 
+typedef struct {
+  uint64_t chain_id;
+  bool changed;
+} ChainIdPropagation;
+
+static void Reaction_merge_chain_id(Reaction* upstream, void* arg) {
+  ChainIdPropagation* propagation = (ChainIdPropagation*)arg;
+  if ((upstream->chain_id | propagation->chain_id) != upstream->chain_id) {
+    upstream->chain_id |= propagation->chain_id;
+    propagation->changed = true;
+  }
+}
+
+bool Reaction_propagate_chain_id(Reaction* self) {
+  ChainIdPropagation propagation = {.chain_id = self->chain_id, .changed = false};
+  Reaction_visit_upstreams(self, Reaction_merge_chain_id, &propagation);
+  return propagation.changed;
+}
+
+bool Reaction_depends_on(Reaction* self, Port* port) {
+  for (size_t i = 0; i < port->effects.size; i++) {
+    if (port->effects.reactions[i] == self) {
+      return true;
+    }
+  }
+  for (size_t i = 0; i < port->observers.size; i++) {
+    if (port->observers.reactions[i] == self) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Reaction_calculate_stp_inputs(Reaction* self) {
+  self->stp_inputs = 0;
+  if (self->stp_violation_handler == NULL) {
+    return;
+  }
+
+  for (size_t i = 0; i < self->parent->triggers_size; i++) {
+    Trigger* trigger = self->parent->triggers[i];
+    if (trigger->type == TRIG_INPUT && Reaction_depends_on(self, (Port*)trigger)) {
+      size_t bit = i < REACTION_STP_INPUTS_OVERFLOW_BIT ? i : REACTION_STP_INPUTS_OVERFLOW_BIT;
+      self->stp_inputs |= (uint64_t)1 << bit;
+    }
+  }
+}
+
 void Reaction_ctor(Reaction* self, Reactor* parent, void (*body)(Reaction* self), Trigger** effects,
                    size_t effects_size, size_t index, void (*deadline_violation_handler)(Reaction*),
                    interval_t deadline, void (*stp_violation_handler)(Reaction*)) {
@@ -107,11 +141,16 @@ void Reaction_ctor(Reaction* self, Reactor* parent, void (*body)(Reaction* self)
   self->effects = effects;
   self->effects_size = effects_size;
   self->effects_registered = 0;
+  self->next_ready = NULL;
+  self->enqueued_epoch = 0;
+  self->chain_id = 0;
+  self->stp_inputs = 0;
   self->calculate_level = Reaction_calculate_level;
   self->get_level = Reaction_get_level;
   self->index = index;
   self->level = -1;
   self->deadline_violation_handler = deadline_violation_handler;
   self->deadline = deadline;
+  self->deadline_slack = FOREVER;
   self->stp_violation_handler = stp_violation_handler;
 }
@@ -105,6 +105,91 @@ lf_ret_t Reactor_calculate_levels(Reactor* self) {
   return LF_OK;
 }
 
+lf_ret_t Reactor_calculate_fanouts(Reactor* self) {
+  validate(self);
+#if PORT_FANOUT_TABLE_SIZE > 0
+  Environment* env = self->env;
+  for (size_t i = 0; i < self->triggers_size; i++) {
+    Trigger* trigger = self->triggers[i];
+    if (trigger->type == TRIG_INPUT || trigger->type == TRIG_OUTPUT) {
+      env->fanout_records_used += Port_calculate_fanout((Port*)trigger, &env->fanout_records[env->fanout_records_used],
+                                                        PORT_FANOUT_TABLE_SIZE - env->fanout_records_used);
+    }
+  }
+  for (size_t i = 0; i < self->children_size; i++) {
+    lf_ret_t res = Reactor_calculate_fanouts(self->children[i]);
+    if (res != LF_OK) {
+      return res;
+    }
+  }
+#endif
+  return LF_OK;
+}
+
+static void Reactor_assign_chain_ids(Reactor* self, size_t* next_bit) {
+  for (size_t i = 0; i < self->reactions_size; i++) {
+    self->reactions[i]->chain_id = (uint64_t)1 << (*next_bit % 64);
+    (*next_bit)++;
+  }
+  for (size_t i = 0; i < self->children_size; i++) {
+    Reactor_assign_chain_ids(self->children[i], next_bit);
+  }
+}
+
+static bool Reactor_propagate_chain_ids(Reactor* self) {
+  bool changed = false;
+  for (size_t i = 0; i < self->reactions_size; i++) {
+    changed |= Reaction_propagate_chain_id(self->reactions[i]);
+  }
+  for (size_t i = 0; i < self->children_size; i++) {
+    changed |= Reactor_propagate_chain_ids(self->children[i]);
+  }
+  return changed;
+}
+
+lf_ret_t Reactor_calculate_chain_ids(Reactor* self) {
+  validate(self);
+  size_t next_bit = 0;
+  Reactor_assign_chain_ids(self, &next_bit);
+
+  // Each pass moves the chain IDs at least one more hop upstream, so this terminates after at most as many passes as
+  // there are levels. With more than 64 reactions bits are shared, which only makes the chain IDs more conservative.
+  while (Reactor_propagate_chain_ids(self)) {
+  }
+  return LF_OK;
+}
+
+lf_ret_t Reactor_calculate_stp_inputs(Reactor* self) {
+  validate(self);
+  for (size_t i = 0; i < self->reactions_size; i++) {
+    Reaction_calculate_stp_inputs(self->reactions[i]);
+  }
+  for (size_t i = 0; i < self->children_size; i++) {
+    lf_ret_t res = Reactor_calculate_stp_inputs(self->children[i]);
+    if (res != LF_OK) {
+      return res;
+    }
+  }
+  return LF_OK;
+}
+
+lf_ret_t Reactor_resolve_aliases(Reactor* self) {
+  validate(self);
+  for (size_t i = 0; i < self->triggers_size; i++) {
+    Trigger* trigger = self->triggers[i];
+    if (trigger->type == TRIG_INPUT) {
+      Port_resolve_alias((Port*)trigger);
+    }
+  }
+  for (size_t i = 0; i < self->children_size; i++) {
+    lf_ret_t res = Reactor_resolve_aliases(self->children[i]);
+    if (res != LF_OK) {
+      return res;
+    }
+  }
+  return LF_OK;
+}
+
 void Reactor_ctor(Reactor* self, const char* name, Environment* env, Reactor* parent, Reactor** children,
                   size_t children_size, Reaction** reactions, size_t reactions_size, Trigger** triggers,
                   size_t triggers_size) {
@@ -120,4 +205,8 @@ void Reactor_ctor(Reactor* self, const char* name, Environment* env, Reactor* pa
   self->register_startup = Reactor_register_startup;
   self->register_shutdown = Reactor_register_shutdown;
   self->calculate_levels = Reactor_calculate_levels;
+  self->calculate_chain_ids = Reactor_calculate_chain_ids;
+  self->calculate_stp_inputs = Reactor_calculate_stp_inputs;
+  self->resolve_aliases = Reactor_resolve_aliases;
+  self->calculate_fanouts = Reactor_calculate_fanouts;
 }
@@ -6,7 +6,9 @@
 #include "reactor-uc/environment.h"
 #include "reactor-uc/logging.h"
 #include "reactor-uc/timer.h"
+#include "reactor-uc/action.h"
 #include "reactor-uc/tag.h"
+#include "reactor-uc/token.h"
 
 /**
  * @brief Builtin triggers (startup/shutdown) are chained together as a linked
@@ -57,45 +59,45 @@ static void Scheduler_pop_system_events_and_handle(Scheduler* untyped_self, tag_
 }
 
 /**
- * @brief Pop off all the events from the event queue which have a tag matching
- * `next_tag` and prepare the associated triggers.
+ * @brief Fire all the timers which are due at `next_tag` and pop off all the
+ * events from the event queue which have a tag matching `next_tag` and prepare
+ * the associated triggers.
  */
 static void Scheduler_pop_events_and_prepare(Scheduler* untyped_self, tag_t next_tag) {
   DynamicScheduler* self = (DynamicScheduler*)untyped_self;
-  lf_ret_t ret;
 
-  if (lf_tag_compare(next_tag, self->event_queue->next_tag(self->event_queue)) != 0) {
-    return;
+  // The timer queue hands back all due timers at once and has already re-armed the periodic ones.
+  Timer* group = self->timer_queue.pop(&self->timer_queue, next_tag);
+  for (; group != NULL; group = group->fired_next) {
+    for (Timer* timer = group; timer != NULL; timer = timer->group_next) {
+      Event event = EVENT_INIT(next_tag, &timer->super, NULL);
+      timer->super.prepare(&timer->super, &event);
+    }
   }
 
+  // Pop the events in batches, so that the event queue is locked once per batch instead of twice per event.
+  ArbitraryEvent events[SCHEDULER_EVENT_BATCH_SIZE];
+  size_t num_events;
   do {
-    ArbitraryEvent _event;
-    Event* event = &_event.event;
-
-    ret = self->event_queue->pop(self->event_queue, &event->super);
-
-    // After popping the event, we dont need the critical section.
-
-    validate(ret == LF_OK);
-
-    validate(event->super.type == EVENT);
-    assert(lf_tag_compare(event->super.tag, next_tag) == 0);
-    LF_DEBUG(SCHED, "Handling event %p for tag " PRINTF_TAG, event, event->super.tag);
-
-    Trigger* trigger = event->trigger;
-    if (trigger->type == TRIG_STARTUP || trigger->type == TRIG_SHUTDOWN) {
-      Scheduler_prepare_builtin(event);
-    } else {
-      trigger->prepare(trigger, event);
+    num_events = self->event_queue->pop_all_at_tag(self->event_queue, next_tag, events, SCHEDULER_EVENT_BATCH_SIZE);
+
+    for (size_t i = 0; i < num_events; i++) {
+      Event* event = &events[i].event;
+      validate(event->super.type == EVENT);
+      LF_DEBUG(SCHED, "Handling event %p for tag " PRINTF_TAG, event, event->super.tag);
+
+      Trigger* trigger = event->trigger;
+      if (trigger->type == TRIG_STARTUP || trigger->type == TRIG_SHUTDOWN) {
+        Scheduler_prepare_builtin(event);
+      } else {
+        trigger->prepare(trigger, event);
+      }
     }
-
-  } while (lf_tag_compare(next_tag, self->event_queue->next_tag(self->event_queue)) == 0);
+  } while (num_events == SCHEDULER_EVENT_BATCH_SIZE);
 }
 
-void Scheduler_register_for_cleanup(Scheduler* untyped_self, Trigger* trigger) {
-  DynamicScheduler* self = (DynamicScheduler*)untyped_self;
-
-  LF_DEBUG(SCHED, "Registering trigger %p for cleanup", trigger);
+/** @brief Append `trigger` to the cleanup list. While the worker pool executes a tag, its lock must be held. */
+static void Scheduler_register_for_cleanup_locked(DynamicScheduler* self, Trigger* trigger) {
   if (trigger->is_registered_for_cleanup) {
     return;
   }
@@ -111,6 +113,22 @@ void Scheduler_register_for_cleanup(Scheduler* untyped_self, Trigger* trigger) {
   trigger->is_registered_for_cleanup = true;
 }
 
+void Scheduler_register_for_cleanup(Scheduler* untyped_self, Trigger* trigger) {
+  DynamicScheduler* self = (DynamicScheduler*)untyped_self;
+
+  LF_DEBUG(SCHED, "Registering trigger %p for cleanup", trigger);
+#if SCHEDULER_MAX_WORKERS > 1
+  // Reactions executing in parallel can set ports concurrently.
+  if (self->workers.parallel) {
+    pthread_mutex_lock(&self->workers.lock);
+    Scheduler_register_for_cleanup_locked(self, trigger);
+    pthread_mutex_unlock(&self->workers.lock);
+    return;
+  }
+#endif
+  Scheduler_register_for_cleanup_locked(self, trigger);
+}
+
 void Scheduler_prepare_timestep(Scheduler* untyped_self, tag_t tag) {
   DynamicScheduler* self = (DynamicScheduler*)untyped_self;
 
@@ -120,6 +138,8 @@ void Scheduler_prepare_timestep(Scheduler* untyped_self, tag_t tag) {
   MUTEX_UNLOCK(self->mutex);
 
   self->reaction_queue->reset(self->reaction_queue);
+  self->tag_deadline_check = self->deadline_check;
+  self->lag_sample_level = -1;
 }
 
 void Scheduler_clean_up_timestep(Scheduler* untyped_self) {
@@ -144,6 +164,20 @@ void Scheduler_clean_up_timestep(Scheduler* untyped_self) {
   self->cleanup_ll_tail = NULL;
 }
 
+/** @brief Return the index of the least significant set bit of @p x, which must be non-zero. */
+static inline size_t lsb_index64(uint64_t x) {
+#if defined(__GNUC__)
+  return (size_t)__builtin_ctzll(x);
+#else
+  size_t idx = 0;
+  while ((x & 1u) == 0) {
+    x >>= 1;
+    idx++;
+  }
+  return idx;
+#endif
+}
+
 /**
  * @brief Checks for safe-to-process violations for the given reaction. If a violation is detected
  * the violation handler is called.
@@ -154,35 +188,50 @@ void Scheduler_clean_up_timestep(Scheduler* untyped_self) {
  */
 static bool _Scheduler_check_and_handle_stp_violations(DynamicScheduler* self, Reaction* reaction) {
   const Reactor* parent = reaction->parent;
-  for (size_t i = 0; i < parent->triggers_size; i++) {
-    Trigger* trigger = parent->triggers[i];
-    if (trigger->type == TRIG_INPUT && trigger->is_present) {
-      const Port* port = (Port*)trigger;
+  uint64_t inputs = reaction->stp_inputs;
+  while (inputs != 0) {
+    size_t i = lsb_index64(inputs);
+    inputs &= inputs - 1;
+
+    // The inputs beyond the bitmask share its last bit, so they are searched for the ones the reaction depends on.
+    bool overflow = i == REACTION_STP_INPUTS_OVERFLOW_BIT;
+    size_t end = overflow ? parent->triggers_size : i + 1;
+    for (; i < end; i++) {
+      Trigger* trigger = parent->triggers[i];
+      if (trigger->type != TRIG_INPUT || !trigger->is_present) {
+        continue;
+      }
+      Port* port = (Port*)trigger;
       LF_DEBUG(SCHED, "Intended Tag: " PRINTF_TAG, port->intended_tag);
       LF_DEBUG(SCHED, "Current Tag: " PRINTF_TAG, self->current_tag);
       if (lf_tag_compare(port->intended_tag, self->current_tag) == 0) {
         continue;
       }
-
-      for (size_t j = 0; j < port->effects.size; j++) {
-        if (port->effects.reactions[j] == reaction) {
-          LF_WARN(SCHED, "Timeout detected for %s->reaction_%d", reaction->parent->name, reaction->index);
-          reaction->stp_violation_handler(reaction);
-          return true;
-        }
-      }
-      for (size_t j = 0; j < port->observers.size; j++) {
-        if (port->observers.reactions[j] == reaction) {
-          LF_WARN(SCHED, "Timeout detected for %s->reaction_%d", reaction->parent->name, reaction->index);
-          reaction->stp_violation_handler(reaction);
-          return true;
-        }
+      if (!overflow || Reaction_depends_on(reaction, port)) {
+        LF_WARN(SCHED, "Timeout detected for %s->reaction_%d", reaction->parent->name, reaction->index);
+        reaction->stp_violation_handler(reaction);
+        return true;
       }
     }
   }
   return false;
 }
 
+/**
+ * @brief If physical time is sampled once per level, compute the deadline slack of `reaction` from the lag sampled for
+ * its level, taking the sample if there is none yet. While the worker pool executes a tag, its lock must be held.
+ */
+static void Scheduler_sample_deadline_slack_locked(DynamicScheduler* self, Reaction* reaction) {
+  if (reaction->deadline_violation_handler == NULL || self->tag_deadline_check != DEADLINE_CHECK_LEVEL) {
+    return;
+  }
+  if (reaction->level != self->lag_sample_level) {
+    self->lag_sample = self->env->get_lag(self->env);
+    self->lag_sample_level = reaction->level;
+  }
+  reaction->deadline_slack = lf_time_add(reaction->deadline, -self->lag_sample);
+}
+
 /**
  * @brief Checks for deadline violations for the given reaction. If a violation is detected
  * the violation handler is called.
@@ -192,7 +241,10 @@ static bool _Scheduler_check_and_handle_stp_violations(DynamicScheduler* self, R
  * @return true if a violation was detected and handled, false otherwise.
  */
 static bool _Scheduler_check_and_handle_deadline_violations(DynamicScheduler* self, Reaction* reaction) {
-  if (self->env->get_lag(self->env) >= reaction->deadline) {
+  if (self->tag_deadline_check == DEADLINE_CHECK_REACTION) {
+    reaction->deadline_slack = lf_time_add(reaction->deadline, -self->env->get_lag(self->env));
+  }
+  if (reaction->deadline_slack <= 0) {
     LF_WARN(SCHED, "Deadline violation detected for %s->reaction_%d", reaction->parent->name, reaction->index);
     reaction->deadline_violation_handler(reaction);
     return true;
@@ -200,27 +252,249 @@ static bool _Scheduler_check_and_handle_deadline_violations(DynamicScheduler* se
   return false;
 }
 
+/**
+ * @brief Execute `reaction` unless its STP offset or its deadline has been violated. With DEADLINE_CHECK_LEVEL,
+ * Scheduler_sample_deadline_slack_locked must have been called for it.
+ */
+static void Scheduler_execute_reaction(DynamicScheduler* self, Reaction* reaction) {
+  if (reaction->stp_violation_handler != NULL) {
+    if (_Scheduler_check_and_handle_stp_violations(self, reaction)) {
+      return;
+    }
+  }
+
+  if (reaction->deadline_violation_handler != NULL) {
+    if (_Scheduler_check_and_handle_deadline_violations(self, reaction)) {
+      return;
+    }
+  }
+
+  LF_DEBUG(SCHED, "Executing %s->reaction_%d", reaction->parent->name, reaction->index);
+  reaction->body(reaction);
+}
+
+#if SCHEDULER_MAX_WORKERS > 1
+/**
+ * @brief Execute reactions of the current tag until the reaction queue is empty and no other worker is executing a
+ * reaction anymore. Which reactions may be popped depends on the policy of the tag. Must be called with the lock of
+ * the worker pool held.
+ */
+static void Scheduler_work_locked(DynamicScheduler* self, size_t worker_id) {
+  WorkerPool* pool = &self->workers;
+  ReactionQueue* queue = self->reaction_queue;
+
+  while (true) {
+    Reaction* reaction = NULL;
+    if (pool->tag_policy == WORKER_POOL_CHAIN_RELEASE) {
+      reaction = queue->pop_released(queue, pool->executing, pool->tag_workers);
+    } else {
+      int level = queue->next_level(queue);
+      // The next level is only opened once the reactions still executing, which might trigger reactions at the
+      // next level, have completed.
+      if (level >= 0 && level != pool->level && pool->in_flight == 0) {
+        pool->level = level;
+      }
+      if (level >= 0 && level == pool->level) {
+        reaction = queue->pop(queue);
+      }
+    }
+
+    if (reaction) {
+      Scheduler_sample_deadline_slack_locked(self, reaction);
+      pool->executing[worker_id] = reaction;
+      pool->in_flight++;
+      pthread_mutex_unlock(&pool->lock);
+      Scheduler_execute_reaction(self, reaction);
+      pthread_mutex_lock(&pool->lock);
+      pool->executing[worker_id] = NULL;
+      // With chain release, every completed reaction might release others.
+      if (--pool->in_flight == 0 || pool->tag_policy == WORKER_POOL_CHAIN_RELEASE) {
+        pthread_cond_broadcast(&pool->cond);
+      }
+    } else if (pool->in_flight > 0) {
+      pthread_cond_wait(&pool->cond, &pool->lock);
+    } else {
+      break;
+    }
+  }
+}
+
+static void* Scheduler_worker_main(void* arg) {
+  WorkerThread* worker = (WorkerThread*)arg;
+  DynamicScheduler* self = worker->scheduler;
+  WorkerPool* pool = &self->workers;
+
+  pthread_mutex_lock(&pool->lock);
+  while (!pool->terminate) {
+    if (worker->generation == pool->tag_generation) {
+      pthread_cond_wait(&pool->cond, &pool->lock);
+      continue;
+    }
+    worker->generation = pool->tag_generation;
+    if (worker->id < pool->tag_workers) {
+      Scheduler_work_locked(self, worker->id);
+      if (--pool->helpers_pending == 0) {
+        pthread_cond_broadcast(&pool->cond);
+      }
+    }
+  }
+  pthread_mutex_unlock(&pool->lock);
+  return NULL;
+}
+
+/** @brief Execute the reactions of the current tag on the scheduler thread and `tag_workers - 1` helper threads. */
+static void Scheduler_run_timestep_parallel(DynamicScheduler* self) {
+  WorkerPool* pool = &self->workers;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->tag_workers = pool->num_workers;
+  pool->tag_policy = pool->policy;
+  pool->tag_generation++;
+  pool->helpers_pending = pool->tag_workers - 1;
+  pool->level = -1;
+  pool->parallel = true;
+
+  // Helper threads are only started once they are first needed.
+  while (pool->threads_started < pool->tag_workers - 1) {
+    WorkerThread* worker = &pool->threads[pool->threads_started];
+    worker->scheduler = self;
+    worker->id = pool->threads_started + 1;
+    worker->generation = pool->tag_generation - 1;
+    validate(pthread_create(&worker->thread, NULL, Scheduler_worker_main, worker) == 0);
+    pool->threads_started++;
+  }
+  pthread_cond_broadcast(&pool->cond);
+
+  Scheduler_work_locked(self, 0);
+  while (pool->helpers_pending > 0) {
+    pthread_cond_wait(&pool->cond, &pool->lock);
+  }
+  pool->parallel = false;
+  pthread_mutex_unlock(&pool->lock);
+}
+
+/** @brief Terminate and join the helper threads. They are started again by the next parallel tag. */
+static void Scheduler_stop_workers(DynamicScheduler* self) {
+  WorkerPool* pool = &self->workers;
+
+  pthread_mutex_lock(&pool->lock);
+  pool->terminate = true;
+  pthread_cond_broadcast(&pool->cond);
+  pthread_mutex_unlock(&pool->lock);
+
+  for (size_t i = 0; i < pool->threads_started; i++) {
+    pthread_join(pool->threads[i].thread, NULL);
+  }
+  pool->threads_started = 0;
+  pool->terminate = false;
+}
+#endif
+
 void Scheduler_run_timestep(Scheduler* untyped_self) {
   DynamicScheduler* self = (DynamicScheduler*)untyped_self;
 
+#if SCHEDULER_MAX_WORKERS > 1
+  if (self->workers.num_workers > 1) {
+    Scheduler_run_timestep_parallel(self);
+    return;
+  }
+#endif
+
   while (!self->reaction_queue->empty(self->reaction_queue)) {
     Reaction* reaction = self->reaction_queue->pop(self->reaction_queue);
+    Scheduler_sample_deadline_slack_locked(self, reaction);
+    Scheduler_execute_reaction(self, reaction);
+  }
+}
 
-    if (reaction->stp_violation_handler != NULL) {
-      if (_Scheduler_check_and_handle_stp_violations(self, reaction)) {
-        continue;
-      }
+/**
+ * @brief Check the tag of `event` against the start, stop and current tag and insert it into the timer queue or the
+ * event queue. Must be called with the scheduler mutex held.
+ */
+static lf_ret_t Scheduler_insert_event_locked(DynamicScheduler* self, Event* event) {
+  // Check if we are trying to schedule past stop tag. This is expected behavior during
+  // shutdown when timers try to schedule their next event.
+  if (lf_tag_compare(event->super.tag, self->stop_tag) > 0) {
+    LF_DEBUG(SCHED, "Dropping event at tag " PRINTF_TAG " past stop tag " PRINTF_TAG, event->super.tag, self->stop_tag);
+    return LF_AFTER_STOP_TAG;
+  }
+
+  // Check if we are trying to schedule into the past
+  if (lf_tag_compare(event->super.tag, self->current_tag) <= 0) {
+    LF_WARN(SCHED, "Trying to schedule event into the past at tag: " PRINTF_TAG, event->super.tag);
+    LF_WARN(SCHED, "Current tag: " PRINTF_TAG, self->current_tag);
+    return LF_PAST_TAG;
+  }
+
+  // Check if we are trying to schedule before the start tag
+  if (self->super.start_time > 0) {
+    tag_t start_tag = {.time = self->super.start_time, .microstep = 0};
+    if (lf_tag_compare(event->super.tag, start_tag) < 0 || self->super.start_time == NEVER) {
+      LF_WARN(SCHED, "Trying to schedule event at tag " PRINTF_TAG " which is before start tag", event->super.tag);
+      return LF_INVALID_TAG;
     }
+  }
 
-    if (reaction->deadline_violation_handler != NULL) {
-      if (_Scheduler_check_and_handle_deadline_violations(self, reaction)) {
-        continue;
+  if (event->trigger->type == TRIG_TIMER) {
+    self->timer_queue.insert(&self->timer_queue, (Timer*)event->trigger, event->super.tag);
+    return LF_OK;
+  }
+
+  lf_ret_t ret = self->event_queue->insert(self->event_queue, (AbstractEvent*)event);
+  validate(ret == LF_OK);
+  return ret;
+}
+
+/**
+ * @brief Move the events scheduled through `Scheduler_schedule_at_async` into the event queue. Returns the earliest
+ * tag among them, or FOREVER_TAG if there were none.
+ */
+static tag_t Scheduler_drain_ingress(DynamicScheduler* self) {
+  tag_t earliest = FOREVER_TAG;
+#if EVENT_INGRESS_SIZE > 0
+  Event event;
+
+  MUTEX_LOCK(self->mutex);
+  while (self->ingress.pop(&self->ingress, &event)) {
+    lf_ret_t ret = Scheduler_insert_event_locked(self, &event);
+    if (ret == LF_PAST_TAG) {
+      // The scheduler advanced while the event was in flight. Handle it as soon as possible instead.
+      if (event.trigger->type == TRIG_CONN_FEDERATED_INPUT) {
+        LF_WARN(SCHED, "Safe-to-process violation! Message at tag " PRINTF_TAG " arrived too late, handling it now",
+                event.super.tag);
       }
+      event.super.tag = lf_delay_tag(self->current_tag, 0);
+      ret = Scheduler_insert_event_locked(self, &event);
     }
 
-    LF_DEBUG(SCHED, "Executing %s->reaction_%d", reaction->parent->name, reaction->index);
-    reaction->body(reaction);
+    if (ret == LF_OK) {
+      if (lf_tag_compare(event.super.tag, earliest) < 0) {
+        earliest = event.super.tag;
+      }
+    } else {
+      // Nobody is left to handle the failure, so we release what the producer reserved for the event.
+      LF_WARN(SCHED, "Dropping asynchronously scheduled event at tag " PRINTF_TAG, event.super.tag);
+      Trigger* trigger = event.trigger;
+      if (event.super.payload != NULL) {
+        trigger->payload_pool->free(trigger->payload_pool, event.super.payload);
+      }
+      if (trigger->type == TRIG_ACTION && ((Action*)trigger)->type == PHYSICAL_ACTION) {
+        // The producer updates the pending events of the action under its mutex, and may hold it while waiting for the
+        // scheduler mutex, so we release the scheduler mutex before taking it.
+        PhysicalAction* action = (PhysicalAction*)trigger;
+        MUTEX_UNLOCK(self->mutex);
+        MUTEX_LOCK(action->mutex);
+        action->super.events_scheduled--;
+        MUTEX_UNLOCK(action->mutex);
+        MUTEX_LOCK(self->mutex);
+      }
+    }
   }
+  MUTEX_UNLOCK(self->mutex);
+#else
+  (void)self;
+#endif
+  return earliest;
 }
 
 void Scheduler_do_shutdown(Scheduler* untyped_self, tag_t shutdown_tag) {
@@ -229,6 +503,7 @@ void Scheduler_do_shutdown(Scheduler* untyped_self, tag_t shutdown_tag) {
   LF_INFO(SCHED, "Scheduler terminating at tag " PRINTF_TAG, shutdown_tag);
   self->super.prepare_timestep(untyped_self, shutdown_tag);
 
+  Scheduler_drain_ingress(self);
   Scheduler_pop_events_and_prepare(untyped_self, shutdown_tag);
 
   Trigger* shutdown = &self->env->shutdown->super;
@@ -240,6 +515,10 @@ void Scheduler_do_shutdown(Scheduler* untyped_self, tag_t shutdown_tag) {
     self->run_timestep(untyped_self);
     self->clean_up_timestep(untyped_self);
   }
+
+#if SCHEDULER_MAX_WORKERS > 1
+  Scheduler_stop_workers(self);
+#endif
 }
 
 void Scheduler_set_and_schedule_start_tag(Scheduler* untyped_self, instant_t start_time) {
@@ -269,7 +548,8 @@ void Scheduler_run(Scheduler* untyped_self) {
   bool next_event_is_system_event = false;
   LF_DEBUG(SCHED, "Scheduler running with keep_alive=%d", self->super.keep_alive);
 
-  while (self->super.keep_alive || !self->event_queue->empty(self->event_queue) || untyped_self->start_time == NEVER) {
+  while (self->super.keep_alive || !self->event_queue->empty(self->event_queue) ||
+         !self->timer_queue.empty(&self->timer_queue) || untyped_self->start_time == NEVER) {
     LF_DEBUG(SCHED, "Beginning scheduler loop iteration");
     if (env->poll_network_channels) {
       LF_DEBUG(SCHED, "Polling network channels");
@@ -301,6 +581,7 @@ void Scheduler_run(Scheduler* untyped_self) {
       } while (true);
     }
 
+    Scheduler_drain_ingress(self);
     next_tag = self->event_queue->next_tag(self->event_queue);
 
     // Check that next tag is greater than start tag. Could be violated if we are scheduling events when the start
@@ -314,6 +595,11 @@ void Scheduler_run(Scheduler* untyped_self) {
       continue;
     }
 
+    tag_t next_timer_tag = self->timer_queue.next_tag(&self->timer_queue);
+    if (lf_tag_compare(next_timer_tag, next_tag) < 0) {
+      next_tag = next_timer_tag;
+    }
+
     // If we have system events, we need to check if the next event is a system event.
     if (self->system_event_queue) {
       next_system_tag = self->system_event_queue->next_tag(self->system_event_queue);
@@ -371,6 +657,14 @@ void Scheduler_run(Scheduler* untyped_self) {
         continue;
       }
     }
+
+    // Events scheduled asynchronously while we were waiting must be in the event queue before we commit to
+    // `next_tag`. If one of them is earlier, we re-evaluate the next tag.
+    if (lf_tag_compare(Scheduler_drain_ingress(self), next_tag) < 0) {
+      LF_DEBUG(SCHED, "Asynchronous event arrived before the next tag. Re-evaluating.");
+      going_to_shutdown = false;
+      continue;
+    }
     // Once we are here, we have are committed to executing `next_tag`.
 
     // If we have reached the stop tag, we break the while loop and go to termination.
@@ -393,7 +687,8 @@ void Scheduler_run(Scheduler* untyped_self) {
   if (lf_tag_compare(self->stop_tag, self->current_tag) == 0) {
     LF_DEBUG(SCHED, "Shutting down because we reached the stop tag.");
     shutdown_tag = self->stop_tag;
-  } else if (!self->super.keep_alive && self->event_queue->empty(self->event_queue)) {
+  } else if (!self->super.keep_alive && self->event_queue->empty(self->event_queue) &&
+             self->timer_queue.empty(&self->timer_queue)) {
     LF_DEBUG(SCHED, "Shutting down due to starvation.");
     shutdown_tag = lf_delay_tag(self->current_tag, 0);
   } else {
@@ -405,46 +700,29 @@ void Scheduler_run(Scheduler* untyped_self) {
 
 lf_ret_t Scheduler_schedule_at(Scheduler* super, Event* event) {
   DynamicScheduler* self = (DynamicScheduler*)super;
-  lf_ret_t ret;
 
   // This can be called from the async context and the channel context. It reads stop_tag, current_tag, start_time
   // and more and we lock the scheduler mutex before doing anything.
   MUTEX_LOCK(self->mutex);
-
-  // Check if we are trying to schedule past stop tag. This is expected behavior during
-  // shutdown when timers try to schedule their next event.
-  if (lf_tag_compare(event->super.tag, self->stop_tag) > 0) {
-    LF_DEBUG(SCHED, "Dropping event at tag " PRINTF_TAG " past stop tag " PRINTF_TAG, event->super.tag, self->stop_tag);
-    ret = LF_AFTER_STOP_TAG;
-    goto unlock_and_return;
+  lf_ret_t ret = Scheduler_insert_event_locked(self, event);
+  if (ret == LF_OK) {
+    self->env->platform->notify(self->env->platform);
   }
+  MUTEX_UNLOCK(self->mutex);
+  return ret;
+}
 
-  // Check if we are trying to schedule into the past
-  if (lf_tag_compare(event->super.tag, self->current_tag) <= 0) {
-    LF_WARN(SCHED, "Trying to schedule event into the past at tag: " PRINTF_TAG, event->super.tag);
-    LF_WARN(SCHED, "Current tag: " PRINTF_TAG, self->current_tag);
-    ret = LF_PAST_TAG;
-    goto unlock_and_return;
-  }
+lf_ret_t Scheduler_schedule_at_async(Scheduler* super, Event* event) {
+#if EVENT_INGRESS_SIZE > 0
+  DynamicScheduler* self = (DynamicScheduler*)super;
 
-  // Check if we are trying to schedule before the start tag
-  if (self->super.start_time > 0) {
-    tag_t start_tag = {.time = self->super.start_time, .microstep = 0};
-    if (lf_tag_compare(event->super.tag, start_tag) < 0 || self->super.start_time == NEVER) {
-      LF_WARN(SCHED, "Trying to schedule event at tag " PRINTF_TAG " which is before start tag", event->super.tag);
-      ret = LF_INVALID_TAG;
-      goto unlock_and_return;
-    }
+  if (self->ingress.push(&self->ingress, event) == LF_OK) {
+    self->env->platform->notify(self->env->platform);
+    return LF_OK;
   }
-
-  ret = self->event_queue->insert(self->event_queue, (AbstractEvent*)event);
-  validate(ret == LF_OK);
-
-  self->env->platform->notify(self->env->platform);
-
-unlock_and_return:
-  MUTEX_UNLOCK(self->mutex);
-  return ret;
+  LF_DEBUG(SCHED, "Ingress queue is full, scheduling event at tag " PRINTF_TAG " directly", event->super.tag);
+#endif
+  return Scheduler_schedule_at(super, event);
 }
 
 lf_ret_t Scheduler_schedule_system_event_at(Scheduler* super, SystemEvent* event) {
@@ -508,6 +786,14 @@ static void Scheduler_step_clock(Scheduler* _self, interval_t step) {
 lf_ret_t Scheduler_add_to_reaction_queue(Scheduler* untyped_self, Reaction* reaction) {
   DynamicScheduler* self = (DynamicScheduler*)untyped_self;
 
+#if SCHEDULER_MAX_WORKERS > 1
+  if (self->workers.parallel) {
+    pthread_mutex_lock(&self->workers.lock);
+    lf_ret_t ret = self->reaction_queue->insert(self->reaction_queue, reaction);
+    pthread_mutex_unlock(&self->workers.lock);
+    return ret;
+  }
+#endif
   return self->reaction_queue->insert(self->reaction_queue, reaction);
 }
 
@@ -547,8 +833,12 @@ lf_ret_t Scheduler_replace_event_payload(Scheduler* self, Trigger* trigger, inst
   }
 
   LF_DEBUG(SCHED, "Replacing payload of event %p for trigger %p at tag " PRINTF_TAG, found, trigger, found->super.tag);
-  memcpy(found->super.payload, new_value, trigger->payload_pool->payload_size);
   validate(new_value != NULL);
+  if (trigger->payload_pool->holds_tokens) {
+    Token_assign((Token**)found->super.payload, *(Token* const*)new_value);
+  } else {
+    memcpy(found->super.payload, new_value, trigger->payload_pool->payload_size);
+  }
   return LF_OK;
 }
 
@@ -562,11 +852,38 @@ void DynamicScheduler_ctor(DynamicScheduler* self, Environment* env, EventQueue*
   self->stop_tag = FOREVER_TAG;
   self->shutdown_requested = false;
   self->current_tag = NEVER_TAG;
+  self->deadline_check = SCHEDULER_DEADLINE_CHECK;
+  self->tag_deadline_check = SCHEDULER_DEADLINE_CHECK;
+  self->lag_sample = 0;
+  self->lag_sample_level = -1;
   self->cleanup_ll_head = NULL;
   self->cleanup_ll_tail = NULL;
   self->event_queue = event_queue;
   self->reaction_queue = reaction_queue;
   self->system_event_queue = system_event_queue;
+  TimerQueue_ctor(&self->timer_queue);
+#if EVENT_INGRESS_SIZE > 0
+  IngressQueue_ctor(&self->ingress, self->ingress_slots, EVENT_INGRESS_SIZE);
+#endif
+#if SCHEDULER_MAX_WORKERS > 1
+  validate(SCHEDULER_WORKERS >= 1 && SCHEDULER_WORKERS <= SCHEDULER_MAX_WORKERS);
+  self->workers.threads_started = 0;
+  self->workers.num_workers = SCHEDULER_WORKERS;
+  self->workers.tag_workers = 1;
+  self->workers.policy = WORKER_POOL_LEVEL_BARRIER;
+  self->workers.tag_policy = WORKER_POOL_LEVEL_BARRIER;
+  for (size_t i = 0; i < SCHEDULER_MAX_WORKERS; i++) {
+    self->workers.executing[i] = NULL;
+  }
+  self->workers.tag_generation = 0;
+  self->workers.helpers_pending = 0;
+  self->workers.in_flight = 0;
+  self->workers.level = -1;
+  self->workers.parallel = false;
+  self->workers.terminate = false;
+  pthread_mutex_init(&self->workers.lock, NULL);
+  pthread_cond_init(&self->workers.cond, NULL);
+#endif
 
   self->super.start_time = NEVER;
   self->super.running = false;
@@ -577,6 +894,7 @@ void DynamicScheduler_ctor(DynamicScheduler* self, Environment* env, EventQueue*
   self->super.prepare_timestep = Scheduler_prepare_timestep;
   self->super.do_shutdown = Scheduler_do_shutdown;
   self->super.schedule_at = Scheduler_schedule_at;
+  self->super.schedule_at_async = Scheduler_schedule_at_async;
   self->super.schedule_system_event_at = Scheduler_schedule_system_event_at;
   self->super.register_for_cleanup = Scheduler_register_for_cleanup;
   self->super.request_shutdown = Scheduler_request_shutdown;
@@ -589,3 +907,39 @@ void DynamicScheduler_ctor(DynamicScheduler* self, Environment* env, EventQueue*
 
   Mutex_ctor(&self->mutex.super);
 }
+
+lf_ret_t DynamicScheduler_set_num_workers(DynamicScheduler* self, size_t num_workers) {
+  if (num_workers == 0 || num_workers > SCHEDULER_MAX_WORKERS) {
+    return LF_INVALID_VALUE;
+  }
+#if SCHEDULER_MAX_WORKERS > 1
+  pthread_mutex_lock(&self->workers.lock);
+  self->workers.num_workers = num_workers;
+  pthread_mutex_unlock(&self->workers.lock);
+#else
+  (void)self;
+#endif
+  return LF_OK;
+}
+
+lf_ret_t DynamicScheduler_set_worker_policy(DynamicScheduler* self, WorkerPoolPolicy policy) {
+  if (policy != WORKER_POOL_LEVEL_BARRIER && policy != WORKER_POOL_CHAIN_RELEASE) {
+    return LF_INVALID_VALUE;
+  }
+#if SCHEDULER_MAX_WORKERS > 1
+  pthread_mutex_lock(&self->workers.lock);
+  self->workers.policy = policy;
+  pthread_mutex_unlock(&self->workers.lock);
+#else
+  (void)self;
+#endif
+  return LF_OK;
+}
+
+lf_ret_t DynamicScheduler_set_deadline_check(DynamicScheduler* self, DeadlineCheckGranularity granularity) {
+  if (granularity != DEADLINE_CHECK_REACTION && granularity != DEADLINE_CHECK_LEVEL) {
+    return LF_INVALID_VALUE;
+  }
+  self->deadline_check = granularity;
+  return LF_OK;
+}
@@ -11,7 +11,9 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#include "reactor-uc/environment.h"
 #include "reactor-uc/schedulers/static/instructions.h"
+#include "reactor-uc/schedulers/static/scheduler.h"
 #include "reactor-uc/schedulers/static/scheduler_instructions.h"
 #include "reactor-uc/tag.h"
 #include "reactor-uc/reaction.h"
@@ -19,57 +21,115 @@
 #ifndef TRACE_ALL_INSTRUCTIONS
 #define TRACE_ALL_INSTRUCTIONS false
 #endif
-#define SPIN_WAIT_THRESHOLD SEC(1)
+
+// DU sleeps until this long before the wakeup time and spins for the rest, which wakes the worker up with less jitter
+// than the sleep alone.
+#define SPIN_WAIT_THRESHOLD USEC(100)
+
+// Registers are written by one worker while others wait on them. Writes are released and waits acquire them, so a
+// worker which passes a WU also sees everything the writing worker did before the write.
+#define REG_LOAD(reg) __atomic_load_n((reg), __ATOMIC_ACQUIRE)
+#define REG_STORE(reg, value) __atomic_store_n((reg), (value), __ATOMIC_RELEASE)
+
+// Workers waiting on each other must not keep the worker they wait for from running when there are fewer cores than
+// workers.
+#if SCHEDULER_MAX_WORKERS > 1
+#include <sched.h>
+#define SPIN_WAIT_YIELD() sched_yield()
+#else
+#define SPIN_WAIT_YIELD()
+#endif
 
 const void* zero;
 
 /**
  * @brief The implementation of the ADD instruction
  */
-void execute_inst_ADD(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, // NOLINT
-                      operand_t op3, bool debug, size_t* program_counter, Reaction** returned_reaction,
-                      bool* exit_loop) {
+void execute_inst_ADD(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   reg_t* dst = op1.reg;
   reg_t* src = op2.reg;
   reg_t* src2 = op3.reg;
-  *dst = *src + *src2;
+  REG_STORE(dst, *src + *src2);
   *program_counter += 1; // Increment pc.
 }
 
 /**
  * @brief The implementation of the ADDI instruction
  */
-void execute_inst_ADDI(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+void execute_inst_ADDI(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
                        bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   reg_t* dst = op1.reg;
   reg_t* src = op2.reg;
   // FIXME: Will there be problems if instant_t adds reg_t?
-  *dst = *src + op3.imm;
+  REG_STORE(dst, *src + op3.imm);
+  *program_counter += 1; // Increment pc.
+}
+
+/**
+ * @brief Clean up the triggers of the current tag and advance the time register @p time_reg to @p time. Only one
+ * worker may advance time, and only once every other worker is done with the current tag.
+ */
+static void advance_time(StaticScheduler* scheduler, reg_t* time_reg, uint64_t time) {
+  scheduler->clean_up_timestep(&scheduler->super);
+  REG_STORE(time_reg, time);
+}
+
+/**
+ * @brief The implementation of the ADV instruction
+ */
+void execute_inst_ADV(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+  (void)worker_number;
+  (void)debug;
+  (void)returned_reaction;
+  (void)exit_loop;
+
+  reg_t* dst = op1.reg;
+  reg_t* src = op2.reg;
+  reg_t* inc = op3.reg;
+  advance_time(scheduler, dst, *src + *inc);
+  *program_counter += 1; // Increment pc.
+}
+
+/**
+ * @brief The implementation of the ADVI instruction
+ */
+void execute_inst_ADVI(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                       bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+  (void)worker_number;
+  (void)debug;
+  (void)returned_reaction;
+  (void)exit_loop;
+
+  reg_t* dst = op1.reg;
+  reg_t* src = op2.reg;
+  advance_time(scheduler, dst, *src + op3.imm);
   *program_counter += 1; // Increment pc.
 }
 
 /**
  * @brief The implementation of the BEQ instruction
  */
-void execute_inst_BEQ(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_BEQ(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   reg_t* _op1 = op1.reg;
   reg_t* _op2 = op2.reg;
@@ -85,13 +145,13 @@ void execute_inst_BEQ(Platform* platform, size_t worker_number, operand_t op1, o
 /**
  * @brief The implementation of the BGE instruction
  */
-void execute_inst_BGE(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_BGE(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   reg_t* _op1 = op1.reg;
   reg_t* _op2 = op2.reg;
@@ -104,13 +164,13 @@ void execute_inst_BGE(Platform* platform, size_t worker_number, operand_t op1, o
 /**
  * @brief The implementation of the BLT instruction
  */
-void execute_inst_BLT(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_BLT(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   reg_t* _op1 = op1.reg;
   reg_t* _op2 = op2.reg;
@@ -123,13 +183,13 @@ void execute_inst_BLT(Platform* platform, size_t worker_number, operand_t op1, o
 /**
  * @brief The implementation of the BNE instruction
  */
-void execute_inst_BNE(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_BNE(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   reg_t* _op1 = op1.reg;
   reg_t* _op2 = op2.reg;
@@ -142,40 +202,27 @@ void execute_inst_BNE(Platform* platform, size_t worker_number, operand_t op1, o
 /**
  * @brief The implementation of the DU instruction
  */
-void execute_inst_DU(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                     size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_DU(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                     bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)op3;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
 
   // FIXME: There seems to be an overflow problem.
-  // When wakeup_time overflows but lf_time_physical() doesn't,
-  // _lf_interruptable_sleep_until_locked() terminates immediately.
+  // When wakeup_time overflows but the physical time doesn't, the wait terminates immediately.
+  Environment* env = scheduler->env;
   reg_t* src = op1.reg;
-  instant_t current_time = platform->get_physical_time(platform);
-  instant_t wakeup_time = *src + op2.imm;
-  instant_t wait_interval = wakeup_time - current_time;
-  // LF_PRINT_DEBUG("*** start_time: %lld, wakeup_time: %lld, op1: %lld, op2:
-  // %lld, current_physical_time: %lld\n", start_time, wakeup_time, *src,
-  // op2.imm, lf_time_physical());
-
-  if (wait_interval > 0) {
-    // Approach 1: Only spin when the wait interval is less than
-    // SPIN_WAIT_THRESHOLD.
-    if (wait_interval < SPIN_WAIT_THRESHOLD) {
-      // Spin wait if the wait interval is less than 1 ms.
-      while (platform->get_physical_time(platform) < wakeup_time)
-        ;
-    } else {
-      // Otherwise sleep.
-      // TODO: _lf_interruptable_sleep_until_locked(scheduler->env,
-      // wakeup_time);
+  instant_t wakeup_time = (instant_t)(*src + op2.imm);
+
+  if (!env->fast_mode) {
+    instant_t sleep_until = wakeup_time - SPIN_WAIT_THRESHOLD;
+    if (sleep_until > env->get_physical_time(env)) {
+      env->wait_until(env, sleep_until);
+    }
+    while (env->get_physical_time(env) < wakeup_time) {
     }
-    // Approach 2: Spin wait.
-    // while (lf_time_physical() < wakeup_time);
   }
   *program_counter += 1; // Increment pc.
 }
@@ -183,70 +230,80 @@ void execute_inst_DU(Platform* platform, size_t worker_number, operand_t op1, op
 /**
  * @brief The implementation of the EXE instruction
  */
-void execute_inst_EXE(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_EXE(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
-  (void)op3;
   (void)debug;
-  (void)returned_reaction;
-  (void)exit_loop;
-  (void)platform;
-  void (*function)(Reaction*);
-
-  function = (void (*)(Reaction*))(uintptr_t)op1.reg;
 
   Reaction* args = (Reaction*)op2.reg;
-  // Execute the function directly.
-  function(args);
+  if (op3.imm != 0 && args->enqueued_epoch != scheduler->epoch) {
+    // A conditional EXE skips reactions which have not been triggered at the current tag.
+    *program_counter += 1;
+    return;
+  }
+
+  if (op1.reg != NULL) {
+    // Execute the function directly.
+    void (*function)(Reaction*) = (void (*)(Reaction*))(uintptr_t)op1.reg;
+    function(args);
+  } else {
+    // Hand the reaction over to the worker, which executes it and then resumes the schedule after this instruction.
+    *returned_reaction = args;
+    *exit_loop = true;
+  }
   *program_counter += 1; // Increment pc.
 }
 
 /**
  * @brief The implementation of the WLT instruction
  */
-void execute_inst_WLT(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_WLT(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
-  (void)op3;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
+  // An offset register allows waiting on a counter which increases with every iteration of the schedule.
   reg_t* var = op1.reg;
-  while (*var >= op2.imm)
-    ;
+  uint64_t threshold = op2.imm + (op3.reg != NULL ? *op3.reg : 0);
+  while (REG_LOAD(var) >= threshold) {
+    SPIN_WAIT_YIELD();
+  }
   *program_counter += 1; // Increment pc.
 }
 
 /**
  * @brief The implementation of the WU instruction
  */
-void execute_inst_WU(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                     size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_WU(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                     bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
-  (void)op3;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
+  // An offset register allows waiting on a counter which increases with every iteration of the schedule.
   reg_t* var = op1.reg;
-  while (*var < op2.imm)
-    ;
+  uint64_t threshold = op2.imm + (op3.reg != NULL ? *op3.reg : 0);
+  while (REG_LOAD(var) < threshold) {
+    SPIN_WAIT_YIELD();
+  }
   *program_counter += 1; // Increment pc.
 }
 
 /**
  * @brief The implementation of the JAL instruction
  */
-void execute_inst_JAL(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_JAL(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   // Use the destination register as the return address and, if the
   // destination register is not the zero register, store program_counter+1 in it.
@@ -260,13 +317,13 @@ void execute_inst_JAL(Platform* platform, size_t worker_number, operand_t op1, o
 /**
  * @brief The implementation of the JALR instruction
  */
-void execute_inst_JALR(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+void execute_inst_JALR(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
                        bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
   (void)exit_loop;
-  (void)platform;
+  (void)scheduler;
 
   // Use the destination register as the return address and, if the
   // destination register is not the zero register, store program_counter+1 in it.
@@ -281,8 +338,8 @@ void execute_inst_JALR(Platform* platform, size_t worker_number, operand_t op1,
 /**
  * @brief The implementation of the STP instruction
  */
-void execute_inst_STP(Platform* platform, size_t worker_number, operand_t op1, operand_t op2, operand_t op3, bool debug,
-                      size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
+void execute_inst_STP(StaticScheduler* scheduler, size_t worker_number, operand_t op1, operand_t op2, operand_t op3,
+                      bool debug, size_t* program_counter, Reaction** returned_reaction, bool* exit_loop) {
   (void)worker_number;
   (void)debug;
   (void)returned_reaction;
@@ -291,6 +348,6 @@ void execute_inst_STP(Platform* platform, size_t worker_number, operand_t op1, o
   (void)op1;
   (void)op2;
   (void)op3;
-  (void)platform;
+  (void)scheduler;
   *exit_loop = true;
 }
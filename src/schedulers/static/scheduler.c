@@ -3,12 +3,99 @@
 //
 
 #include "reactor-uc/scheduler.h"
+#include "reactor-uc/environment.h"
+#include "reactor-uc/logging.h"
 #include "reactor-uc/schedulers/static/instructions.h"
 #include "reactor-uc/schedulers/static/scheduler.h"
 
-Reaction* lf_sched_get_ready_reaction(StaticScheduler* scheduler, int worker_number) {
-  LF_PRINT_DEBUG("Worker %d inside lf_sched_get_ready_reaction", worker_number);
+#if SCHEDULER_STATIC_THREADED_DISPATCH
+/**
+ * @brief Interpret the schedule of @p worker_number with computed gotos. Each handler jumps straight to the handler of
+ * the next instruction through a table of label addresses indexed by the opcode, so there is neither a loop nor an
+ * indirect call per instruction. The handlers are the instruction functions inlined, so they only touch the operands
+ * they use.
+ */
+static Reaction* StaticScheduler_dispatch_threaded(StaticScheduler* scheduler, size_t worker_number) {
+  static const void* const handlers[] = {[ADD] = &&do_ADD, [ADDI] = &&do_ADDI, [ADV] = &&do_ADV, [ADVI] = &&do_ADVI,
+                                         [BEQ] = &&do_BEQ, [BGE] = &&do_BGE,   [BLT] = &&do_BLT, [BNE] = &&do_BNE,
+                                         [DU] = &&do_DU,   [EXE] = &&do_EXE,   [JAL] = &&do_JAL, [JALR] = &&do_JALR,
+                                         [STP] = &&do_STP, [WLT] = &&do_WLT,   [WU] = &&do_WU};
 
+  const inst_t* current_schedule = scheduler->static_schedule[worker_number];
+  Reaction* returned_reaction = NULL;
+  bool exit_loop = false;
+  size_t pc = scheduler->pc[worker_number];
+  const inst_t* inst;
+
+#define DISPATCH()                                                                                                     \
+  do {                                                                                                                 \
+    inst = &current_schedule[pc];                                                                                      \
+    goto *handlers[inst->opcode];                                                                                      \
+  } while (0)
+
+#define EXECUTE(Opcode)                                                                                                \
+  execute_inst_##Opcode(scheduler, worker_number, inst->op1, inst->op2, inst->op3, inst->debug, &pc,                   \
+                        &returned_reaction, &exit_loop)
+
+  DISPATCH();
+do_ADD:
+  EXECUTE(ADD);
+  DISPATCH();
+do_ADDI:
+  EXECUTE(ADDI);
+  DISPATCH();
+do_ADV:
+  EXECUTE(ADV);
+  DISPATCH();
+do_ADVI:
+  EXECUTE(ADVI);
+  DISPATCH();
+do_BEQ:
+  EXECUTE(BEQ);
+  DISPATCH();
+do_BGE:
+  EXECUTE(BGE);
+  DISPATCH();
+do_BLT:
+  EXECUTE(BLT);
+  DISPATCH();
+do_BNE:
+  EXECUTE(BNE);
+  DISPATCH();
+do_DU:
+  EXECUTE(DU);
+  DISPATCH();
+do_JAL:
+  EXECUTE(JAL);
+  DISPATCH();
+do_JALR:
+  EXECUTE(JALR);
+  DISPATCH();
+do_WLT:
+  EXECUTE(WLT);
+  DISPATCH();
+do_WU:
+  EXECUTE(WU);
+  DISPATCH();
+do_EXE:
+  // Only EXE and STP can leave the schedule.
+  EXECUTE(EXE);
+  if (!exit_loop) {
+    DISPATCH();
+  }
+  goto done;
+do_STP:
+  EXECUTE(STP);
+done:
+#undef DISPATCH
+#undef EXECUTE
+
+  scheduler->pc[worker_number] = pc;
+  return returned_reaction;
+}
+#else
+/** @brief Interpret the schedule of @p worker_number by calling the function of each instruction. */
+static Reaction* StaticScheduler_dispatch_call(StaticScheduler* scheduler, size_t worker_number) {
   const inst_t* current_schedule = scheduler->static_schedule[worker_number];
   Reaction* returned_reaction = NULL;
   bool exit_loop = false;
@@ -28,22 +115,287 @@ Reaction* lf_sched_get_ready_reaction(StaticScheduler* scheduler, int worker_num
     debug = current_schedule[*pc].debug;
 
     // Execute the current instruction
-    func(scheduler->env->platform, worker_number, op1, op2, op3, debug, pc, &returned_reaction, &exit_loop);
+    func(scheduler, worker_number, op1, op2, op3, debug, pc, &returned_reaction, &exit_loop);
   }
 
-  LF_PRINT_DEBUG("Worker %d leaves lf_sched_get_ready_reaction", worker_number);
   return returned_reaction;
 }
+#endif
+
+Reaction* lf_sched_get_ready_reaction(StaticScheduler* scheduler, size_t worker_number) {
+  LF_DEBUG(SCHED, "Worker %zu inside lf_sched_get_ready_reaction", worker_number);
+
+#if SCHEDULER_STATIC_THREADED_DISPATCH
+  Reaction* returned_reaction = StaticScheduler_dispatch_threaded(scheduler, worker_number);
+#else
+  Reaction* returned_reaction = StaticScheduler_dispatch_call(scheduler, worker_number);
+#endif
+
+  LF_DEBUG(SCHED, "Worker %zu leaves lf_sched_get_ready_reaction", worker_number);
+  return returned_reaction;
+}
+
+static bool StaticScheduler_is_reaction_inst(const inst_t* inst) {
+  return inst->opcode == EXE && inst->op1.reg == NULL;
+}
+
+void StaticScheduler_sort_by_level(inst_t* instructions, size_t size) {
+  // Insertion sort, which keeps the order of the schedule for reactions on the same level.
+  for (size_t i = 1; i < size; i++) {
+    if (!StaticScheduler_is_reaction_inst(&instructions[i])) {
+      continue;
+    }
+    inst_t inst = instructions[i];
+    int level = ((Reaction*)inst.op2.reg)->level;
+    size_t j = i;
+    while (j > 0 && StaticScheduler_is_reaction_inst(&instructions[j - 1]) &&
+           ((Reaction*)instructions[j - 1].op2.reg)->level > level) {
+      instructions[j] = instructions[j - 1];
+      j--;
+    }
+    instructions[j] = inst;
+  }
+}
+
+/**
+ * @brief Execute @p reaction unless its deadline has been violated, in which case its violation handler is executed.
+ */
+static void StaticScheduler_execute_reaction(StaticScheduler* self, Reaction* reaction) {
+  if (reaction->deadline_violation_handler != NULL) {
+    reaction->deadline_slack = lf_time_add(reaction->deadline, -self->env->get_lag(self->env));
+    if (reaction->deadline_slack <= 0) {
+      LF_WARN(SCHED, "Deadline violation detected for %s->reaction_%d", reaction->parent->name, reaction->index);
+      reaction->deadline_violation_handler(reaction);
+      return;
+    }
+  }
+
+  LF_DEBUG(SCHED, "Executing %s->reaction_%d", reaction->parent->name, reaction->index);
+  reaction->body(reaction);
+}
+
+/** @brief Execute the reactions the instructions of @p worker_number hand over until the STP instruction. */
+static void StaticScheduler_run_worker(StaticScheduler* self, size_t worker_number) {
+  Reaction* reaction;
+  while ((reaction = lf_sched_get_ready_reaction(self, worker_number)) != NULL) {
+    StaticScheduler_execute_reaction(self, reaction);
+  }
+}
+
+#if SCHEDULER_MAX_WORKERS > 1
+typedef struct {
+  StaticScheduler* scheduler;
+  size_t worker_number;
+} StaticWorkerArgs;
+
+static void* StaticScheduler_worker_thread(void* untyped_args) {
+  StaticWorkerArgs* args = (StaticWorkerArgs*)untyped_args;
+  StaticScheduler_run_worker(args->scheduler, args->worker_number);
+  return NULL;
+}
+#endif
+
+static void StaticScheduler_run(Scheduler* untyped_self) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+  LF_INFO(SCHED, "Running static schedule on %zu workers", self->num_workers);
+
+#if SCHEDULER_MAX_WORKERS > 1
+  StaticWorkerArgs args[SCHEDULER_MAX_WORKERS - 1];
+  for (size_t i = 1; i < self->num_workers; i++) {
+    args[i - 1].scheduler = self;
+    args[i - 1].worker_number = i;
+    validaten(pthread_create(&self->threads[i - 1], NULL, StaticScheduler_worker_thread, &args[i - 1]));
+  }
+#endif
+
+  // The thread which started the program is worker 0.
+  StaticScheduler_run_worker(self, 0);
+
+#if SCHEDULER_MAX_WORKERS > 1
+  for (size_t i = 1; i < self->num_workers; i++) {
+    validaten(pthread_join(self->threads[i - 1], NULL));
+  }
+#endif
+
+  self->super.running = false;
+  LF_INFO(SCHED, "Static schedule completed at " PRINTF_TIME, (instant_t)self->time_reg);
+}
+
+/**
+ * @brief The schedule executes timers and startup reactions itself, so the events the environment schedules for them
+ * at startup are dropped. Any other event cannot be handled without an event queue.
+ */
+static lf_ret_t StaticScheduler_schedule_at(Scheduler* untyped_self, Event* event) {
+  (void)untyped_self;
+  if (event->trigger->type == TRIG_TIMER || event->trigger->type == TRIG_STARTUP) {
+    return LF_OK;
+  }
+
+  LF_ERR(SCHED, "The StaticScheduler cannot schedule events for trigger %p", event->trigger);
+  return LF_INVALID_VALUE;
+}
+
+static lf_ret_t StaticScheduler_schedule_system_event_at(Scheduler* untyped_self, SystemEvent* event) {
+  (void)untyped_self;
+  (void)event;
+  LF_ERR(SCHED, "The StaticScheduler cannot schedule system events");
+  return LF_INVALID_VALUE;
+}
+
+static void StaticScheduler_step_clock(Scheduler* untyped_self, interval_t step) {
+  (void)untyped_self;
+  (void)step;
+}
+
+static void StaticScheduler_do_shutdown(Scheduler* untyped_self, tag_t stop_tag) {
+  (void)untyped_self;
+  (void)stop_tag;
+}
+
+/**
+ * @brief Lower the time of the last tag the schedule executes. The schedule checks `stop_time_reg` after advancing
+ * logical time, so the current tag is always completed.
+ */
+static void StaticScheduler_request_shutdown(Scheduler* untyped_self, tag_t shutdown_time, bool overwrite) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+  (void)overwrite;
+
+  if (shutdown_time.time < (instant_t)self->stop_time_reg) {
+    __atomic_store_n(&self->stop_time_reg, (uint64_t)shutdown_time.time, __ATOMIC_RELEASE);
+    LF_INFO(SCHED, "Shutdown requested, will stop at " PRINTF_TIME, shutdown_time.time);
+  }
+}
+
+static void StaticScheduler_register_for_cleanup_locked(StaticScheduler* self, Trigger* trigger) {
+  if (trigger->is_registered_for_cleanup) {
+    return;
+  }
+
+  if (self->cleanup_ll_head == NULL) {
+    self->cleanup_ll_head = trigger;
+    self->cleanup_ll_tail = trigger;
+  } else {
+    self->cleanup_ll_tail->next = trigger;
+    self->cleanup_ll_tail = trigger;
+  }
+  trigger->is_registered_for_cleanup = true;
+}
+
+static void StaticScheduler_register_for_cleanup(Scheduler* untyped_self, Trigger* trigger) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+
+  LF_DEBUG(SCHED, "Registering trigger %p for cleanup", trigger);
+#if SCHEDULER_MAX_WORKERS > 1
+  // Reactions executing on different workers can set ports concurrently.
+  pthread_mutex_lock(&self->cleanup_lock);
+  StaticScheduler_register_for_cleanup_locked(self, trigger);
+  pthread_mutex_unlock(&self->cleanup_lock);
+#else
+  StaticScheduler_register_for_cleanup_locked(self, trigger);
+#endif
+}
 
-void StaticScheduler_ctor(StaticScheduler* self, Environment* env, const inst_t** static_schedule) {
+static void StaticScheduler_clean_up_timestep(Scheduler* untyped_self) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+  LF_DEBUG(SCHED, "Cleaning up timestep for time " PRINTF_TIME, (instant_t)self->time_reg);
+  Trigger* cleanup_trigger = self->cleanup_ll_head;
+
+  while (cleanup_trigger) {
+    Trigger* this = cleanup_trigger;
+    this->cleanup(this);
+    this->is_registered_for_cleanup = false;
+    cleanup_trigger = this->next;
+    this->next = NULL;
+  }
+
+  self->cleanup_ll_head = NULL;
+  self->cleanup_ll_tail = NULL;
+  self->epoch++;
+}
+
+static void StaticScheduler_set_and_schedule_start_tag(Scheduler* untyped_self, instant_t start_time) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+
+  self->super.start_time = start_time;
+  self->start_time_reg = (uint64_t)start_time;
+  self->time_reg = (uint64_t)start_time;
+  self->stop_time_reg = (uint64_t)lf_time_add(start_time, self->super.duration);
+  self->super.running = true;
+}
+
+/**
+ * @brief The schedule decides which reactions to execute, so triggered reactions need not be queued. They are only
+ * stamped with the current epoch, which conditional EXE instructions check.
+ */
+static lf_ret_t StaticScheduler_add_to_reaction_queue(Scheduler* untyped_self, Reaction* reaction) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+  reaction->enqueued_epoch = self->epoch;
+  return LF_OK;
+}
+
+static tag_t StaticScheduler_current_tag(Scheduler* untyped_self) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+  return (tag_t){.time = (instant_t)self->time_reg, .microstep = 0};
+}
+
+static void StaticScheduler_prepare_timestep(Scheduler* untyped_self, tag_t tag) {
+  StaticScheduler* self = (StaticScheduler*)untyped_self;
+  self->time_reg = (uint64_t)tag.time;
+}
+
+static lf_ret_t StaticScheduler_cancel_event(Scheduler* untyped_self, Trigger* trigger, instant_t event_time) {
+  (void)untyped_self;
+  (void)trigger;
+  (void)event_time;
+  return LF_EVENT_NOT_FOUND;
+}
+
+static lf_ret_t StaticScheduler_replace_event_payload(Scheduler* untyped_self, Trigger* trigger, instant_t event_time,
+                                                      const void* new_value) {
+  (void)untyped_self;
+  (void)trigger;
+  (void)event_time;
+  (void)new_value;
+  return LF_EVENT_NOT_FOUND;
+}
+
+void StaticScheduler_ctor(StaticScheduler* self, Environment* env, const inst_t** static_schedule, size_t num_workers,
+                          interval_t duration) {
+  validate(num_workers > 0 && num_workers <= SCHEDULER_MAX_WORKERS);
   self->env = env;
   self->static_schedule = static_schedule;
+  self->num_workers = num_workers;
+  for (size_t i = 0; i < SCHEDULER_MAX_WORKERS; i++) {
+    self->pc[i] = 0;
+  }
+  self->cleanup_ll_head = NULL;
+  self->cleanup_ll_tail = NULL;
+  self->start_time_reg = 0;
+  self->stop_time_reg = (uint64_t)FOREVER;
+  self->time_reg = (uint64_t)NEVER;
+  self->epoch = 1; // Reactions start out with an epoch of 0, so none of them is triggered.
+#if SCHEDULER_MAX_WORKERS > 1
+  validaten(pthread_mutex_init(&self->cleanup_lock, NULL));
+#endif
+
+  self->super.running = false;
+  self->super.start_time = NEVER;
+  self->super.duration = duration;
+  self->super.keep_alive = false;
 
-  self->super->run = Scheduler_run;
-  self->super->do_shutdown_locked = Scheduler_do_shutdown_locked;
-  self->super->schedule_at = Scheduler_schedule_at;
-  self->super->schedule_at_locked = Scheduler_schedule_at_locked;
-  self->super->register_for_cleanup = Scheduler_register_for_cleanup;
-  self->super->request_shutdown = Scheduler_request_shutdown;
-  self->super->set_and_schedule_start_tag = Scheduler_set_and_schedule_start_tag;
+  self->super.run = StaticScheduler_run;
+  self->super.do_shutdown = StaticScheduler_do_shutdown;
+  self->super.schedule_at = StaticScheduler_schedule_at;
+  self->super.schedule_at_async = StaticScheduler_schedule_at;
+  self->super.schedule_system_event_at = StaticScheduler_schedule_system_event_at;
+  self->super.register_for_cleanup = StaticScheduler_register_for_cleanup;
+  self->super.request_shutdown = StaticScheduler_request_shutdown;
+  self->super.set_and_schedule_start_tag = StaticScheduler_set_and_schedule_start_tag;
+  self->super.add_to_reaction_queue = StaticScheduler_add_to_reaction_queue;
+  self->super.current_tag = StaticScheduler_current_tag;
+  self->super.prepare_timestep = StaticScheduler_prepare_timestep;
+  self->super.step_clock = StaticScheduler_step_clock;
+  self->super.cancel_event = StaticScheduler_cancel_event;
+  self->super.replace_event_payload = StaticScheduler_replace_event_payload;
+  self->clean_up_timestep = StaticScheduler_clean_up_timestep;
 }
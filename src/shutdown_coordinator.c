@@ -132,8 +132,8 @@ void ShutdownCoordinator_shutdown(ShutdownCoordinator* self, interval_t shutdown
 }
 
 void ShutdownCoordinator_ctor(ShutdownCoordinator* self, Environment* env, size_t longest_path, size_t payload_size,
-                              void* payload_buf, bool* payload_used_buf, size_t payload_buf_capacity) {
-  EventPayloadPool_ctor(&self->super.payload_pool, (char*)payload_buf, payload_used_buf, payload_size,
+                              void* payload_buf, size_t* payload_free_list_buf, size_t payload_buf_capacity) {
+  EventPayloadPool_ctor(&self->super.payload_pool, (char*)payload_buf, payload_free_list_buf, payload_size,
                         payload_buf_capacity, NUM_RESERVED_EVENTS);
   self->handle_message_callback = ShutdownCoordinator_handle_message_callback;
   self->shutdown = ShutdownCoordinator_shutdown;
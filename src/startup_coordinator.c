@@ -35,6 +35,11 @@ static lf_ret_t StartupCoordinator_connect_to_neighbors_blocking(StartupCoordina
   bool all_connected = false;
   interval_t wait_before_retry = NEVER;
   while (!all_connected) {
+    // Polled channels only make progress on connecting when they are polled.
+    if (self->env->poll_network_channels) {
+      self->env->poll_network_channels(self->env);
+    }
+
     // Wait time initialized to minimum value so we can find the maximum.
     all_connected = true;
     for (size_t i = 0; i < self->num_neighbours; i++) {
@@ -545,7 +550,7 @@ void StartupCoordinator_start(StartupCoordinator* self) {
 
 void StartupCoordinator_ctor(StartupCoordinator* self, Environment* env, NeighborState* neighbor_state,
                              size_t num_neighbors, size_t longest_path, JoiningPolicy joining_policy,
-                             size_t payload_size, void* payload_buf, bool* payload_used_buf,
+                             size_t payload_size, void* payload_buf, size_t* payload_free_list_buf,
                              size_t payload_buf_capacity) {
   validate(!(longest_path == 0 && num_neighbors > 0));
   self->env = env;
@@ -570,6 +575,6 @@ void StartupCoordinator_ctor(StartupCoordinator* self, Environment* env, Neighbo
   self->start = StartupCoordinator_start;
   self->connect_to_neighbors_blocking = StartupCoordinator_connect_to_neighbors_blocking;
   self->super.handle = StartupCoordinator_handle_system_event;
-  EventPayloadPool_ctor(&self->super.payload_pool, (char*)payload_buf, payload_used_buf, payload_size,
+  EventPayloadPool_ctor(&self->super.payload_pool, (char*)payload_buf, payload_free_list_buf, payload_size,
                         payload_buf_capacity, NUM_RESERVED_EVENTS);
 }
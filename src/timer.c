@@ -16,17 +16,8 @@ void Timer_prepare(Trigger* _self, Event* event) {
 }
 
 void Timer_cleanup(Trigger* _self) {
-  Timer* self = (Timer*)_self;
-  Environment* env = _self->parent->env;
-  Scheduler* sched = env->scheduler;
+  // The next firing of a periodic timer is armed by the TimerQueue of the scheduler when it fires.
   _self->is_present = false;
-
-  // Schedule next event unless it is a single-shot timer.
-  if (self->period > NEVER) {
-    tag_t next_tag = lf_delay_tag(sched->current_tag(sched), self->period);
-    Event event = EVENT_INIT(next_tag, _self, NULL);
-    sched->schedule_at(sched, &event);
-  }
 }
 
 void Timer_ctor(Timer* self, Reactor* parent, instant_t offset, interval_t period, Reaction** effects,
@@ -40,6 +31,10 @@ void Timer_ctor(Timer* self, Reactor* parent, instant_t offset, interval_t perio
   self->observers.reactions = observers;
   self->observers.size = observers_size;
   self->observers.num_registered = 0;
+  self->next_tag = NEVER_TAG;
+  self->group_next = NULL;
+  self->next_group = NULL;
+  self->fired_next = NULL;
 
   Trigger_ctor(&self->super, TRIG_TIMER, parent, NULL, Timer_prepare, Timer_cleanup);
 }
@@ -0,0 +1,58 @@
+#include "reactor-uc/token.h"
+#include "reactor-uc/logging.h"
+
+Token* TokenPool_acquire(TokenPool* self) {
+  void* slot;
+  if (self->slots.allocate(&self->slots, &slot) != LF_OK) {
+    LF_WARN(TRIG, "Token pool %p is exhausted. Capacity is %zu", self, self->slots.capacity);
+    return NULL;
+  }
+  Token* token = (Token*)slot;
+  token->pool = self;
+  token->ref_count = 0;
+  token->value = (char*)slot + self->value_offset;
+  return token;
+}
+
+Token* Token_retain(Token* self) {
+  if (self != NULL) {
+    MUTEX_LOCK(self->pool->mutex);
+    self->ref_count++;
+    MUTEX_UNLOCK(self->pool->mutex);
+  }
+  return self;
+}
+
+void Token_release(Token* self) {
+  if (self == NULL) {
+    return;
+  }
+  TokenPool* pool = self->pool;
+  MUTEX_LOCK(pool->mutex);
+  // A token which was acquired but never stored has no references, releasing it returns it right away.
+  bool last = self->ref_count <= 1;
+  if (self->ref_count > 0) {
+    self->ref_count--;
+  }
+  MUTEX_UNLOCK(pool->mutex);
+
+  if (last) {
+    validate(pool->slots.free(&pool->slots, self) == LF_OK);
+  }
+}
+
+void Token_assign(Token** slot, Token* token) {
+  Token* old = *slot;
+  if (old == token) {
+    return;
+  }
+  *slot = Token_retain(token);
+  Token_release(old);
+}
+
+void TokenPool_ctor(TokenPool* self, char* slots, size_t* free_list, size_t slot_size, size_t value_offset,
+                    size_t capacity) {
+  EventPayloadPool_ctor(&self->slots, slots, free_list, slot_size, capacity, 0);
+  self->value_offset = value_offset;
+  Mutex_ctor(&self->mutex.super);
+}
@@ -8,6 +8,29 @@
 set(LF_TEST_DIR ${CMAKE_CURRENT_LIST_DIR})
 set(LF_TEST_TIMEOUT 30 CACHE STRING "Default timeout in seconds for LF tests")
 
+# The runtime library the test executables are linked against. register_static_lf_test overrides it in its scope.
+set(LF_TEST_RUNTIME reactor-uc)
+
+# Programs annotated with @scheduler("STATIC") execute a generated schedule, so they are linked against a variant of
+# the runtime which only differs from reactor-uc in the scheduler. The unit tests define the same library when they
+# are built as well.
+if(NOT TARGET reactor-uc-static)
+  get_target_property(_REACTOR_UC_SOURCES reactor-uc SOURCES)
+  get_target_property(_REACTOR_UC_DEFINITIONS reactor-uc COMPILE_DEFINITIONS)
+  get_target_property(_REACTOR_UC_INCLUDE_DIRS reactor-uc INCLUDE_DIRECTORIES)
+  string(REPLACE "SCHEDULER_${SCHEDULER}" "SCHEDULER_STATIC"
+    _REACTOR_UC_STATIC_DEFINITIONS "${_REACTOR_UC_DEFINITIONS}")
+  add_library(reactor-uc-static STATIC ${_REACTOR_UC_SOURCES})
+  target_compile_definitions(reactor-uc-static PUBLIC ${_REACTOR_UC_STATIC_DEFINITIONS})
+  target_include_directories(reactor-uc-static PUBLIC ${_REACTOR_UC_INCLUDE_DIRS})
+  target_compile_options(reactor-uc-static PRIVATE -Wall -Wextra -Werror)
+  if (CMAKE_C_COMPILER_ID STREQUAL "GNU")
+    target_compile_options(reactor-uc-static PRIVATE -Wno-zero-length-bounds)
+  endif()
+  target_link_libraries(reactor-uc-static PRIVATE pthread nanopb)
+  set_target_properties(reactor-uc-static PROPERTIES C_CLANG_TIDY "") # The shared sources are checked through reactor-uc.
+endif()
+
 # Build one executable from a generated Include.cmake directory.
 # Optional extra arguments are added as additional include directories.
 function(lf_add_executable TARGET_NAME SRC_GEN_DIR)
@@ -19,7 +42,7 @@ function(lf_add_executable TARGET_NAME SRC_GEN_DIR)
   include(${SRC_GEN_DIR}/Include.cmake)
 
   add_executable(${TARGET_NAME} ${LFC_GEN_SOURCES} ${LFC_GEN_MAIN})
-  target_link_libraries(${TARGET_NAME} PRIVATE reactor-uc)
+  target_link_libraries(${TARGET_NAME} PRIVATE ${LF_TEST_RUNTIME})
   target_include_directories(${TARGET_NAME} PRIVATE ${LFC_GEN_INCLUDE_DIRS} ${ARGN})
   target_compile_definitions(${TARGET_NAME} PRIVATE ${LFC_GEN_COMPILE_DEFS})
   set_target_properties(${TARGET_NAME} PROPERTIES C_CLANG_TIDY "") # Disable clang-tidy on generated code
@@ -38,6 +61,13 @@ function(register_lf_test TEST_NAME SRC_GEN_DIR)
   lf_register_for_coverage(${TEST_NAME})
 endfunction()
 
+# Register a non-federated LF test target which executes a static schedule, see reactor-uc-static.
+# Optional extra arguments are forwarded as additional include directories.
+function(register_static_lf_test TEST_NAME SRC_GEN_DIR)
+  set(LF_TEST_RUNTIME reactor-uc-static)
+  register_lf_test(${TEST_NAME} ${SRC_GEN_DIR} ${ARGN})
+endfunction()
+
 # Register a federated LF test target (multiple federates launched via script).
 function(register_federated_lf_test TEST_NAME SRC_GEN_DIR)
   file(GLOB FEDERATE_CANDIDATES RELATIVE ${SRC_GEN_DIR} ${SRC_GEN_DIR}/*)
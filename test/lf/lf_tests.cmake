@@ -22,6 +22,7 @@ set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS
   ${LF_TEST_DIR}/src
   ${LF_TEST_DIR}/src/legacy
   ${LF_TEST_DIR}/src/federated
+  ${LF_TEST_DIR}/src/static
   ${LF_TEST_DIR}/src/only_build
   ${LF_TEST_DIR}/src/lf_package_imports
   ${LF_TEST_DIR}/src/lingo_imports
@@ -32,8 +33,9 @@ file(GLOB _MAIN_LF_FILES    ${LF_TEST_DIR}/src/*.ulf)
 file(GLOB _LEGACY_LF_FILES  ${LF_TEST_DIR}/src/legacy/*.ulf)
 file(GLOB _PACKAGE_LF_FILES ${LF_TEST_DIR}/src/lf_package_imports/*.ulf)
 file(GLOB _LINGO_LF_FILES   ${LF_TEST_DIR}/src/lingo_imports/*.ulf)
+file(GLOB _STATIC_LF_FILES  ${LF_TEST_DIR}/src/static/*.ulf)
 
-set(_BATCH_LF_FILES ${_MAIN_LF_FILES} ${_LEGACY_LF_FILES} ${_PACKAGE_LF_FILES} ${_LINGO_LF_FILES})
+set(_BATCH_LF_FILES ${_MAIN_LF_FILES} ${_LEGACY_LF_FILES} ${_PACKAGE_LF_FILES} ${_LINGO_LF_FILES} ${_STATIC_LF_FILES})
 # Track content edits even when skipping regeneration.
 set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${_BATCH_LF_FILES})
 if(NOT _LF_SKIP_GENERATE)
@@ -77,6 +79,12 @@ foreach(_LF_FILE ${_LINGO_LF_FILES})
   register_lf_test(${_TEST_NAME} ${LF_TEST_BUILD_DIR}/src-gen/lingo_imports/${_TEST_NAME})
 endforeach()
 
+# Static schedule tests (linked against the runtime compiled with the StaticScheduler)
+foreach(_LF_FILE ${_STATIC_LF_FILES})
+  get_filename_component(_TEST_NAME ${_LF_FILE} NAME_WE)
+  register_static_lf_test(${_TEST_NAME} ${LF_TEST_BUILD_DIR}/src-gen/static/${_TEST_NAME})
+endforeach()
+
 # Federated tests
 foreach(_LF_FILE ${_FED_LF_FILES})
   get_filename_component(_TEST_NAME ${_LF_FILE} NAME_WE)
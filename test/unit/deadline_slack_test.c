@@ -0,0 +1,96 @@
+#include "reactor-uc/reactor-uc.h"
+#include "reactor-uc/schedulers/dynamic/scheduler.h"
+#include "unity.h"
+
+#define NUM_WORKERS 2
+#define NUM_TAGS 4
+#define PERIOD MSEC(10)
+#define DEADLINE SEC(1)
+#define WORK MSEC(1)
+
+// The lag each worker reaction saw, in the order in which they executed.
+static interval_t lags[NUM_TAGS][NUM_WORKERS];
+static int executed[NUM_TAGS];
+
+LF_DEFINE_TIMER_STRUCT(Worker, t, 1, 0)
+LF_DEFINE_REACTION_STRUCT(Worker, reaction, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Worker, reaction);
+  LF_TIMER_INSTANCE(Worker, t);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+} Worker;
+
+LF_DEFINE_REACTION_BODY(Worker, reaction) {
+  LF_SCOPE_SELF(Worker);
+  LF_SCOPE_ENV();
+  int tag = (int)(env->get_elapsed_logical_time(env) / PERIOD);
+
+  // The first reaction of a tag switches the granularity, which takes effect at the next tag.
+  DynamicScheduler* scheduler = (DynamicScheduler*)env->scheduler;
+  if (executed[tag] == 0 && tag == 0) {
+    TEST_ASSERT_EQUAL(LF_OK, DynamicScheduler_set_deadline_check(scheduler, DEADLINE_CHECK_LEVEL));
+    // The workers must not overlap for the second one to see the work of the first.
+    TEST_ASSERT_EQUAL(LF_OK, DynamicScheduler_set_num_workers(scheduler, 1));
+  } else if (executed[tag] == 0 && tag == 2) {
+    TEST_ASSERT_EQUAL(LF_OK, DynamicScheduler_set_deadline_check(scheduler, DEADLINE_CHECK_REACTION));
+  }
+
+  lags[tag][executed[tag]++] = DEADLINE - lf_deadline_slack();
+
+  instant_t until = env->get_physical_time(env) + WORK;
+  while (env->get_physical_time(env) < until) {
+  }
+}
+
+LF_DEFINE_REACTION_DEADLINE_VIOLATION_HANDLER(Worker, reaction) { TEST_FAIL_MESSAGE("Deadline violated"); }
+
+LF_DEFINE_TIMER_CTOR(Worker, t, 1, 0)
+LF_DEFINE_REACTION_CTOR(Worker, reaction, 0, LF_REACTION_TYPE(Worker, reaction_deadline_violation_handler), NULL)
+
+LF_REACTOR_CTOR_SIGNATURE(Worker) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Worker);
+  LF_INITIALIZE_REACTION(Worker, reaction, DEADLINE);
+  LF_INITIALIZE_TIMER(Worker, t, MSEC(0), PERIOD);
+  LF_TIMER_REGISTER_EFFECT(self->t, self->reaction);
+}
+
+// Reactor main. The reactions of both workers are at level 0.
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Worker, worker, NUM_WORKERS);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, NUM_WORKERS);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+  LF_INITIALIZE_CHILD_REACTOR(Worker, worker, NUM_WORKERS);
+}
+
+LF_ENTRY_POINT(Main, 32, 32, PERIOD * (NUM_TAGS - 1), false, true);
+
+void test_run(void) {
+  lf_start();
+  for (int tag = 0; tag < NUM_TAGS; tag++) {
+    TEST_ASSERT_EQUAL(NUM_WORKERS, executed[tag]);
+    if (tag == 0) {
+      // Checked with the granularity the runtime was built with.
+      continue;
+    } else if (tag == 1 || tag == 2) {
+      // Sampled once for the level, before either worker started spinning.
+      TEST_ASSERT_EQUAL(lags[tag][0], lags[tag][1]);
+    } else {
+      // Sampled before each reaction, so the second one sees the work of the first.
+      TEST_ASSERT_TRUE(lags[tag][1] - lags[tag][0] >= WORK);
+    }
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_run);
+  return UNITY_END();
+}
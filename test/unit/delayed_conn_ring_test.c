@@ -0,0 +1,131 @@
+#include "reactor-uc/reactor-uc.h"
+#include "unity.h"
+
+#include <reactor-uc/schedulers/dynamic/scheduler.h>
+
+#define PERIOD MSEC(1)
+#define DELAY MSEC(20)
+#define TIMEOUT MSEC(100)
+
+// Components of Reactor Sender
+LF_DEFINE_TIMER_STRUCT(Sender, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Sender, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Sender, r_sender, 1);
+LF_DEFINE_REACTION_CTOR(Sender, r_sender, 0, NULL, NULL);
+LF_DEFINE_OUTPUT_STRUCT(Sender, out, 1, interval_t);
+LF_DEFINE_OUTPUT_CTOR(Sender, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sender, r_sender);
+  LF_TIMER_INSTANCE(Sender, t);
+  LF_PORT_INSTANCE(Sender, out, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 2, 0);
+} Sender;
+
+LF_DEFINE_REACTION_BODY(Sender, r_sender) {
+  LF_SCOPE_SELF(Sender);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Sender, out);
+  lf_set(out, env->get_elapsed_logical_time(env));
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sender, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sender);
+  LF_INITIALIZE_REACTION(Sender, r_sender, NEVER);
+  LF_INITIALIZE_TIMER(Sender, t, MSEC(0), PERIOD);
+  LF_INITIALIZE_OUTPUT(Sender, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->r_sender);
+  LF_PORT_REGISTER_SOURCE(self->out, self->r_sender, 1);
+}
+
+// Reactor Receiver
+LF_DEFINE_REACTION_STRUCT(Receiver, r_recv, 0)
+LF_DEFINE_REACTION_CTOR(Receiver, r_recv, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Receiver, in, 1, 0, interval_t, 0)
+LF_DEFINE_INPUT_CTOR(Receiver, in, 1, 0, interval_t, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Receiver, r_recv);
+  LF_PORT_INSTANCE(Receiver, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+  DelayedConnection* conn;
+  int count;
+} Receiver;
+
+LF_DEFINE_REACTION_BODY(Receiver, r_recv) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Receiver, in);
+  DynamicScheduler* sched = (DynamicScheduler*)env->scheduler;
+
+  TEST_ASSERT_EQUAL(in->value + DELAY, env->get_elapsed_logical_time(env));
+  // The values sent during the last DELAY wait in the ring of the connection, but only the next one has an event. At
+  // the stop tag, the values which would arrive after it are dropped instead.
+  TEST_ASSERT_NOT_NULL(self->conn->ring_tags);
+  if (env->get_elapsed_logical_time(env) < TIMEOUT) {
+    TEST_ASSERT_EQUAL(DELAY / PERIOD - 1, self->conn->ring_size);
+    TEST_ASSERT_EQUAL(1, sched->event_queue->size);
+  } else {
+    TEST_ASSERT_EQUAL(0, self->conn->ring_size);
+  }
+  self->count++;
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Receiver, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Receiver);
+  LF_INITIALIZE_REACTION(Receiver, r_recv, NEVER);
+  LF_INITIALIZE_INPUT(Receiver, in, 1, in_external);
+
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_recv, 1);
+  self->count = 0;
+}
+
+// Reactor main. The connection holds more values than the event queue has room for events.
+LF_DEFINE_DELAYED_CONNECTION_STRUCT(Main, sender_out, 1, interval_t, 32)
+LF_DEFINE_DELAYED_CONNECTION_CTOR(Main, sender_out, 1, 32, false)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sender, sender, 1);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, receiver, 1);
+  LF_DELAYED_CONNECTION_INSTANCE(Main, sender_out, 1, 1);
+
+  LF_CHILD_OUTPUT_CONNECTIONS(sender, out, 1, 1, 1);
+  LF_CHILD_OUTPUT_EFFECTS(sender, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(sender, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(receiver, in, 1, 1, 0);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 2);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(sender, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sender, sender, 1, &_sender_out_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(receiver, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, receiver, 1, &_receiver_in_args[0][0]);
+
+  LF_INITIALIZE_DELAYED_CONNECTION(Main, sender_out, DELAY, 1, 1);
+  lf_connect(&self->sender_out[0][0].super.super, &self->sender->out[0].super, &self->receiver->in[0].super);
+  self->receiver->conn = &self->sender_out[0][0].super;
+}
+
+LF_ENTRY_POINT(Main, 4, 32, TIMEOUT, false, true);
+
+void test_single_event_per_connection(void) {
+  lf_start();
+  TEST_ASSERT_EQUAL((TIMEOUT - DELAY) / PERIOD + 1, main_reactor.receiver->count);
+  TEST_ASSERT_EQUAL(0, main_reactor.sender_out[0][0].super.ring_size);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_single_event_per_connection);
+  return UNITY_END();
+}
@@ -10,9 +10,9 @@ void test_allocate_free(void) {
   lf_ret_t ret;
   EventPayloadPool t;
   int buffer[10];
-  bool used[10];
+  size_t free_list[10];
   int* payloads[10];
-  EventPayloadPool_ctor(&t, (void*)buffer, used, sizeof(int), 10, 0);
+  EventPayloadPool_ctor(&t, (void*)buffer, free_list, sizeof(int), 10, 0);
 
   for (int j = 0; j < 3; j++) {
     int val = 1;
@@ -34,9 +34,9 @@ void test_allocate_free(void) {
 void test_allocate_reserved(void) {
   EventPayloadPool t;
   int buffer[4];
-  bool used[4];
+  size_t free_list[4];
   void* payload;
-  EventPayloadPool_ctor(&t, (void*)&buffer, used, sizeof(int), 4, 2);
+  EventPayloadPool_ctor(&t, (void*)&buffer, free_list, sizeof(int), 4, 2);
   TEST_ASSERT_EQUAL(LF_OK, t.allocate_reserved(&t, &payload));
   TEST_ASSERT_EQUAL(LF_OK, t.allocate_reserved(&t, &payload));
   TEST_ASSERT_EQUAL(LF_VALUE_BUFFER_FULL, t.allocate_reserved(&t, &payload));
@@ -48,9 +48,9 @@ void test_allocate_reserved(void) {
 void test_allocate_full(void) {
   EventPayloadPool t;
   int buffer[2];
-  bool used[2];
+  size_t free_list[2];
   void* payload;
-  EventPayloadPool_ctor(&t, (void*)&buffer, used, sizeof(int), 2, 0);
+  EventPayloadPool_ctor(&t, (void*)&buffer, free_list, sizeof(int), 2, 0);
   TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &payload));
   TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &payload));
   TEST_ASSERT_EQUAL(LF_VALUE_BUFFER_FULL, t.allocate(&t, &payload));
@@ -59,13 +59,53 @@ void test_allocate_full(void) {
 void test_free_wrong(void) {
   EventPayloadPool t;
   int buffer[2];
-  bool used[2];
+  size_t free_list[2];
   void* payload;
 
-  EventPayloadPool_ctor(&t, (void*)&buffer, used, sizeof(int), 2, 0);
+  EventPayloadPool_ctor(&t, (void*)&buffer, free_list, sizeof(int), 2, 0);
   TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &payload));
   TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &payload));
-  TEST_ASSERT_EQUAL(LF_INVALID_VALUE, t.free(&t, (void*)&used));
+  TEST_ASSERT_EQUAL(LF_INVALID_VALUE, t.free(&t, (void*)&free_list));
+}
+
+void test_free_twice(void) {
+  EventPayloadPool t;
+  int buffer[2];
+  size_t free_list[2];
+  void* payload;
+
+  EventPayloadPool_ctor(&t, (void*)&buffer, free_list, sizeof(int), 2, 0);
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &payload));
+  TEST_ASSERT_EQUAL(LF_OK, t.free(&t, payload));
+  TEST_ASSERT_EQUAL(LF_INVALID_VALUE, t.free(&t, payload));
+  TEST_ASSERT_EQUAL(LF_INVALID_VALUE, t.free(&t, (char*)payload + 1));
+
+  // The pool is still consistent, both payloads can be allocated exactly once.
+  void* first;
+  void* second;
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &first));
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &second));
+  TEST_ASSERT_TRUE(first != second);
+  TEST_ASSERT_EQUAL(LF_VALUE_BUFFER_FULL, t.allocate(&t, &payload));
+}
+
+void test_free_reserved(void) {
+  EventPayloadPool t;
+  int buffer[4];
+  size_t free_list[4];
+  void* reserved;
+  void* payload;
+  EventPayloadPool_ctor(&t, (void*)&buffer, free_list, sizeof(int), 4, 2);
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate_reserved(&t, &reserved));
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate_reserved(&t, &payload));
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &payload));
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate(&t, &payload));
+
+  // A freed reserved payload is only handed out again by `allocate_reserved`.
+  TEST_ASSERT_EQUAL(LF_OK, t.free(&t, reserved));
+  TEST_ASSERT_EQUAL(LF_VALUE_BUFFER_FULL, t.allocate(&t, &payload));
+  TEST_ASSERT_EQUAL(LF_OK, t.allocate_reserved(&t, &payload));
+  TEST_ASSERT_EQUAL_PTR(reserved, payload);
 }
 
 Environment* _lf_environment = NULL;
@@ -75,5 +115,7 @@ int main(void) {
   RUN_TEST(test_allocate_full);
   RUN_TEST(test_allocate_reserved);
   RUN_TEST(test_free_wrong);
+  RUN_TEST(test_free_twice);
+  RUN_TEST(test_free_reserved);
   return UNITY_END();
 }
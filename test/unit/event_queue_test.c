@@ -2,6 +2,10 @@
 #include "unity.h"
 
 #include <stdio.h>
+#if EVENT_INGRESS_SIZE > 0 && defined(PLATFORM_POSIX)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #define QUEUE_SIZE 10
 #define N_INSERTS 5
@@ -33,6 +37,61 @@ static void assert_heap_invariant(EventQueue* q, UNITY_LINE_TYPE line) {
 }
 #define ASSERT_HEAP_INVARIANT(q) assert_heap_invariant((q), __LINE__)
 
+/**
+ * @brief Assert that every heap position is reachable through the index and that the index holds nothing else.
+ * Use through ASSERT_INDEX_CONSISTENT so failures point at the caller.
+ */
+static void assert_index_consistent(EventQueue* q, UNITY_LINE_TYPE line) {
+  size_t occupied = 0;
+  for (size_t slot = 0; slot < q->index_capacity; slot++) {
+    if (q->index[slot] != 0) {
+      occupied++;
+    }
+  }
+  UNITY_TEST_ASSERT_EQUAL_INT(q->size, occupied, line, "index does not hold exactly one slot per event");
+  for (size_t i = 0; i < q->size; i++) {
+    UNITY_TEST_ASSERT_EQUAL_INT(i + 1, q->index[q->index_pos[i]], line, "index slot does not point back");
+  }
+}
+#define ASSERT_INDEX_CONSISTENT(q) assert_index_consistent((q), __LINE__)
+
+/**
+ * @brief Assert the d-ary heap invariant on the key array, and that keys, heap positions and event bodies agree.
+ * Use through ASSERT_DARY_INVARIANT so failures point at the caller.
+ */
+static void assert_dary_invariant(DaryEventQueue* q, UNITY_LINE_TYPE line) {
+  for (size_t i = 0; i < q->super.size; i++) {
+    UNITY_TEST_ASSERT_EQUAL_INT(i, q->heap_pos[q->heap[i]], line, "heap_pos does not point back");
+    UNITY_TEST_ASSERT(lf_tag_compare(q->keys[i], get_tag(&q->super.array[q->heap[i]])) == 0, line,
+                      "key does not match the tag of its event");
+    if (i > 0) {
+      UNITY_TEST_ASSERT(lf_tag_compare(q->keys[(i - 1) / EVENT_QUEUE_DARY_ARITY], q->keys[i]) <= 0, line,
+                        "d-ary min-heap invariant violated");
+    }
+  }
+}
+#define ASSERT_DARY_INVARIANT(q) assert_dary_invariant((q), __LINE__)
+
+/**
+ * @brief Assert that no event in a RadixEventQueue is earlier than `last`, and that the bucket lists hold every event
+ * exactly once. Use through ASSERT_RADIX_INVARIANT so failures point at the caller.
+ */
+static void assert_radix_invariant(RadixEventQueue* q, UNITY_LINE_TYPE line) {
+  size_t linked = 0;
+  for (size_t b = 0; b < RADIX_EVENT_QUEUE_NUM_BUCKETS; b++) {
+    bool nonempty = (q->nonempty[b / 32] >> (b % 32)) & 1u;
+    UNITY_TEST_ASSERT(nonempty == (q->head[b] != SIZE_MAX), line, "bucket bitmap out of sync");
+    for (size_t body = q->head[b]; body != SIZE_MAX; body = q->next[body]) {
+      UNITY_TEST_ASSERT(body < q->super.size, line, "bucket links to a body outside the queue");
+      UNITY_TEST_ASSERT_EQUAL_INT(b, q->bucket[body], line, "body is linked into the wrong bucket");
+      UNITY_TEST_ASSERT(lf_tag_compare(q->last, get_tag(&q->super.array[body])) <= 0, line, "event earlier than last");
+      linked++;
+    }
+  }
+  UNITY_TEST_ASSERT_EQUAL_INT(q->super.size, linked, line, "buckets do not hold every event exactly once");
+}
+#define ASSERT_RADIX_INVARIANT(q) assert_radix_invariant((q), __LINE__)
+
 /**
  * @brief Drain the queue and assert the events come out with exactly @p expected times, and that the queue is empty
  * afterwards. Use through ASSERT_POPS_IN_ORDER so failures point at the caller.
@@ -474,6 +533,599 @@ void test_system_event_find_and_remove(void) {
   ASSERT_POPS_IN_ORDER(&q, expect);
 }
 
+void test_indexed_find_and_remove(void) {
+  // An indexed queue finds and removes events by trigger and tag, also when several events hash to nearby slots and
+  // when the same trigger has events at several tags.
+  EventQueue q;
+  ArbitraryEvent array[QUEUE_SIZE];
+  size_t index[2 * QUEUE_SIZE + 1];
+  size_t index_pos[QUEUE_SIZE];
+  EventQueue_ctor_indexed(&q, array, QUEUE_SIZE, index, index_pos, 2 * QUEUE_SIZE + 1);
+
+  for (size_t i = 0; i < QUEUE_SIZE / 2; i++) {
+    Event ea = EVENT_INIT(((tag_t){.time = (instant_t)(QUEUE_SIZE - i)}), &trigger_a, NULL);
+    Event eb = EVENT_INIT(((tag_t){.time = (instant_t)(QUEUE_SIZE - i), .microstep = 1}), &trigger_b, NULL);
+    TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &ea.super));
+    TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &eb.super));
+    ASSERT_INDEX_CONSISTENT(&q);
+  }
+  ASSERT_HEAP_INVARIANT(&q);
+
+  for (size_t i = 0; i < QUEUE_SIZE / 2; i++) {
+    instant_t t = (instant_t)(QUEUE_SIZE - i);
+    Event search = EVENT_INIT(((tag_t){.time = t, .microstep = 1}), &trigger_b, NULL);
+    ArbitraryEvent* found = q.find_equal_same_tag(&q, &search.super);
+    TEST_ASSERT_NOT_NULL(found);
+    TEST_ASSERT_EQUAL_PTR(&trigger_b, found->event.trigger);
+    TEST_ASSERT_EQUAL_INT64(t, get_tag(found).time);
+
+    // Same trigger at the wrong microstep is not a match.
+    search.super.tag.microstep = 0;
+    TEST_ASSERT_NULL(q.find_equal_same_tag(&q, &search.super));
+  }
+
+  // Remove every trigger_b event, from the middle of the heap outwards.
+  for (size_t i = 0; i < QUEUE_SIZE / 2; i++) {
+    instant_t t = (instant_t)(QUEUE_SIZE - ((i * 3) % (QUEUE_SIZE / 2)));
+    Event search = EVENT_INIT(((tag_t){.time = t, .microstep = 1}), &trigger_b, NULL);
+    TEST_ASSERT_EQUAL(LF_OK, q.remove(&q, &search.super));
+    TEST_ASSERT_EQUAL(LF_EVENT_NOT_FOUND, q.remove(&q, &search.super));
+    ASSERT_INDEX_CONSISTENT(&q);
+    ASSERT_HEAP_INVARIANT(&q);
+  }
+
+  TEST_ASSERT_TRUE(contains_time(&q, QUEUE_SIZE));
+  const instant_t expect[] = {6, 7, 8, 9, 10};
+  ASSERT_POPS_IN_ORDER(&q, expect);
+  ASSERT_INDEX_CONSISTENT(&q);
+}
+
+void test_indexed_build_heap(void) {
+  // build_heap on an indexed queue re-indexes events that were written straight into the backing array.
+  EventQueue q;
+  ArbitraryEvent array[QUEUE_SIZE];
+  size_t index[2 * QUEUE_SIZE + 1];
+  size_t index_pos[QUEUE_SIZE];
+  EventQueue_ctor_indexed(&q, array, QUEUE_SIZE, index, index_pos, 2 * QUEUE_SIZE + 1);
+
+  const instant_t unordered[] = {50, 10, 40, 30, 20};
+  for (size_t i = 0; i < ARRAY_SIZE(unordered); i++) {
+    array[i].event = (Event)EVENT_INIT(((tag_t){.time = unordered[i]}), &trigger_a, NULL);
+  }
+  q.size = ARRAY_SIZE(unordered);
+  q.build_heap(&q);
+  ASSERT_HEAP_INVARIANT(&q);
+  ASSERT_INDEX_CONSISTENT(&q);
+
+  TEST_ASSERT_EQUAL(LF_OK, remove_at_time(&q, 30));
+  TEST_ASSERT_FALSE(contains_time(&q, 30));
+  const instant_t expect[] = {10, 20, 40, 50};
+  ASSERT_POPS_IN_ORDER(&q, expect);
+}
+
+void test_indexed_matches_linear(void) {
+  // Drive an indexed and a plain queue through the same pseudo-random mix of inserts, removes and pops, and check
+  // that they agree on every result.
+#define STRESS_SIZE 64
+  static Trigger triggers[8];
+  EventQueue plain, indexed;
+  ArbitraryEvent plain_array[STRESS_SIZE];
+  ArbitraryEvent indexed_array[STRESS_SIZE];
+  size_t index[2 * STRESS_SIZE + 1];
+  size_t index_pos[STRESS_SIZE];
+  EventQueue_ctor(&plain, plain_array, STRESS_SIZE);
+  EventQueue_ctor_indexed(&indexed, indexed_array, STRESS_SIZE, index, index_pos, 2 * STRESS_SIZE + 1);
+
+  uint32_t seed = 12345;
+  for (int step = 0; step < 2000; step++) {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t r = seed >> 8;
+    Event e = EVENT_INIT(((tag_t){.time = (instant_t)(r % 16), .microstep = (r >> 4) % 2}), &triggers[(r >> 5) % 8],
+                         NULL);
+    switch (r % 3) {
+    case 0:
+      // Keep (trigger, tag) unique, as the scheduler does, so that both queues remove the very same event and their
+      // heap layouts never drift apart.
+      if (plain.find_equal_same_tag(&plain, &e.super) == NULL) {
+        TEST_ASSERT_EQUAL(plain.insert(&plain, &e.super), indexed.insert(&indexed, &e.super));
+      }
+      break;
+    case 1:
+      TEST_ASSERT_EQUAL(plain.remove(&plain, &e.super), indexed.remove(&indexed, &e.super));
+      break;
+    default: {
+      ArbitraryEvent out_plain, out_indexed;
+      lf_ret_t ret = plain.pop(&plain, &out_plain.event.super);
+      TEST_ASSERT_EQUAL(ret, indexed.pop(&indexed, &out_indexed.event.super));
+      if (ret == LF_OK) {
+        TEST_ASSERT_EQUAL_PTR(out_plain.event.trigger, out_indexed.event.trigger);
+      }
+      break;
+    }
+    }
+    TEST_ASSERT_EQUAL(plain.size, indexed.size);
+    TEST_ASSERT_EQUAL(0, lf_tag_compare(plain.next_tag(&plain), indexed.next_tag(&indexed)));
+    TEST_ASSERT_EQUAL(plain.find_equal_same_tag(&plain, &e.super) != NULL,
+                      indexed.find_equal_same_tag(&indexed, &e.super) != NULL);
+    ASSERT_HEAP_INVARIANT(&indexed);
+    ASSERT_INDEX_CONSISTENT(&indexed);
+  }
+#undef STRESS_SIZE
+}
+
+void test_dary_insert_pop(void) {
+  // Events inserted in any order come out of a DaryEventQueue ordered by time, then microstep.
+  DaryEventQueue q;
+  ArbitraryEvent array[QUEUE_SIZE];
+  tag_t keys[QUEUE_SIZE];
+  size_t heap[QUEUE_SIZE];
+  size_t heap_pos[QUEUE_SIZE];
+  DaryEventQueue_ctor(&q, array, QUEUE_SIZE, keys, heap, heap_pos, NULL, NULL, 0);
+
+  TEST_ASSERT_TRUE(q.super.empty(&q.super));
+  TEST_ASSERT_EQUAL(0, lf_tag_compare(q.super.next_tag(&q.super), FOREVER_TAG));
+
+  for (size_t i = N_INSERTS; i > 0; i--) {
+    for (size_t j = 2; j > 0; j--) {
+      Event e = {.super.tag = {.time = (instant_t)(i - 1) * 10, .microstep = (microstep_t)(j - 1)}};
+      TEST_ASSERT_EQUAL(LF_OK, q.super.insert(&q.super, &e.super));
+      ASSERT_DARY_INVARIANT(&q);
+    }
+  }
+  Event e = {.super.tag = {.time = 0}};
+  TEST_ASSERT_EQUAL(LF_EVENT_QUEUE_FULL, q.super.insert(&q.super, &e.super));
+
+  Event out;
+  for (size_t i = 0; i < N_INSERTS; i++) {
+    for (size_t j = 0; j < 2; j++) {
+      TEST_ASSERT_EQUAL(LF_OK, q.super.pop(&q.super, &out.super));
+      TEST_ASSERT_EQUAL_INT64((instant_t)i * 10, out.super.tag.time);
+      TEST_ASSERT_EQUAL(j, out.super.tag.microstep);
+      ASSERT_DARY_INVARIANT(&q);
+    }
+  }
+  TEST_ASSERT_TRUE(q.super.empty(&q.super));
+  TEST_ASSERT_EQUAL(LF_EVENT_QUEUE_EMPTY, q.super.pop(&q.super, &out.super));
+}
+
+void test_dary_find_and_remove(void) {
+  // Removing events from a DaryEventQueue keeps the bodies compact and the heap valid, with and without the index.
+  for (int indexed = 0; indexed < 2; indexed++) {
+    DaryEventQueue q;
+    ArbitraryEvent array[QUEUE_SIZE];
+    tag_t keys[QUEUE_SIZE];
+    size_t heap[QUEUE_SIZE];
+    size_t heap_pos[QUEUE_SIZE];
+    size_t index[2 * QUEUE_SIZE + 1];
+    size_t index_pos[QUEUE_SIZE];
+    DaryEventQueue_ctor(&q, array, QUEUE_SIZE, keys, heap, heap_pos, indexed ? index : NULL,
+                        indexed ? index_pos : NULL, indexed ? 2 * QUEUE_SIZE + 1 : 0);
+    EventQueue* eq = &q.super;
+
+    const instant_t layout[] = {5, 9, 1, 7, 3, 8, 2, 6, 4};
+    for (size_t i = 0; i < ARRAY_SIZE(layout); i++) {
+      insert_at_time(eq, layout[i]);
+    }
+    ASSERT_DARY_INVARIANT(&q);
+
+    SystemEvent s1 = SYSTEM_EVENT_INIT(((tag_t){.time = 5}), &handler_a, NULL);
+    TEST_ASSERT_EQUAL(LF_OK, eq->insert(eq, &s1.super));
+    TEST_ASSERT_NOT_NULL(eq->find_equal_same_tag(eq, &s1.super));
+
+    const instant_t removals[] = {7, 1, 9, 4};
+    for (size_t i = 0; i < ARRAY_SIZE(removals); i++) {
+      TEST_ASSERT_EQUAL(LF_OK, remove_at_time(eq, removals[i]));
+      TEST_ASSERT_EQUAL(LF_EVENT_NOT_FOUND, remove_at_time(eq, removals[i]));
+      TEST_ASSERT_FALSE(contains_time(eq, removals[i]));
+      ASSERT_DARY_INVARIANT(&q);
+      if (indexed) {
+        ASSERT_INDEX_CONSISTENT(eq);
+      }
+    }
+    TEST_ASSERT_EQUAL(LF_OK, eq->remove(eq, &s1.super));
+    TEST_ASSERT_TRUE(contains_time(eq, 5));
+
+    Event search = EVENT_INIT(((tag_t){.time = 8}), &trigger_a, NULL);
+    ArbitraryEvent* found = eq->find_equal_same_tag(eq, &search.super);
+    TEST_ASSERT_NOT_NULL(found);
+    TEST_ASSERT_EQUAL_INT64(8, get_tag(found).time);
+
+    const instant_t expect[] = {2, 3, 5, 6, 8};
+    ASSERT_POPS_IN_ORDER(eq, expect);
+  }
+}
+
+void test_dary_build_heap(void) {
+  // build_heap orders event bodies that were written straight into the backing array of a DaryEventQueue.
+  DaryEventQueue q;
+  ArbitraryEvent array[QUEUE_SIZE];
+  tag_t keys[QUEUE_SIZE];
+  size_t heap[QUEUE_SIZE];
+  size_t heap_pos[QUEUE_SIZE];
+  DaryEventQueue_ctor(&q, array, QUEUE_SIZE, keys, heap, heap_pos, NULL, NULL, 0);
+
+  const instant_t unordered[] = {50, 10, 90, 40, 30, 70, 20, 60, 80};
+  for (size_t i = 0; i < ARRAY_SIZE(unordered); i++) {
+    array[i].event = (Event)EVENT_INIT(((tag_t){.time = unordered[i]}), &trigger_a, NULL);
+  }
+  q.super.size = ARRAY_SIZE(unordered);
+  q.super.build_heap(&q.super);
+  ASSERT_DARY_INVARIANT(&q);
+
+  const instant_t expect[] = {10, 20, 30, 40, 50, 60, 70, 80, 90};
+  ASSERT_POPS_IN_ORDER(&q.super, expect);
+}
+
+void test_dary_matches_binary(void) {
+  // Drive a DaryEventQueue and the binary EventQueue through the same pseudo-random operations. Events with equal
+  // tags may pop in a different order, so only tags and membership are compared.
+#define STRESS_SIZE 64
+  static Trigger triggers[8];
+  EventQueue binary;
+  DaryEventQueue dary;
+  ArbitraryEvent binary_array[STRESS_SIZE];
+  ArbitraryEvent dary_array[STRESS_SIZE];
+  tag_t keys[STRESS_SIZE];
+  size_t heap[STRESS_SIZE];
+  size_t heap_pos[STRESS_SIZE];
+  size_t index[2 * STRESS_SIZE + 1];
+  size_t index_pos[STRESS_SIZE];
+  EventQueue_ctor(&binary, binary_array, STRESS_SIZE);
+  DaryEventQueue_ctor(&dary, dary_array, STRESS_SIZE, keys, heap, heap_pos, index, index_pos, 2 * STRESS_SIZE + 1);
+  EventQueue* dq = &dary.super;
+
+  uint32_t seed = 4242;
+  for (int step = 0; step < 4000; step++) {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t r = seed >> 8;
+    Event e = EVENT_INIT(((tag_t){.time = (instant_t)(r % 32), .microstep = (r >> 5) % 2}), &triggers[(r >> 6) % 8],
+                         NULL);
+    switch (r % 4) {
+    case 0:
+    case 1:
+      if (binary.find_equal_same_tag(&binary, &e.super) == NULL) {
+        TEST_ASSERT_EQUAL(binary.insert(&binary, &e.super), dq->insert(dq, &e.super));
+      }
+      break;
+    case 2:
+      TEST_ASSERT_EQUAL(binary.remove(&binary, &e.super), dq->remove(dq, &e.super));
+      break;
+    default: {
+      ArbitraryEvent out_binary, out_dary;
+      lf_ret_t ret = binary.pop(&binary, &out_binary.event.super);
+      TEST_ASSERT_EQUAL(ret, dq->pop(dq, &out_dary.event.super));
+      if (ret == LF_OK) {
+        TEST_ASSERT_EQUAL(0, lf_tag_compare(get_tag(&out_binary), get_tag(&out_dary)));
+        // Keep both queues holding the same set of events.
+        binary.insert(&binary, &out_binary.event.super);
+        binary.remove(&binary, &out_dary.event.super);
+      }
+      break;
+    }
+    }
+    TEST_ASSERT_EQUAL(binary.size, dq->size);
+    TEST_ASSERT_EQUAL(0, lf_tag_compare(binary.next_tag(&binary), dq->next_tag(dq)));
+    TEST_ASSERT_EQUAL(binary.find_equal_same_tag(&binary, &e.super) != NULL,
+                      dq->find_equal_same_tag(dq, &e.super) != NULL);
+    ASSERT_DARY_INVARIANT(&dary);
+    ASSERT_INDEX_CONSISTENT(dq);
+  }
+#undef STRESS_SIZE
+}
+
+void test_radix_insert_pop(void) {
+  // A RadixEventQueue pops events ordered by time, then microstep, including negative times and events inserted
+  // behind the last popped tag.
+  RadixEventQueue q;
+  ArbitraryEvent array[QUEUE_SIZE];
+  size_t next[QUEUE_SIZE];
+  size_t prev[QUEUE_SIZE];
+  uint8_t bucket[QUEUE_SIZE];
+  RadixEventQueue_ctor(&q, array, QUEUE_SIZE, next, prev, bucket, NULL, NULL, 0);
+  EventQueue* eq = &q.super;
+
+  TEST_ASSERT_TRUE(eq->empty(eq));
+  TEST_ASSERT_EQUAL(0, lf_tag_compare(eq->next_tag(eq), FOREVER_TAG));
+
+  const tag_t tags[] = {{.time = 30, .microstep = 1}, {.time = -5}, {.time = 30}, {.time = FOREVER}, {.time = 7},
+                        {.time = 30, .microstep = 2}};
+  for (size_t i = 0; i < ARRAY_SIZE(tags); i++) {
+    Event e = EVENT_INIT(tags[i], &trigger_a, NULL);
+    TEST_ASSERT_EQUAL(LF_OK, eq->insert(eq, &e.super));
+    ASSERT_RADIX_INVARIANT(&q);
+  }
+
+  Event out;
+  TEST_ASSERT_EQUAL_INT64(-5, eq->next_tag(eq).time);
+  TEST_ASSERT_EQUAL(LF_OK, eq->pop(eq, &out.super));
+  TEST_ASSERT_EQUAL_INT64(-5, out.super.tag.time);
+  TEST_ASSERT_EQUAL(LF_OK, eq->pop(eq, &out.super));
+  TEST_ASSERT_EQUAL_INT64(7, out.super.tag.time);
+  ASSERT_RADIX_INVARIANT(&q);
+
+  // Inserting behind the last popped tag is not monotone, but must still be ordered correctly.
+  insert_at_time(eq, 3);
+  ASSERT_RADIX_INVARIANT(&q);
+  TEST_ASSERT_EQUAL_INT64(3, eq->next_tag(eq).time);
+  TEST_ASSERT_EQUAL(LF_OK, eq->pop(eq, &out.super));
+  TEST_ASSERT_EQUAL_INT64(3, out.super.tag.time);
+
+  for (microstep_t m = 0; m < 3; m++) {
+    TEST_ASSERT_EQUAL(LF_OK, eq->pop(eq, &out.super));
+    TEST_ASSERT_EQUAL_INT64(30, out.super.tag.time);
+    TEST_ASSERT_EQUAL(m, out.super.tag.microstep);
+    ASSERT_RADIX_INVARIANT(&q);
+  }
+  TEST_ASSERT_EQUAL(LF_OK, eq->pop(eq, &out.super));
+  TEST_ASSERT_EQUAL_INT64(FOREVER, out.super.tag.time);
+  TEST_ASSERT_TRUE(eq->empty(eq));
+  TEST_ASSERT_EQUAL(LF_EVENT_QUEUE_EMPTY, eq->pop(eq, &out.super));
+}
+
+void test_radix_find_and_remove(void) {
+  // Removing events from a RadixEventQueue keeps the bodies compact and the buckets valid, with and without the index.
+  for (int indexed = 0; indexed < 2; indexed++) {
+    RadixEventQueue q;
+    ArbitraryEvent array[QUEUE_SIZE];
+    size_t next[QUEUE_SIZE];
+    size_t prev[QUEUE_SIZE];
+    uint8_t bucket[QUEUE_SIZE];
+    size_t index[2 * QUEUE_SIZE + 1];
+    size_t index_pos[QUEUE_SIZE];
+    RadixEventQueue_ctor(&q, array, QUEUE_SIZE, next, prev, bucket, indexed ? index : NULL, indexed ? index_pos : NULL,
+                         indexed ? 2 * QUEUE_SIZE + 1 : 0);
+    EventQueue* eq = &q.super;
+
+    const instant_t layout[] = {5, 9, 1, 7, 3, 8, 2, 6, 4};
+    for (size_t i = 0; i < ARRAY_SIZE(layout); i++) {
+      insert_at_time(eq, layout[i]);
+    }
+    TEST_ASSERT_EQUAL_INT64(1, eq->next_tag(eq).time);
+
+    SystemEvent s1 = SYSTEM_EVENT_INIT(((tag_t){.time = 5}), &handler_a, NULL);
+    TEST_ASSERT_EQUAL(LF_OK, eq->insert(eq, &s1.super));
+    TEST_ASSERT_NOT_NULL(eq->find_equal_same_tag(eq, &s1.super));
+
+    const instant_t removals[] = {7, 1, 9, 4};
+    for (size_t i = 0; i < ARRAY_SIZE(removals); i++) {
+      TEST_ASSERT_EQUAL(LF_OK, remove_at_time(eq, removals[i]));
+      TEST_ASSERT_EQUAL(LF_EVENT_NOT_FOUND, remove_at_time(eq, removals[i]));
+      TEST_ASSERT_FALSE(contains_time(eq, removals[i]));
+      ASSERT_RADIX_INVARIANT(&q);
+      if (indexed) {
+        ASSERT_INDEX_CONSISTENT(eq);
+      }
+    }
+    TEST_ASSERT_EQUAL(LF_OK, eq->remove(eq, &s1.super));
+    TEST_ASSERT_TRUE(contains_time(eq, 5));
+
+    const instant_t expect[] = {2, 3, 5, 6, 8};
+    ASSERT_POPS_IN_ORDER(eq, expect);
+  }
+}
+
+void test_radix_build_heap(void) {
+  // build_heap buckets event bodies that were written straight into the backing array of a RadixEventQueue.
+  RadixEventQueue q;
+  ArbitraryEvent array[QUEUE_SIZE];
+  size_t next[QUEUE_SIZE];
+  size_t prev[QUEUE_SIZE];
+  uint8_t bucket[QUEUE_SIZE];
+  RadixEventQueue_ctor(&q, array, QUEUE_SIZE, next, prev, bucket, NULL, NULL, 0);
+
+  const instant_t unordered[] = {50, 10, 90, 40, 30, 70, 20, 60, 80};
+  for (size_t i = 0; i < ARRAY_SIZE(unordered); i++) {
+    array[i].event = (Event)EVENT_INIT(((tag_t){.time = unordered[i]}), &trigger_a, NULL);
+  }
+  q.super.size = ARRAY_SIZE(unordered);
+  q.super.build_heap(&q.super);
+  ASSERT_RADIX_INVARIANT(&q);
+
+  const instant_t expect[] = {10, 20, 30, 40, 50, 60, 70, 80, 90};
+  ASSERT_POPS_IN_ORDER(&q.super, expect);
+}
+
+void test_radix_matches_binary(void) {
+  // Drive a RadixEventQueue and the binary EventQueue through the same pseudo-random operations, mostly monotone as
+  // in the scheduler, with the occasional insert behind the last popped tag. Only tags and membership are compared.
+#define STRESS_SIZE 64
+  static Trigger triggers[8];
+  EventQueue binary;
+  RadixEventQueue radix;
+  ArbitraryEvent binary_array[STRESS_SIZE];
+  ArbitraryEvent radix_array[STRESS_SIZE];
+  size_t next[STRESS_SIZE];
+  size_t prev[STRESS_SIZE];
+  uint8_t bucket[STRESS_SIZE];
+  size_t index[2 * STRESS_SIZE + 1];
+  size_t index_pos[STRESS_SIZE];
+  EventQueue_ctor(&binary, binary_array, STRESS_SIZE);
+  RadixEventQueue_ctor(&radix, radix_array, STRESS_SIZE, next, prev, bucket, index, index_pos, 2 * STRESS_SIZE + 1);
+  EventQueue* rq = &radix.super;
+
+  instant_t now = 0;
+  uint32_t seed = 777;
+  for (int step = 0; step < 4000; step++) {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t r = seed >> 8;
+    instant_t t = (r % 16 == 0) ? now - (instant_t)(r % 5) : now + (instant_t)(r % 64);
+    Event e = EVENT_INIT(((tag_t){.time = t, .microstep = (r >> 6) % 3}), &triggers[(r >> 8) % 8], NULL);
+    switch (r % 4) {
+    case 0:
+    case 1:
+      if (binary.find_equal_same_tag(&binary, &e.super) == NULL) {
+        TEST_ASSERT_EQUAL(binary.insert(&binary, &e.super), rq->insert(rq, &e.super));
+      }
+      break;
+    case 2:
+      TEST_ASSERT_EQUAL(binary.remove(&binary, &e.super), rq->remove(rq, &e.super));
+      break;
+    default: {
+      ArbitraryEvent out_binary, out_radix;
+      lf_ret_t ret = binary.pop(&binary, &out_binary.event.super);
+      TEST_ASSERT_EQUAL(ret, rq->pop(rq, &out_radix.event.super));
+      if (ret == LF_OK) {
+        TEST_ASSERT_EQUAL(0, lf_tag_compare(get_tag(&out_binary), get_tag(&out_radix)));
+        binary.insert(&binary, &out_binary.event.super);
+        binary.remove(&binary, &out_radix.event.super);
+        now = get_tag(&out_radix).time;
+      }
+      break;
+    }
+    }
+    TEST_ASSERT_EQUAL(binary.size, rq->size);
+    TEST_ASSERT_EQUAL(0, lf_tag_compare(binary.next_tag(&binary), rq->next_tag(rq)));
+    TEST_ASSERT_EQUAL(binary.find_equal_same_tag(&binary, &e.super) != NULL,
+                      rq->find_equal_same_tag(rq, &e.super) != NULL);
+    ASSERT_RADIX_INVARIANT(&radix);
+    ASSERT_INDEX_CONSISTENT(rq);
+  }
+#undef STRESS_SIZE
+}
+
+static void assert_pop_all_at_tag(EventQueue* q, UNITY_LINE_TYPE line) {
+  const instant_t times[] = {5, 3, 3, 7, 3, 5, 3};
+  for (size_t i = 0; i < ARRAY_SIZE(times); i++) {
+    insert_at_time(q, times[i]);
+  }
+
+  ArbitraryEvent out[QUEUE_SIZE];
+  tag_t tag_3 = {.time = 3};
+  tag_t tag_5 = {.time = 5};
+  // Only events at the head tag are popped.
+  UNITY_TEST_ASSERT_EQUAL_INT(0, q->pop_all_at_tag(q, tag_5, out, QUEUE_SIZE), line, "popped behind the head");
+
+  // A full batch leaves the remaining events at the tag in the queue.
+  UNITY_TEST_ASSERT_EQUAL_INT(3, q->pop_all_at_tag(q, tag_3, out, 3), line, "first batch at 3");
+  for (size_t i = 0; i < 3; i++) {
+    UNITY_TEST_ASSERT_EQUAL_INT(3, get_tag(&out[i]).time, line, "first batch at 3");
+  }
+  UNITY_TEST_ASSERT_EQUAL_INT(1, q->pop_all_at_tag(q, tag_3, out, 3), line, "second batch at 3");
+  UNITY_TEST_ASSERT_EQUAL_INT(3, get_tag(&out[0]).time, line, "second batch at 3");
+
+  UNITY_TEST_ASSERT_EQUAL_INT(2, q->pop_all_at_tag(q, tag_5, out, QUEUE_SIZE), line, "batch at 5");
+  UNITY_TEST_ASSERT_EQUAL_INT(5, get_tag(&out[0]).time, line, "batch at 5");
+  UNITY_TEST_ASSERT_EQUAL_INT(5, get_tag(&out[1]).time, line, "batch at 5");
+  UNITY_TEST_ASSERT_EQUAL_INT(1, q->size, line, "size after batches");
+  UNITY_TEST_ASSERT_EQUAL_INT(7, q->next_tag(q).time, line, "head after batches");
+}
+#define ASSERT_POP_ALL_AT_TAG(q) assert_pop_all_at_tag((q), __LINE__)
+
+void test_pop_all_at_tag(void) {
+  // Every EventQueue implementation pops the events at the head tag in batches.
+  EventQueue binary;
+  ArbitraryEvent binary_array[QUEUE_SIZE];
+  EventQueue_ctor(&binary, binary_array, QUEUE_SIZE);
+  ASSERT_POP_ALL_AT_TAG(&binary);
+  ASSERT_HEAP_INVARIANT(&binary);
+
+  EventQueue indexed;
+  ArbitraryEvent indexed_array[QUEUE_SIZE];
+  size_t index[2 * QUEUE_SIZE + 1];
+  size_t index_pos[QUEUE_SIZE];
+  EventQueue_ctor_indexed(&indexed, indexed_array, QUEUE_SIZE, index, index_pos, 2 * QUEUE_SIZE + 1);
+  ASSERT_POP_ALL_AT_TAG(&indexed);
+  ASSERT_INDEX_CONSISTENT(&indexed);
+
+  DaryEventQueue dary;
+  ArbitraryEvent dary_array[QUEUE_SIZE];
+  tag_t keys[QUEUE_SIZE];
+  size_t heap[QUEUE_SIZE];
+  size_t heap_pos[QUEUE_SIZE];
+  DaryEventQueue_ctor(&dary, dary_array, QUEUE_SIZE, keys, heap, heap_pos, NULL, NULL, 0);
+  ASSERT_POP_ALL_AT_TAG(&dary.super);
+  ASSERT_DARY_INVARIANT(&dary);
+
+  RadixEventQueue radix;
+  ArbitraryEvent radix_array[QUEUE_SIZE];
+  size_t next[QUEUE_SIZE];
+  size_t prev[QUEUE_SIZE];
+  uint8_t bucket[QUEUE_SIZE];
+  RadixEventQueue_ctor(&radix, radix_array, QUEUE_SIZE, next, prev, bucket, NULL, NULL, 0);
+  ASSERT_POP_ALL_AT_TAG(&radix.super);
+  ASSERT_RADIX_INVARIANT(&radix);
+}
+
+#if EVENT_INGRESS_SIZE > 0
+void test_ingress_fifo(void) {
+  // The ingress queue is FIFO, rejects pushes when full and keeps working after its positions wrap around the ring.
+  IngressQueue q;
+  IngressSlot slots[4];
+  IngressQueue_ctor(&q, slots, 4);
+
+  Event out;
+  TEST_ASSERT_FALSE(q.pop(&q, &out));
+  instant_t next_push = 0;
+  instant_t next_pop = 0;
+  for (size_t round = 0; round < 3; round++) {
+    while (true) {
+      Event e = EVENT_INIT(((tag_t){.time = next_push}), &trigger_a, NULL);
+      if (q.push(&q, &e) != LF_OK) {
+        break;
+      }
+      next_push++;
+    }
+    TEST_ASSERT_EQUAL_INT64(next_pop + 4, next_push);
+    // Pop a few and push more, so that the events cross the end of the ring.
+    for (size_t i = 0; i < 3; i++) {
+      TEST_ASSERT_TRUE(q.pop(&q, &out));
+      TEST_ASSERT_EQUAL_INT64(next_pop++, out.super.tag.time);
+      TEST_ASSERT_EQUAL_PTR(&trigger_a, out.trigger);
+    }
+  }
+  while (q.pop(&q, &out)) {
+    TEST_ASSERT_EQUAL_INT64(next_pop++, out.super.tag.time);
+  }
+  TEST_ASSERT_EQUAL_INT64(next_push, next_pop);
+}
+
+#if defined(PLATFORM_POSIX)
+#define INGRESS_PRODUCERS 4
+#define INGRESS_EVENTS_PER_PRODUCER 20000
+
+static IngressQueue ingress;
+
+static void* ingress_producer(void* arg) {
+  instant_t producer = (instant_t)(size_t)arg;
+  for (instant_t i = 0; i < INGRESS_EVENTS_PER_PRODUCER; i++) {
+    Event e = EVENT_INIT(((tag_t){.time = producer, .microstep = (microstep_t)i}), &trigger_a, NULL);
+    while (ingress.push(&ingress, &e) != LF_OK) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+void test_ingress_concurrent_producers(void) {
+  // Events of concurrent producers are neither lost nor duplicated, and each producer's events stay in order.
+  IngressSlot slots[16];
+  IngressQueue_ctor(&ingress, slots, 16);
+  pthread_t threads[INGRESS_PRODUCERS];
+  for (size_t i = 0; i < INGRESS_PRODUCERS; i++) {
+    TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, ingress_producer, (void*)i));
+  }
+
+  microstep_t next[INGRESS_PRODUCERS] = {0};
+  size_t popped = 0;
+  Event out;
+  while (popped < INGRESS_PRODUCERS * INGRESS_EVENTS_PER_PRODUCER) {
+    if (ingress.pop(&ingress, &out)) {
+      TEST_ASSERT_EQUAL(next[out.super.tag.time], out.super.tag.microstep);
+      next[out.super.tag.time]++;
+      popped++;
+    } else {
+      sched_yield();
+    }
+  }
+
+  for (size_t i = 0; i < INGRESS_PRODUCERS; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  TEST_ASSERT_FALSE(ingress.pop(&ingress, &out));
+}
+#endif
+#endif
+
 Environment* _lf_environment = NULL;
 
 int main(void) {
@@ -494,5 +1146,23 @@ int main(void) {
   RUN_TEST(test_remove_sole_element);
   RUN_TEST(test_remove_root);
   RUN_TEST(test_system_event_find_and_remove);
+  RUN_TEST(test_indexed_find_and_remove);
+  RUN_TEST(test_indexed_build_heap);
+  RUN_TEST(test_indexed_matches_linear);
+  RUN_TEST(test_dary_insert_pop);
+  RUN_TEST(test_dary_find_and_remove);
+  RUN_TEST(test_dary_build_heap);
+  RUN_TEST(test_dary_matches_binary);
+  RUN_TEST(test_radix_insert_pop);
+  RUN_TEST(test_radix_find_and_remove);
+  RUN_TEST(test_radix_build_heap);
+  RUN_TEST(test_radix_matches_binary);
+  RUN_TEST(test_pop_all_at_tag);
+#if EVENT_INGRESS_SIZE > 0
+  RUN_TEST(test_ingress_fifo);
+#if defined(PLATFORM_POSIX)
+  RUN_TEST(test_ingress_concurrent_producers);
+#endif
+#endif
   return UNITY_END();
 }
@@ -0,0 +1,124 @@
+#include "reactor-uc/reactor-uc.h"
+#include "unity.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+Environment* _lf_environment = NULL;
+
+static FILE* capture;
+static int saved_stdout;
+static char output[32768];
+
+static void start_capture(void) {
+  fflush(stdout);
+  capture = tmpfile();
+  TEST_ASSERT_NOT_NULL(capture);
+  saved_stdout = dup(STDOUT_FILENO);
+  dup2(fileno(capture), STDOUT_FILENO);
+}
+
+static const char* stop_capture(void) {
+  fflush(stdout);
+  dup2(saved_stdout, STDOUT_FILENO);
+  close(saved_stdout);
+  rewind(capture);
+  size_t len = fread(output, 1, sizeof(output) - 1, capture);
+  output[len] = '\0';
+  fclose(capture);
+  return output;
+}
+
+void test_format_arguments(void) {
+  start_capture();
+  log_message(LF_LOG_LEVEL_INFO, "TEST", "%d %u %ld %lld %zu %x", -1, 2U, 3L, -4LL, (size_t)5, 255);
+  log_message(LF_LOG_LEVEL_INFO, "TEST", "%5.2f %c %s %% %-4d| %*d %.*s", 3.14159, 'c', "str", 6, 3, 7, 2, "abc");
+  log_flush();
+  const char* out = stop_capture();
+  TEST_ASSERT_NOT_NULL(strstr(out, "[INFO] [TEST] -1 2 3 -4 5 ff"));
+  TEST_ASSERT_NOT_NULL(strstr(out, "[INFO] [TEST]  3.14 c str % 6   |   7 ab"));
+}
+
+#if defined(LF_LOG_DEFERRED)
+void test_printed_on_flush(void) {
+  start_capture();
+  log_message(LF_LOG_LEVEL_INFO, "TEST", "first %d", 1);
+  log_message(LF_LOG_LEVEL_DEBUG, "TEST", "second %d", 2);
+  TEST_ASSERT_EQUAL_STRING("", stop_capture());
+
+  start_capture();
+  log_flush();
+  const char* out = stop_capture();
+  const char* first = strstr(out, "[INFO] [TEST] first 1");
+  const char* second = strstr(out, "[DEBUG] [TEST] second 2");
+  TEST_ASSERT_NOT_NULL(first);
+  TEST_ASSERT_NOT_NULL(second);
+  TEST_ASSERT_TRUE(first < second);
+}
+
+void test_strings_are_copied(void) {
+  char name[] = "before";
+  start_capture();
+  log_message(LF_LOG_LEVEL_INFO, "TEST", "name %s", name);
+  strcpy(name, "after");
+  log_flush();
+  TEST_ASSERT_NOT_NULL(strstr(stop_capture(), "name before"));
+}
+
+void test_too_many_arguments(void) {
+  start_capture();
+  log_message(LF_LOG_LEVEL_INFO, "TEST", "%d %d %d %d %d %d %d %d %d %d end", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+  log_flush();
+  TEST_ASSERT_NOT_NULL(strstr(stop_capture(), "1 2 3 4 5 6 7 8 ? ? end"));
+}
+
+void test_dropped_when_full(void) {
+  start_capture();
+  for (int i = 0; i < LF_LOG_DEFERRED_BUFFER_SIZE + 5; i++) {
+    log_message(LF_LOG_LEVEL_INFO, "TEST", "message %d", i);
+  }
+  log_flush();
+  const char* out = stop_capture();
+  char last[32];
+  snprintf(last, sizeof(last), "message %d", LF_LOG_DEFERRED_BUFFER_SIZE - 1);
+  char first_dropped[32];
+  snprintf(first_dropped, sizeof(first_dropped), "message %d", LF_LOG_DEFERRED_BUFFER_SIZE);
+  TEST_ASSERT_NOT_NULL(strstr(out, last));
+  TEST_ASSERT_NULL(strstr(out, first_dropped));
+  TEST_ASSERT_NOT_NULL(strstr(out, "5 messages were dropped"));
+}
+
+void test_error_printed_after_deferred_messages(void) {
+  start_capture();
+  log_message(LF_LOG_LEVEL_INFO, "TEST", "deferred");
+  log_message(LF_LOG_LEVEL_ERROR, "TEST", "error");
+  const char* out = stop_capture();
+  const char* deferred = strstr(out, "[INFO] [TEST] deferred");
+  const char* error = strstr(out, "[ERROR] [TEST] error");
+  TEST_ASSERT_NOT_NULL(deferred);
+  TEST_ASSERT_NOT_NULL(error);
+  TEST_ASSERT_TRUE(deferred < error);
+}
+#else
+void test_printed_immediately(void) {
+  start_capture();
+  log_message(LF_LOG_LEVEL_INFO, "TEST", "message %d", 1);
+  TEST_ASSERT_NOT_NULL(strstr(stop_capture(), "[INFO] [TEST] message 1"));
+}
+#endif
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_format_arguments);
+#if defined(LF_LOG_DEFERRED)
+  RUN_TEST(test_printed_on_flush);
+  RUN_TEST(test_strings_are_copied);
+  RUN_TEST(test_too_many_arguments);
+  RUN_TEST(test_dropped_when_full);
+  RUN_TEST(test_error_printed_after_deferred_messages);
+#else
+  RUN_TEST(test_printed_immediately);
+#endif
+  return UNITY_END();
+}
@@ -0,0 +1,148 @@
+#include "reactor-uc/reactor-uc.h"
+#include "reactor-uc/platform/posix/posix.h"
+#include "unity.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+Environment* _lf_environment = NULL;
+
+static PlatformPosix* platform;
+
+void setUp(void) {
+  platform = (PlatformPosix*)Platform_new();
+  Platform_ctor(&platform->super);
+}
+
+static void wait_until_does_not_return_early(interval_t spin_wait_threshold) {
+  platform->spin_wait_threshold = spin_wait_threshold;
+  for (int i = 0; i < 10; i++) {
+    instant_t wakeup_time = platform->super.get_physical_time(&platform->super) + MSEC(1);
+    TEST_ASSERT_EQUAL(LF_OK, platform->super.wait_until(&platform->super, wakeup_time));
+    TEST_ASSERT_TRUE(platform->super.get_physical_time(&platform->super) >= wakeup_time);
+
+    wakeup_time = platform->super.get_physical_time(&platform->super) + MSEC(1);
+    TEST_ASSERT_EQUAL(LF_OK, platform->super.wait_until_interruptible(&platform->super, wakeup_time));
+    TEST_ASSERT_TRUE(platform->super.get_physical_time(&platform->super) >= wakeup_time);
+  }
+}
+
+void test_wait_until_sleeping(void) { wait_until_does_not_return_early(0); }
+
+void test_wait_until_spinning(void) { wait_until_does_not_return_early(USEC(200)); }
+
+static void* notify_thread(void* arg) {
+  (void)arg;
+  platform->super.wait_for(&platform->super, MSEC(5));
+  platform->super.notify(&platform->super);
+  return NULL;
+}
+
+void test_interrupted_while_spinning(void) {
+  // The wait spins from the beginning, so the notification arrives while spinning.
+  platform->spin_wait_threshold = SEC(10);
+  instant_t start = platform->super.get_physical_time(&platform->super);
+  pthread_t thread;
+  TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, notify_thread, NULL));
+  TEST_ASSERT_EQUAL(LF_SLEEP_INTERRUPTED, platform->super.wait_until_interruptible(&platform->super, start + SEC(1)));
+  TEST_ASSERT_TRUE(platform->super.get_physical_time(&platform->super) < start + SEC(1));
+  TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+}
+
+void test_interrupted_while_sleeping(void) {
+  platform->spin_wait_threshold = 0;
+  instant_t start = platform->super.get_physical_time(&platform->super);
+  pthread_t thread;
+  TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, notify_thread, NULL));
+  TEST_ASSERT_EQUAL(LF_SLEEP_INTERRUPTED, platform->super.wait_until_interruptible(&platform->super, start + SEC(1)));
+  TEST_ASSERT_TRUE(platform->super.get_physical_time(&platform->super) < start + SEC(1));
+  TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+  TEST_ASSERT_EQUAL(0, platform->sleeping);
+}
+
+void test_notify_while_awake(void) {
+  // Notifications while the scheduler is awake are coalesced into a single interrupted wait.
+  platform->spin_wait_threshold = 0;
+  platform->super.notify(&platform->super);
+  platform->super.notify(&platform->super);
+  TEST_ASSERT_EQUAL(0, platform->sleeping);
+  instant_t wakeup_time = platform->super.get_physical_time(&platform->super) + MSEC(1);
+  TEST_ASSERT_EQUAL(LF_SLEEP_INTERRUPTED, platform->super.wait_until_interruptible(&platform->super, wakeup_time));
+  TEST_ASSERT_EQUAL(LF_OK, platform->super.wait_until_interruptible(&platform->super, wakeup_time));
+  TEST_ASSERT_TRUE(platform->super.get_physical_time(&platform->super) >= wakeup_time);
+}
+
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+static int pipe_fds[2];
+
+static void* write_thread(void* arg) {
+  (void)arg;
+  platform->super.wait_for(&platform->super, MSEC(5));
+  TEST_ASSERT_EQUAL(1, write(pipe_fds[1], "X", 1));
+  return NULL;
+}
+
+void test_interrupted_by_registered_fd(void) {
+  platform->spin_wait_threshold = 0;
+  TEST_ASSERT_EQUAL(0, pipe(pipe_fds));
+  TEST_ASSERT_EQUAL(LF_OK, PlatformPosix_register_fd(platform, pipe_fds[0]));
+
+  instant_t start = platform->super.get_physical_time(&platform->super);
+  pthread_t thread;
+  TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, write_thread, NULL));
+  TEST_ASSERT_EQUAL(LF_SLEEP_INTERRUPTED, platform->super.wait_until_interruptible(&platform->super, start + SEC(1)));
+  TEST_ASSERT_TRUE(platform->super.get_physical_time(&platform->super) < start + SEC(1));
+  TEST_ASSERT_EQUAL(0, pthread_join(thread, NULL));
+
+  // Once unregistered, the unread data does not end the wait anymore.
+  PlatformPosix_unregister_fd(platform, pipe_fds[0]);
+  instant_t wakeup_time = platform->super.get_physical_time(&platform->super) + MSEC(1);
+  TEST_ASSERT_EQUAL(LF_OK, platform->super.wait_until_interruptible(&platform->super, wakeup_time));
+  close(pipe_fds[0]);
+  close(pipe_fds[1]);
+}
+#endif
+
+void test_default_rt_profile(void) {
+  RtProfilePosix profile = RT_PROFILE_POSIX_DEFAULT;
+  TEST_ASSERT_EQUAL(-1, platform->rt_profile.scheduler.policy);
+  TEST_ASSERT_EQUAL(-1, platform->rt_profile.channel.cpu);
+  TEST_ASSERT_EQUAL(LF_OK, PlatformPosix_set_rt_profile(platform, &profile));
+}
+
+void test_rt_profile_without_privileges(void) {
+  // Only the parts of a profile which need no privileges, so the test also passes for an ordinary user.
+  RtProfilePosix profile = RT_PROFILE_POSIX_DEFAULT;
+  profile.scheduler.policy = SCHED_OTHER;
+  profile.scheduler.priority = 0;
+  profile.channel.policy = SCHED_OTHER;
+  profile.prefault_stack_size = 64 * 1024;
+  TEST_ASSERT_EQUAL(LF_OK, PlatformPosix_set_rt_profile(platform, &profile));
+  TEST_ASSERT_EQUAL(SCHED_OTHER, platform->rt_profile.channel.policy);
+
+  int policy;
+  struct sched_param param;
+  TEST_ASSERT_EQUAL(0, pthread_getschedparam(pthread_self(), &policy, &param));
+  TEST_ASSERT_EQUAL(SCHED_OTHER, policy);
+}
+
+void test_invalid_thread_profile(void) {
+  ThreadProfilePosix profile = {.policy = SCHED_OTHER, .priority = 99, .cpu = -1};
+  TEST_ASSERT_EQUAL(LF_ERR, PlatformPosix_apply_thread_profile(&profile));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_wait_until_sleeping);
+  RUN_TEST(test_wait_until_spinning);
+  RUN_TEST(test_interrupted_while_spinning);
+  RUN_TEST(test_interrupted_while_sleeping);
+  RUN_TEST(test_notify_while_awake);
+#if defined(PLATFORM_POSIX_EVENT_LOOP)
+  RUN_TEST(test_interrupted_by_registered_fd);
+#endif
+  RUN_TEST(test_default_rt_profile);
+  RUN_TEST(test_rt_profile_without_privileges);
+  RUN_TEST(test_invalid_thread_profile);
+  return UNITY_END();
+}
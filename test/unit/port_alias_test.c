@@ -0,0 +1,135 @@
+#include "reactor-uc/reactor-uc.h"
+#include "unity.h"
+
+#include <reactor-uc/schedulers/dynamic/scheduler.h>
+
+typedef struct {
+  interval_t time;
+  char data[1024];
+} Frame;
+
+// Components of Reactor Sender
+LF_DEFINE_TIMER_STRUCT(Sender, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Sender, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Sender, r_sender, 1);
+LF_DEFINE_REACTION_CTOR(Sender, r_sender, 0, NULL, NULL);
+LF_DEFINE_OUTPUT_STRUCT(Sender, out, 1, Frame);
+LF_DEFINE_OUTPUT_CTOR(Sender, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sender, r_sender);
+  LF_TIMER_INSTANCE(Sender, t);
+  LF_PORT_INSTANCE(Sender, out, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 2, 0);
+} Sender;
+
+LF_DEFINE_REACTION_BODY(Sender, r_sender) {
+  LF_SCOPE_SELF(Sender);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Sender, out);
+  Frame frame = {.time = env->get_elapsed_logical_time(env)};
+  lf_set(out, frame);
+}
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sender, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sender);
+  LF_INITIALIZE_REACTION(Sender, r_sender, NEVER);
+  LF_INITIALIZE_TIMER(Sender, t, MSEC(0), MSEC(5));
+  LF_INITIALIZE_OUTPUT(Sender, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->r_sender);
+  LF_PORT_REGISTER_SOURCE(self->out, self->r_sender, 1);
+}
+
+// Reactor Receiver
+
+LF_DEFINE_REACTION_STRUCT(Receiver, r_recv, 0)
+LF_DEFINE_REACTION_CTOR(Receiver, r_recv, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Receiver, in, 1, 0, Frame, 0)
+LF_DEFINE_INPUT_CTOR(Receiver, in, 1, 0, Frame, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Receiver, r_recv);
+  LF_PORT_INSTANCE(Receiver, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0)
+  bool expect_alias;
+  int count;
+} Receiver;
+
+LF_DEFINE_REACTION_BODY(Receiver, r_recv) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Receiver, in);
+
+  TEST_ASSERT_EQUAL(self->expect_alias, in->super.is_alias);
+  TEST_ASSERT_EQUAL(env->get_elapsed_logical_time(env), lf_get(in)->time);
+  self->count++;
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Receiver, InputExternalCtorArgs* in_external, bool expect_alias) {
+  LF_REACTOR_CTOR(Receiver);
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_INITIALIZE_REACTION(Receiver, r_recv, NEVER);
+  LF_INITIALIZE_INPUT(Receiver, in, 1, in_external);
+
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_recv, 1);
+  self->expect_alias = expect_alias;
+  self->count = 0;
+}
+
+// Reactor main. The bank of receivers aliases the output of the sender, the copier gets a copy of it.
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, sender_out_alias, 2)
+LF_DEFINE_ALIASING_LOGICAL_CONNECTION_CTOR(Main, sender_out_alias, 2)
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, sender_out_copy, 1)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Main, sender_out_copy, 1)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sender, sender, 1);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, receiver, 2);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, copier, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, sender_out_alias, 1, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, sender_out_copy, 1, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 4)
+  LF_CHILD_OUTPUT_CONNECTIONS(sender, out, 1, 1, 2);
+  LF_CHILD_OUTPUT_EFFECTS(sender, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(sender, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(receiver, in, 2, 1, 0);
+  LF_CHILD_INPUT_SOURCES(copier, in, 1, 1, 0);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(sender, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sender, sender, 1, &_sender_out_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(receiver, in, 2, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, receiver, 2, &_receiver_in_args[i][0], true);
+  LF_DEFINE_CHILD_INPUT_ARGS(copier, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, copier, 1, &_copier_in_args[0][0], false);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, sender_out_alias, 1, 1);
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, sender_out_copy, 1, 1);
+  for (int i = 0; i < 2; i++) {
+    lf_connect(&self->sender_out_alias[0][0].super.super, &self->sender->out[0].super, &self->receiver[i].in[0].super);
+  }
+  lf_connect(&self->sender_out_copy[0][0].super.super, &self->sender->out[0].super, &self->copier->in[0].super);
+}
+
+LF_ENTRY_POINT(Main, 32, 32, MSEC(100), false, false);
+
+void test_alias_and_copy(void) {
+  lf_start();
+  TEST_ASSERT_EQUAL(21, main_reactor.receiver[0].count);
+  TEST_ASSERT_EQUAL(21, main_reactor.receiver[1].count);
+  TEST_ASSERT_EQUAL(21, main_reactor.copier[0].count);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_alias_and_copy);
+  return UNITY_END();
+}
@@ -0,0 +1,202 @@
+#include "reactor-uc/reactor-uc.h"
+#include "unity.h"
+
+#include <reactor-uc/schedulers/dynamic/scheduler.h>
+
+// Components of Reactor Sender
+LF_DEFINE_TIMER_STRUCT(Sender, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Sender, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Sender, r_sender, 1);
+LF_DEFINE_REACTION_CTOR(Sender, r_sender, 0, NULL, NULL);
+LF_DEFINE_OUTPUT_STRUCT(Sender, out, 1, interval_t);
+LF_DEFINE_OUTPUT_CTOR(Sender, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sender, r_sender);
+  LF_TIMER_INSTANCE(Sender, t);
+  LF_PORT_INSTANCE(Sender, out, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 2, 0);
+} Sender;
+
+LF_DEFINE_REACTION_BODY(Sender, r_sender) {
+  LF_SCOPE_SELF(Sender);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Sender, out);
+  lf_set(out, env->get_elapsed_logical_time(env));
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sender, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sender);
+  LF_INITIALIZE_REACTION(Sender, r_sender, NEVER);
+  LF_INITIALIZE_TIMER(Sender, t, MSEC(0), MSEC(5));
+  LF_INITIALIZE_OUTPUT(Sender, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->r_sender);
+  LF_PORT_REGISTER_SOURCE(self->out, self->r_sender, 1);
+}
+
+// Reactor Source, which forwards the output of the contained sender.
+LF_DEFINE_OUTPUT_STRUCT(Source, out, 0, interval_t);
+LF_DEFINE_OUTPUT_CTOR(Source, out, 0);
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Source, sender_out, 1)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Source, sender_out, 1)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sender, sender, 1);
+  LF_PORT_INSTANCE(Source, out, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Source, sender_out, 1, 1);
+  LF_CHILD_OUTPUT_CONNECTIONS(sender, out, 1, 1, 1);
+  LF_CHILD_OUTPUT_EFFECTS(sender, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(sender, out, 1, 1, 0);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 1, 1);
+} Source;
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Source, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Source);
+  LF_INITIALIZE_OUTPUT(Source, out, 1, out_external);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(sender, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sender, sender, 1, &_sender_out_args[0][0]);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Source, sender_out, 1, 1);
+  lf_connect(&self->sender_out[0][0].super.super, &self->sender->out[0].super, &self->out[0].super);
+}
+
+// Reactor Receiver, which expects the values to arrive `delay` after they were sent.
+LF_DEFINE_REACTION_STRUCT(Receiver, r_recv, 0)
+LF_DEFINE_REACTION_CTOR(Receiver, r_recv, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Receiver, in, 1, 0, interval_t, 0)
+LF_DEFINE_INPUT_CTOR(Receiver, in, 1, 0, interval_t, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Receiver, r_recv);
+  LF_PORT_INSTANCE(Receiver, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+  interval_t delay;
+  int count;
+} Receiver;
+
+LF_DEFINE_REACTION_BODY(Receiver, r_recv) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Receiver, in);
+  TEST_ASSERT_EQUAL(env->get_elapsed_logical_time(env), in->value + self->delay);
+  self->count++;
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Receiver, InputExternalCtorArgs* in_external, interval_t delay) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Receiver);
+  LF_INITIALIZE_REACTION(Receiver, r_recv, NEVER);
+  LF_INITIALIZE_INPUT(Receiver, in, 1, in_external);
+
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_recv, 1);
+  self->delay = delay;
+  self->count = 0;
+}
+
+// Reactor Sink, which forwards its input to the contained receiver.
+LF_DEFINE_INPUT_STRUCT(Sink, in, 0, 0, interval_t, 1)
+LF_DEFINE_INPUT_CTOR(Sink, in, 0, 0, interval_t, 1)
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Sink, in_receiver, 1)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Sink, in_receiver, 1)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Receiver, receiver, 1);
+  LF_PORT_INSTANCE(Sink, in, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Sink, in_receiver, 1, 1);
+  LF_CHILD_INPUT_SOURCES(receiver, in, 1, 1, 0);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 1, 1);
+} Sink;
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sink, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sink);
+  LF_INITIALIZE_INPUT(Sink, in, 1, in_external);
+
+  LF_DEFINE_CHILD_INPUT_ARGS(receiver, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, receiver, 1, &_receiver_in_args[0][0], 0);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Sink, in_receiver, 1, 1);
+  lf_connect(&self->in_receiver[0][0].super.super, &self->in[0].super, &self->receiver->in[0].super);
+}
+
+// Reactor main. The output of the sender reaches the receiver in the sink through two levels of hierarchy, the direct
+// receiver through one, and the late receiver through a delayed connection.
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, source_out, 2)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Main, source_out, 2)
+LF_DEFINE_DELAYED_CONNECTION_STRUCT(Main, source_out_delayed, 1, interval_t, 2)
+LF_DEFINE_DELAYED_CONNECTION_CTOR(Main, source_out_delayed, 1, 2, false)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Source, source, 1);
+  LF_CHILD_REACTOR_INSTANCE(Sink, sink, 1);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, direct, 1);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, late, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, source_out, 1, 1);
+  LF_DELAYED_CONNECTION_INSTANCE(Main, source_out_delayed, 1, 1);
+  LF_CHILD_OUTPUT_CONNECTIONS(source, out, 1, 1, 2);
+  LF_CHILD_OUTPUT_EFFECTS(source, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(source, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(sink, in, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(direct, in, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(late, in, 1, 1, 0);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 4);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(source, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Source, source, 1, &_source_out_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(sink, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sink, sink, 1, &_sink_in_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(direct, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, direct, 1, &_direct_in_args[0][0], 0);
+  LF_DEFINE_CHILD_INPUT_ARGS(late, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, late, 1, &_late_in_args[0][0], MSEC(10));
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, source_out, 1, 1);
+  LF_INITIALIZE_DELAYED_CONNECTION(Main, source_out_delayed, MSEC(10), 1, 1);
+  lf_connect(&self->source_out[0][0].super.super, &self->source->out[0].super, &self->sink->in[0].super);
+  lf_connect(&self->source_out[0][0].super.super, &self->source->out[0].super, &self->direct->in[0].super);
+  lf_connect(&self->source_out_delayed[0][0].super.super, &self->source->out[0].super, &self->late->in[0].super);
+}
+
+LF_ENTRY_POINT(Main, 32, 32, MSEC(100), false, false);
+
+void test_hierarchical_fanout(void) {
+  lf_start();
+
+  Port* out = &main_reactor.source->sender->out[0].super;
+#if PORT_FANOUT_TABLE_SIZE > 0
+  // The receiver in the sink, the direct receiver, and the delayed connection.
+  TEST_ASSERT_EQUAL(3, out->fanout_size);
+  TEST_ASSERT_EQUAL_PTR(&main_reactor.sink->receiver->in[0].super, out->fanout[0].port);
+  TEST_ASSERT_EQUAL_PTR(&main_reactor.direct->in[0].super, out->fanout[1].port);
+  TEST_ASSERT_EQUAL_PTR(&main_reactor.source_out_delayed[0][0].super.super, out->fanout[2].conn);
+#else
+  TEST_ASSERT_NULL(out->fanout);
+#endif
+  // Ports which are written through connections have no table of their own.
+  TEST_ASSERT_NULL(main_reactor.source->out[0].super.fanout);
+  TEST_ASSERT_NULL(main_reactor.sink->in[0].super.fanout);
+
+  TEST_ASSERT_EQUAL(21, main_reactor.sink->receiver->count);
+  TEST_ASSERT_EQUAL(21, main_reactor.direct->count);
+  TEST_ASSERT_EQUAL(19, main_reactor.late->count);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_hierarchical_fanout);
+  return UNITY_END();
+}
@@ -0,0 +1,185 @@
+#include "reactor-uc/platform/posix/tcp_ip_channel.h"
+#include "reactor-uc/reactor-uc.h"
+#include "reactor-uc/environments/federated_environment.h"
+#include "reactor-uc/startup_coordinator.h"
+#include "unity.h"
+#include "../test_util.h"
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define MESSAGE_CONTENT "Hello World1234"
+#define MESSAGE_CONNECTION_ID 42
+#define HOST "127.0.0.1"
+#define PORT 9010
+#define MAX_POLL_ROUNDS 500
+#define MAX_MESSAGES_IN_FLIGHT 100000
+
+Reactor parent;
+FederatedEnvironment env;
+Environment* _lf_environment = &env.super;
+FederatedConnectionBundle server_bundle;
+FederatedConnectionBundle client_bundle;
+FederatedConnectionBundle* net_bundles[] = {&server_bundle, &client_bundle};
+StartupCoordinator startup_coordinator;
+ShutdownCoordinator shutdown_coordinator;
+
+TcpIpChannel _server_tcp_channel;
+TcpIpChannel _client_tcp_channel;
+NetworkChannel* server_channel = &_server_tcp_channel.super;
+NetworkChannel* client_channel = &_client_tcp_channel.super;
+
+int server_messages_received = 0;
+int client_messages_received = 0;
+
+void setUp(void) {
+  FederatedEnvironment_ctor(&env, NULL, NULL, false, net_bundles, 2, &startup_coordinator, &shutdown_coordinator, NULL);
+  TcpIpChannel_ctor(&_server_tcp_channel, HOST, PORT, AF_INET, true);
+  TcpIpChannel_ctor(&_client_tcp_channel, HOST, PORT, AF_INET, false);
+  FederatedConnectionBundle_ctor(&server_bundle, &parent, server_channel, NULL, NULL, 0, NULL, NULL, 0, 0);
+  FederatedConnectionBundle_ctor(&client_bundle, &parent, client_channel, NULL, NULL, 0, NULL, NULL, 0, 0);
+  server_messages_received = 0;
+  client_messages_received = 0;
+}
+
+void tearDown(void) {
+  server_channel->free(server_channel);
+  client_channel->free(client_channel);
+}
+
+/** Poll a channel the way the scheduler does, until it has nothing more to deliver. */
+static lf_ret_t poll_channel(NetworkChannel* channel) {
+  TEST_ASSERT_EQUAL(NETWORK_CHANNEL_MODE_POLLED, channel->mode);
+  lf_ret_t ret;
+  do {
+    ret = ((PolledNetworkChannel*)channel)->poll(channel);
+  } while (ret == LF_NETWORK_CHANNEL_RETRY);
+  return ret;
+}
+
+/** Wait in the event loop of the platform, which is woken up by the registered sockets. */
+static lf_ret_t wait_for_event(interval_t timeout) {
+  Platform* platform = env.super.platform;
+  return platform->wait_until_interruptible(platform, platform->get_physical_time(platform) + timeout);
+}
+
+static void connect_channels(void) {
+  TEST_ASSERT_OK(server_channel->open_connection(server_channel));
+  TEST_ASSERT_OK(client_channel->open_connection(client_channel));
+
+  for (int i = 0; i < MAX_POLL_ROUNDS; i++) {
+    poll_channel(server_channel);
+    poll_channel(client_channel);
+    if (server_channel->is_connected(server_channel) && client_channel->is_connected(client_channel)) {
+      return;
+    }
+    wait_for_event(MSEC(10));
+  }
+  TEST_FAIL_MESSAGE("Channels did not connect");
+}
+
+static void fill_message(FederateMessage* msg) {
+  msg->which_message = FederateMessage_tagged_message_tag;
+  TaggedMessage* port_message = &msg->message.tagged_message;
+  port_message->conn_id = MESSAGE_CONNECTION_ID;
+  memcpy(port_message->payload.bytes, MESSAGE_CONTENT, sizeof(MESSAGE_CONTENT)); // NOLINT
+  port_message->payload.size = sizeof(MESSAGE_CONTENT);
+}
+
+static void check_message(const FederateMessage* _msg) {
+  const TaggedMessage* msg = &_msg->message.tagged_message;
+  TEST_ASSERT_EQUAL_STRING(MESSAGE_CONTENT, (char*)msg->payload.bytes);
+  TEST_ASSERT_EQUAL(MESSAGE_CONNECTION_ID, msg->conn_id);
+}
+
+void server_callback_handler(FederatedConnectionBundle* self, const FederateMessage* msg) {
+  (void)self;
+  check_message(msg);
+  server_messages_received++;
+}
+
+void client_callback_handler(FederatedConnectionBundle* self, const FederateMessage* msg) {
+  (void)self;
+  check_message(msg);
+  client_messages_received++;
+}
+
+void counting_callback_handler(FederatedConnectionBundle* self, const FederateMessage* msg) {
+  (void)self;
+  (void)msg;
+  server_messages_received++;
+}
+
+/* TESTS */
+void test_open_connection(void) {
+  connect_channels();
+  TEST_ASSERT_TRUE(server_channel->is_connected(server_channel));
+  TEST_ASSERT_TRUE(client_channel->is_connected(client_channel));
+}
+
+void test_send_and_recv_both_directions(void) {
+  connect_channels();
+  server_channel->register_receive_callback(server_channel, server_callback_handler, NULL);
+  client_channel->register_receive_callback(client_channel, client_callback_handler, NULL);
+  FederateMessage msg;
+  fill_message(&msg);
+
+  // The message wakes up the event loop, and is delivered inline when the channel is polled.
+  TEST_ASSERT_OK(client_channel->send_blocking(client_channel, &msg));
+  TEST_ASSERT_EQUAL(LF_SLEEP_INTERRUPTED, wait_for_event(SEC(1)));
+  poll_channel(server_channel);
+  TEST_ASSERT_EQUAL(1, server_messages_received);
+
+  TEST_ASSERT_OK(server_channel->send_blocking(server_channel, &msg));
+  TEST_ASSERT_EQUAL(LF_SLEEP_INTERRUPTED, wait_for_event(SEC(1)));
+  poll_channel(client_channel);
+  TEST_ASSERT_EQUAL(1, client_messages_received);
+}
+
+void test_send_to_full_socket_gives_up(void) {
+  connect_channels();
+  server_channel->register_receive_callback(server_channel, counting_callback_handler, NULL);
+  setsockopt(_client_tcp_channel.fd, SOL_SOCKET, SO_SNDBUF, &(int){4096}, sizeof(int));
+  setsockopt(_server_tcp_channel.client, SOL_SOCKET, SO_RCVBUF, &(int){4096}, sizeof(int));
+  FederateMessage msg;
+  fill_message(&msg);
+
+  // Nobody reads on the server side, so the socket buffers fill up. Sending must then fail after a bounded number of
+  // retries instead of spinning until the peer reads.
+  Platform* platform = env.super.platform;
+  lf_ret_t ret = LF_OK;
+  int sent = 0;
+  while (ret == LF_OK && sent < MAX_MESSAGES_IN_FLIGHT) {
+    instant_t start = platform->get_physical_time(platform);
+    ret = client_channel->send_blocking(client_channel, &msg);
+    if (ret == LF_OK) {
+      sent++;
+    } else {
+      TEST_ASSERT_TRUE(platform->get_physical_time(platform) - start < SEC(5));
+    }
+  }
+  TEST_ASSERT_EQUAL(LF_ERR, ret);
+  TEST_ASSERT_GREATER_THAN(0, sent);
+
+  // The server still receives what was sent before the buffers were full.
+  poll_channel(server_channel);
+  TEST_ASSERT_GREATER_THAN(0, server_messages_received);
+}
+
+void test_peer_close(void) {
+  connect_channels();
+  server_channel->close_connection(server_channel);
+
+  // Closing the connection makes the socket of the client readable, which ends the connection on the client side.
+  TEST_ASSERT_EQUAL(LF_SLEEP_INTERRUPTED, wait_for_event(SEC(1)));
+  TEST_ASSERT_EQUAL(LF_ERR, poll_channel(client_channel));
+  TEST_ASSERT_FALSE(client_channel->is_connected(client_channel));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_open_connection);
+  RUN_TEST(test_send_and_recv_both_directions);
+  RUN_TEST(test_send_to_full_socket_gives_up);
+  RUN_TEST(test_peer_close);
+  return UNITY_END();
+}
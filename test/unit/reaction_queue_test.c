@@ -4,15 +4,14 @@
 #define REACTION_QUEUE_SIZE 32
 void test_insert(void) {
   ReactionQueue q;
-  int level_size[REACTION_QUEUE_SIZE];
-  Reaction* array[REACTION_QUEUE_SIZE][REACTION_QUEUE_SIZE];
-  Reaction rs[REACTION_QUEUE_SIZE];
-  ReactionQueue_ctor(&q, (Reaction**)array, level_size, REACTION_QUEUE_SIZE);
+  Reaction* level_head[REACTION_QUEUE_SIZE];
+  Reaction* level_tail[REACTION_QUEUE_SIZE];
+  uint32_t ready[REACTION_QUEUE_READY_WORDS(REACTION_QUEUE_SIZE)];
+  Reaction rs[REACTION_QUEUE_SIZE] = {0};
+  ReactionQueue_ctor(&q, level_head, level_tail, ready, REACTION_QUEUE_SIZE);
 
   for (size_t i = 0; i < REACTION_QUEUE_SIZE; i++) {
-    for (size_t j = 0; j < REACTION_QUEUE_SIZE; j++) {
-      TEST_ASSERT_NULL(array[i][j]);
-    }
+    TEST_ASSERT_NULL(level_head[i]);
   }
 
   TEST_ASSERT_TRUE(q.empty(&q));
@@ -32,10 +31,11 @@ void test_insert(void) {
 
 void test_levels_with_gaps(void) {
   ReactionQueue q;
-  int level_size[REACTION_QUEUE_SIZE];
-  Reaction* array[REACTION_QUEUE_SIZE][REACTION_QUEUE_SIZE];
-  Reaction rs[REACTION_QUEUE_SIZE];
-  ReactionQueue_ctor(&q, (Reaction**)array, level_size, REACTION_QUEUE_SIZE);
+  Reaction* level_head[REACTION_QUEUE_SIZE];
+  Reaction* level_tail[REACTION_QUEUE_SIZE];
+  uint32_t ready[REACTION_QUEUE_READY_WORDS(REACTION_QUEUE_SIZE)];
+  Reaction rs[REACTION_QUEUE_SIZE] = {0};
+  ReactionQueue_ctor(&q, level_head, level_tail, ready, REACTION_QUEUE_SIZE);
   for (int i = 0; i < REACTION_QUEUE_SIZE; i++) {
     if (i < REACTION_QUEUE_SIZE / 2) {
       rs[i].level = 1;
@@ -50,11 +50,114 @@ void test_levels_with_gaps(void) {
     TEST_ASSERT_EQUAL_PTR(r, &rs[i]);
   }
 }
+void test_duplicates_and_reset(void) {
+  ReactionQueue q;
+  Reaction* level_head[REACTION_QUEUE_SIZE];
+  Reaction* level_tail[REACTION_QUEUE_SIZE];
+  uint32_t ready[REACTION_QUEUE_READY_WORDS(REACTION_QUEUE_SIZE)];
+  Reaction rs[3] = {0};
+  ReactionQueue_ctor(&q, level_head, level_tail, ready, REACTION_QUEUE_SIZE);
+  rs[0].level = 2;
+  rs[1].level = 2;
+  rs[2].level = 5;
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &rs[i]));
+    TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &rs[i]));
+  }
+
+  TEST_ASSERT_EQUAL_PTR(&rs[0], q.pop(&q));
+  TEST_ASSERT_EQUAL_PTR(&rs[1], q.pop(&q));
+  TEST_ASSERT_EQUAL_PTR(&rs[2], q.pop(&q));
+  TEST_ASSERT_NULL(q.pop(&q));
+  TEST_ASSERT_TRUE(q.empty(&q));
+
+  // Reactions left in the queue are dropped by a reset.
+  TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &rs[2]));
+  q.reset(&q);
+  TEST_ASSERT_TRUE(q.empty(&q));
+  TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &rs[0]));
+  TEST_ASSERT_EQUAL_PTR(&rs[0], q.pop(&q));
+  TEST_ASSERT_TRUE(q.empty(&q));
+}
+
+void test_levels_across_words(void) {
+  ReactionQueue q;
+  Reaction* level_head[100];
+  Reaction* level_tail[100];
+  uint32_t ready[REACTION_QUEUE_READY_WORDS(100)];
+  Reaction rs[5] = {0};
+  int levels[5] = {0, 31, 32, 64, 99};
+  ReactionQueue_ctor(&q, level_head, level_tail, ready, 100);
+  for (int i = 4; i >= 0; i--) {
+    rs[i].level = levels[i];
+    TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &rs[i]));
+  }
+
+  for (int i = 0; i < 5; i++) {
+    TEST_ASSERT_FALSE(q.empty(&q));
+    TEST_ASSERT_EQUAL(levels[i], q.next_level(&q));
+    TEST_ASSERT_EQUAL_PTR(&rs[i], q.pop(&q));
+    // A reaction which already executed at this tag is not queued again.
+    TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &rs[i]));
+  }
+  TEST_ASSERT_TRUE(q.empty(&q));
+  TEST_ASSERT_EQUAL(-1, q.next_level(&q));
+  TEST_ASSERT_NULL(q.pop(&q));
+
+  // After a reset the reactions can be queued again.
+  q.reset(&q);
+  TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &rs[3]));
+  TEST_ASSERT_EQUAL_PTR(&rs[3], q.pop(&q));
+  TEST_ASSERT_TRUE(q.empty(&q));
+}
+
+void test_pop_released(void) {
+  ReactionQueue q;
+  Reaction* level_head[REACTION_QUEUE_SIZE];
+  Reaction* level_tail[REACTION_QUEUE_SIZE];
+  uint32_t ready[REACTION_QUEUE_READY_WORDS(REACTION_QUEUE_SIZE)];
+  Reaction a = {0}, b = {0}, c = {0}, d = {0};
+  ReactionQueue_ctor(&q, level_head, level_tail, ready, REACTION_QUEUE_SIZE);
+
+  // Two chains: a -> b at levels 0 and 1, and c -> d at levels 1 and 2.
+  a.level = 0;
+  a.chain_id = 0x1;
+  b.level = 1;
+  b.chain_id = 0x1;
+  c.level = 1;
+  c.chain_id = 0x6;
+  d.level = 2;
+  d.chain_id = 0x4;
+  TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &a));
+  TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &b));
+  TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &c));
+  TEST_ASSERT_EQUAL(LF_OK, q.insert(&q, &d));
+
+  Reaction* executing[2] = {NULL, NULL};
+  executing[0] = q.pop_released(&q, executing, 2);
+  TEST_ASSERT_EQUAL_PTR(&a, executing[0]);
+  // b is blocked by a, which is executing, but c is on another chain.
+  executing[1] = q.pop_released(&q, executing, 2);
+  TEST_ASSERT_EQUAL_PTR(&c, executing[1]);
+  // b is still blocked by a, and d by c.
+  TEST_ASSERT_NULL(q.pop_released(&q, executing, 2));
+
+  executing[1] = NULL;
+  TEST_ASSERT_EQUAL_PTR(&d, q.pop_released(&q, executing, 2));
+  executing[0] = NULL;
+  TEST_ASSERT_EQUAL_PTR(&b, q.pop_released(&q, executing, 2));
+  TEST_ASSERT_TRUE(q.empty(&q));
+  TEST_ASSERT_NULL(q.pop_released(&q, executing, 2));
+}
+
 Environment* _lf_environment = NULL;
 
 int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_insert);
   RUN_TEST(test_levels_with_gaps);
+  RUN_TEST(test_duplicates_and_reset);
+  RUN_TEST(test_levels_across_words);
+  RUN_TEST(test_pop_released);
   return UNITY_END();
 }
\ No newline at end of file
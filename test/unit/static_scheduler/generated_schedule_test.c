@@ -0,0 +1,167 @@
+#include "reactor-uc/reactor-uc.h"
+#include "reactor-uc/schedulers/static/scheduler.h"
+#include "reactor-uc/schedulers/static/instructions.h"
+#include "unity.h"
+
+#define NUM_TAGS 4
+#define PERIOD MSEC(1)
+
+static int sent = 0;
+static int received = 0;
+
+// Components of Reactor Source
+LF_DEFINE_TIMER_STRUCT(Source, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Source, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Source, reaction0, 1);
+LF_DEFINE_REACTION_CTOR(Source, reaction0, 0, NULL, NULL);
+LF_DEFINE_OUTPUT_STRUCT(Source, out, 1, int);
+LF_DEFINE_OUTPUT_CTOR(Source, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Source, reaction0);
+  LF_TIMER_INSTANCE(Source, t);
+  LF_PORT_INSTANCE(Source, out, 1);
+  int count;
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+} Source;
+
+LF_DEFINE_REACTION_BODY(Source, reaction0) {
+  LF_SCOPE_SELF(Source);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Source, out);
+
+  TEST_ASSERT_EQUAL(PERIOD * self->count, env->get_elapsed_logical_time(env));
+  // Only every other tag triggers the sink.
+  if (self->count++ % 2 == 0) {
+    lf_set(out, sent++);
+  }
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Source, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Source);
+  LF_INITIALIZE_REACTION(Source, reaction0, NEVER);
+  LF_INITIALIZE_TIMER(Source, t, MSEC(0), PERIOD);
+  LF_INITIALIZE_OUTPUT(Source, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->reaction0);
+  LF_PORT_REGISTER_SOURCE(self->out, self->reaction0, 1);
+  self->count = 0;
+}
+
+// Reactor Sink
+LF_DEFINE_REACTION_STRUCT(Sink, reaction0, 0)
+LF_DEFINE_REACTION_CTOR(Sink, reaction0, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Sink, in, 1, 0, int, 0)
+LF_DEFINE_INPUT_CTOR(Sink, in, 1, 0, int, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sink, reaction0);
+  LF_PORT_INSTANCE(Sink, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0)
+} Sink;
+
+LF_DEFINE_REACTION_BODY(Sink, reaction0) {
+  LF_SCOPE_SELF(Sink);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Sink, in);
+  (void)self;
+
+  // The source has executed first although the schedule lists the sink first.
+  TEST_ASSERT_TRUE(lf_is_present(in));
+  TEST_ASSERT_EQUAL(received, in->value);
+  TEST_ASSERT_EQUAL(2 * PERIOD * received, env->get_elapsed_logical_time(env));
+  received++;
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sink, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR(Sink);
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_INITIALIZE_REACTION(Sink, reaction0, NEVER);
+  LF_INITIALIZE_INPUT(Sink, in, 1, in_external);
+
+  LF_PORT_REGISTER_EFFECT(self->in, self->reaction0, 1);
+}
+
+// Reactor main
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, source_out, 1)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Main, source_out, 1)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sink, sink, 1);
+  LF_CHILD_REACTOR_INSTANCE(Source, source, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, source_out, 1, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 2)
+  LF_CHILD_OUTPUT_CONNECTIONS(source, out, 1, 1, 1);
+  LF_CHILD_OUTPUT_EFFECTS(source, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(source, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(sink, in, 1, 1, 0);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_INPUT_ARGS(sink, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sink, sink, 1, &_sink_in_args[0][0]);
+  LF_DEFINE_CHILD_OUTPUT_ARGS(source, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Source, source, 1, &_source_out_args[0][0]);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, source_out, 1, 1);
+  lf_connect(&self->source_out[0][0].super.super, &self->source->out[0].super, &self->sink->in[0].super);
+}
+
+// The entry point as the code generator emits it for `@scheduler("STATIC")`.
+static Main main_reactor;
+static Environment lf_environment;
+Environment* _lf_environment = &lf_environment;
+static StaticScheduler _scheduler;
+static Scheduler* scheduler = &_scheduler.super;
+
+// A loop over one tag, in which the sink is listed before the source and only executes if it is triggered.
+static inst_t Main_Schedule_worker0[] = {
+    {.func = execute_inst_BLT,
+     .opcode = BLT,
+     .op1.reg = &_scheduler.stop_time_reg,
+     .op2.reg = &_scheduler.time_reg,
+     .op3.imm = 6},
+    {.func = execute_inst_DU, .opcode = DU, .op1.reg = &_scheduler.time_reg, .op2.imm = 0},
+    {.func = execute_inst_EXE, .opcode = EXE, .op2.reg = (reg_t*)&main_reactor.sink[0].reaction0.super, .op3.imm = 1},
+    {.func = execute_inst_EXE, .opcode = EXE, .op2.reg = (reg_t*)&main_reactor.source[0].reaction0.super},
+    {.func = execute_inst_ADVI,
+     .opcode = ADVI,
+     .op1.reg = &_scheduler.time_reg,
+     .op2.reg = &_scheduler.time_reg,
+     .op3.imm = PERIOD},
+    {.func = execute_inst_JAL, .opcode = JAL, .op1.reg = NULL, .op2.imm = 0},
+    {.func = execute_inst_STP, .opcode = STP},
+};
+static const inst_t* Main_Schedule[1] = {Main_Schedule_worker0};
+
+void lf_exit(void) { Environment_free(&lf_environment); }
+
+void lf_start(void) {
+  StaticScheduler_ctor(&_scheduler, _lf_environment, Main_Schedule, 1, PERIOD * (NUM_TAGS - 1));
+  Environment_ctor(&lf_environment, (Reactor*)&main_reactor, scheduler, false);
+  Main_ctor(&main_reactor, NULL, _lf_environment);
+  _lf_environment->assemble(_lf_environment);
+  StaticScheduler_sort_by_level(Main_Schedule_worker0, sizeof(Main_Schedule_worker0) / sizeof(inst_t));
+  _lf_environment->start(_lf_environment);
+  lf_exit();
+}
+
+void test_run(void) {
+  lf_start();
+  TEST_ASSERT_EQUAL(NUM_TAGS / 2, sent);
+  TEST_ASSERT_EQUAL(NUM_TAGS / 2, received);
+  TEST_ASSERT_EQUAL_PTR(&main_reactor.source[0].reaction0.super, Main_Schedule_worker0[2].op2.reg);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_run);
+  return UNITY_END();
+}
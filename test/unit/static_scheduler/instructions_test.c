@@ -0,0 +1,50 @@
+#include "reactor-uc/reactor-uc.h"
+#include "reactor-uc/schedulers/static/scheduler.h"
+#include "reactor-uc/schedulers/static/instructions.h"
+#include "unity.h"
+
+Environment* _lf_environment = NULL;
+
+static reg_t counter;
+static reg_t sum;
+static reg_t limit = 10;
+static reg_t return_address;
+static reg_t five = 5;
+
+// Sums up 0..9 in a subroutine and returns the reaction handed over by EXE once the loop is done.
+static Reaction reaction;
+static const inst_t program[] = {
+    /* 0 */ {.func = execute_inst_JAL, .opcode = JAL, .op1.reg = &return_address, .op2.imm = 5},
+    /* 1 */ {.func = execute_inst_ADDI, .opcode = ADDI, .op1.reg = &counter, .op2.reg = &counter, .op3.imm = 1},
+    /* 2 */ {.func = execute_inst_BNE, .opcode = BNE, .op1.reg = &counter, .op2.reg = &limit, .op3.imm = 0},
+    /* 3 */ {.func = execute_inst_EXE, .opcode = EXE, .op2.reg = (reg_t*)&reaction},
+    /* 4 */ {.func = execute_inst_STP, .opcode = STP},
+    /* 5 */ {.func = execute_inst_ADD, .opcode = ADD, .op1.reg = &sum, .op2.reg = &sum, .op3.reg = &counter},
+    /* 6 */ {.func = execute_inst_BLT, .opcode = BLT, .op1.reg = &counter, .op2.reg = &five, .op3.imm = 8},
+    /* 7 */ {.func = execute_inst_WLT, .opcode = WLT, .op1.reg = &counter, .op2.imm = 100},
+    /* 8 */ {.func = execute_inst_JALR, .opcode = JALR, .op1.reg = NULL, .op2.reg = &return_address, .op3.imm = 0},
+};
+static const inst_t* schedule[1] = {program};
+
+void test_interpreter(void) {
+  StaticScheduler scheduler;
+  scheduler.static_schedule = schedule;
+  scheduler.pc[0] = 0;
+
+  // The schedule returns to the worker with the reaction of EXE and resumes after it.
+  TEST_ASSERT_EQUAL_PTR(&reaction, lf_sched_get_ready_reaction(&scheduler, 0));
+  TEST_ASSERT_EQUAL(4, scheduler.pc[0]);
+  TEST_ASSERT_EQUAL(10, counter);
+  TEST_ASSERT_EQUAL(45, sum);
+
+  // STP keeps the worker at the end of the schedule.
+  TEST_ASSERT_NULL(lf_sched_get_ready_reaction(&scheduler, 0));
+  TEST_ASSERT_NULL(lf_sched_get_ready_reaction(&scheduler, 0));
+  TEST_ASSERT_EQUAL(4, scheduler.pc[0]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_interpreter);
+  return UNITY_END();
+}
@@ -0,0 +1,170 @@
+#include "reactor-uc/reactor-uc.h"
+#include "reactor-uc/schedulers/static/scheduler.h"
+#include "reactor-uc/schedulers/static/instructions.h"
+#include "unity.h"
+
+#include <pthread.h>
+
+#define NUM_WORKERS 2
+#define NUM_TAGS 10
+#define PERIOD MSEC(1)
+
+static int sensed = 0;
+static int controlled = 0;
+static pthread_t sensor_thread;
+static pthread_t controller_thread;
+
+// Components of Reactor Sensor
+LF_DEFINE_TIMER_STRUCT(Sensor, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Sensor, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Sensor, r_sense, 1);
+LF_DEFINE_REACTION_CTOR(Sensor, r_sense, 0, NULL, NULL);
+LF_DEFINE_OUTPUT_STRUCT(Sensor, out, 1, int);
+LF_DEFINE_OUTPUT_CTOR(Sensor, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sensor, r_sense);
+  LF_TIMER_INSTANCE(Sensor, t);
+  LF_PORT_INSTANCE(Sensor, out, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+} Sensor;
+
+LF_DEFINE_REACTION_BODY(Sensor, r_sense) {
+  LF_SCOPE_SELF(Sensor);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Sensor, out);
+  (void)self;
+
+  // Logical time is advanced by the schedule, one period per iteration.
+  TEST_ASSERT_EQUAL(PERIOD * sensed, env->get_elapsed_logical_time(env));
+  TEST_ASSERT_TRUE(env->get_physical_time(env) >= env->get_logical_time(env));
+  sensor_thread = pthread_self();
+  lf_set(out, sensed++);
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sensor, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sensor);
+  LF_INITIALIZE_REACTION(Sensor, r_sense, NEVER);
+  LF_INITIALIZE_TIMER(Sensor, t, MSEC(0), PERIOD);
+  LF_INITIALIZE_OUTPUT(Sensor, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->r_sense);
+  LF_PORT_REGISTER_SOURCE(self->out, self->r_sense, 1);
+}
+
+// Reactor Controller
+LF_DEFINE_REACTION_STRUCT(Controller, r_control, 0)
+LF_DEFINE_REACTION_CTOR(Controller, r_control, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Controller, in, 1, 0, int, 0)
+LF_DEFINE_INPUT_CTOR(Controller, in, 1, 0, int, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Controller, r_control);
+  LF_PORT_INSTANCE(Controller, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0)
+} Controller;
+
+LF_DEFINE_REACTION_BODY(Controller, r_control) {
+  LF_SCOPE_SELF(Controller);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Controller, in);
+  (void)self;
+
+  // The sensor of the same tag has completed on the other worker.
+  TEST_ASSERT_TRUE(lf_is_present(in));
+  TEST_ASSERT_EQUAL(controlled, in->value);
+  TEST_ASSERT_EQUAL(PERIOD * controlled, env->get_elapsed_logical_time(env));
+  controller_thread = pthread_self();
+  controlled++;
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Controller, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR(Controller);
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_INITIALIZE_REACTION(Controller, r_control, NEVER);
+  LF_INITIALIZE_INPUT(Controller, in, 1, in_external);
+
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_control, 1);
+}
+
+// Reactor main
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, sensor_out, 1)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Main, sensor_out, 1)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sensor, sensor, 1);
+  LF_CHILD_REACTOR_INSTANCE(Controller, controller, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, sensor_out, 1, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 2)
+  LF_CHILD_OUTPUT_CONNECTIONS(sensor, out, 1, 1, 1);
+  LF_CHILD_OUTPUT_EFFECTS(sensor, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(sensor, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(controller, in, 1, 1, 0);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(sensor, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sensor, sensor, 1, &_sensor_out_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(controller, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Controller, controller, 1, &_controller_in_args[0][0]);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, sensor_out, 1, 1);
+  lf_connect(&self->sensor_out[0][0].super.super, &self->sensor->out[0].super, &self->controller->in[0].super);
+}
+
+LF_ENTRY_POINT_STATIC(Main, schedule, NUM_WORKERS, PERIOD * (NUM_TAGS - 1), false);
+
+// The number of iterations each worker has completed, and the number of times logical time was advanced.
+static reg_t completed[NUM_WORKERS];
+static reg_t advanced;
+
+// Worker 0 senses once physical time has reached the tag, waits for the controller and then advances logical time.
+static const inst_t sensor_schedule[] = {
+    {.func = execute_inst_DU, .opcode = DU, .op1.reg = &scheduler.time_reg, .op2.imm = 0},
+    {.func = execute_inst_EXE, .opcode = EXE, .op2.reg = (reg_t*)&main_reactor.sensor[0].r_sense.super},
+    {.func = execute_inst_ADDI, .opcode = ADDI, .op1.reg = &completed[0], .op2.reg = &completed[0], .op3.imm = 1},
+    {.func = execute_inst_WU, .opcode = WU, .op1.reg = &completed[1], .op2.imm = 0, .op3.reg = &completed[0]},
+    {.func = execute_inst_ADVI,
+     .opcode = ADVI,
+     .op1.reg = &scheduler.time_reg,
+     .op2.reg = &scheduler.time_reg,
+     .op3.imm = PERIOD},
+    {.func = execute_inst_ADDI, .opcode = ADDI, .op1.reg = &advanced, .op2.reg = &advanced, .op3.imm = 1},
+    {.func = execute_inst_BGE, .opcode = BGE, .op1.reg = &scheduler.stop_time_reg, .op2.reg = &scheduler.time_reg},
+    {.func = execute_inst_STP, .opcode = STP},
+};
+
+// Worker 1 waits for the sensor of the current iteration, controls and waits for logical time to be advanced.
+static const inst_t controller_schedule[] = {
+    {.func = execute_inst_WU, .opcode = WU, .op1.reg = &completed[0], .op2.imm = 1, .op3.reg = &completed[1]},
+    {.func = execute_inst_EXE, .opcode = EXE, .op2.reg = (reg_t*)&main_reactor.controller[0].r_control.super},
+    {.func = execute_inst_ADDI, .opcode = ADDI, .op1.reg = &completed[1], .op2.reg = &completed[1], .op3.imm = 1},
+    {.func = execute_inst_WU, .opcode = WU, .op1.reg = &advanced, .op2.imm = 0, .op3.reg = &completed[1]},
+    {.func = execute_inst_BGE, .opcode = BGE, .op1.reg = &scheduler.stop_time_reg, .op2.reg = &scheduler.time_reg},
+    {.func = execute_inst_STP, .opcode = STP},
+};
+
+static const inst_t* schedule[NUM_WORKERS] = {sensor_schedule, controller_schedule};
+
+void test_run(void) {
+  lf_start();
+  TEST_ASSERT_EQUAL(NUM_TAGS, sensed);
+  TEST_ASSERT_EQUAL(NUM_TAGS, controlled);
+  TEST_ASSERT_EQUAL(NUM_TAGS, advanced);
+  TEST_ASSERT_FALSE(pthread_equal(sensor_thread, controller_thread));
+}
+
+int main() {
+  UNITY_BEGIN();
+#if SCHEDULER_MAX_WORKERS > 1
+  RUN_TEST(test_run);
+#endif
+  return UNITY_END();
+}
@@ -0,0 +1,149 @@
+#include "reactor-uc/reactor-uc.h"
+#include "unity.h"
+
+#include <reactor-uc/schedulers/dynamic/scheduler.h>
+
+// Wide enough for the last inputs to share the overflow bit of the STP input mask.
+#define RECEIVER_WIDTH 70
+#define NUM_TAGS 10
+
+static int executed = 0;
+static int violations = 0;
+
+// Components of Reactor Sender
+LF_DEFINE_TIMER_STRUCT(Sender, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Sender, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Sender, r_sender, 1);
+LF_DEFINE_REACTION_CTOR(Sender, r_sender, 0, NULL, NULL);
+LF_DEFINE_OUTPUT_STRUCT(Sender, out, 1, int);
+LF_DEFINE_OUTPUT_CTOR(Sender, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sender, r_sender);
+  LF_TIMER_INSTANCE(Sender, t);
+  LF_PORT_INSTANCE(Sender, out, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+  int cnt;
+} Sender;
+
+LF_DEFINE_REACTION_BODY(Sender, r_sender) {
+  LF_SCOPE_SELF(Sender);
+  LF_SCOPE_PORT(Sender, out);
+  lf_set(out, self->cnt++);
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sender, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sender);
+  LF_INITIALIZE_REACTION(Sender, r_sender, NEVER);
+  LF_INITIALIZE_TIMER(Sender, t, MSEC(0), MSEC(1));
+  LF_INITIALIZE_OUTPUT(Sender, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->r_sender);
+  LF_PORT_REGISTER_SOURCE(self->out, self->r_sender, 1);
+  self->cnt = 0;
+}
+
+// Reactor Receiver. The first reaction stands in for a network input which arrives too late. On every other tag it
+// marks the first or the last input as intended for an earlier tag, and the second reaction must then handle an STP
+// violation.
+LF_DEFINE_REACTION_STRUCT(Receiver, r_late, 0)
+LF_DEFINE_REACTION_CTOR(Receiver, r_late, 0, NULL, NULL)
+LF_DEFINE_REACTION_STRUCT(Receiver, r_recv, 0)
+LF_DEFINE_REACTION_STP_VIOLATION_HANDLER(Receiver, r_recv);
+LF_DEFINE_REACTION_CTOR(Receiver, r_recv, 1, NULL, LF_REACTION_TYPE(Receiver, r_recv_stp_violation_handler))
+LF_DEFINE_INPUT_STRUCT(Receiver, in, 2, 0, int, 0)
+LF_DEFINE_INPUT_CTOR(Receiver, in, 2, 0, int, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Receiver, r_late);
+  LF_REACTION_INSTANCE(Receiver, r_recv);
+  LF_PORT_INSTANCE(Receiver, in, RECEIVER_WIDTH);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(2, RECEIVER_WIDTH, 0)
+} Receiver;
+
+LF_DEFINE_REACTION_BODY(Receiver, r_late) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_MULTIPORT(Receiver, in);
+  if (in[0]->value % 2 == 1) {
+    size_t late = in[0]->value % 4 == 1 ? 0 : in_width - 1;
+    in[late]->super.intended_tag.time -= MSEC(1);
+  }
+}
+
+LF_DEFINE_REACTION_BODY(Receiver, r_recv) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_MULTIPORT(Receiver, in);
+  TEST_ASSERT_EQUAL(0, in[0]->value % 2);
+  executed++;
+}
+
+LF_DEFINE_REACTION_STP_VIOLATION_HANDLER(Receiver, r_recv) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_MULTIPORT(Receiver, in);
+  TEST_ASSERT_EQUAL(1, in[0]->value % 2);
+  violations++;
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Receiver, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR(Receiver);
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_INITIALIZE_REACTION(Receiver, r_late, NEVER);
+  LF_INITIALIZE_REACTION(Receiver, r_recv, NEVER);
+  LF_INITIALIZE_INPUT(Receiver, in, RECEIVER_WIDTH, in_external);
+
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_late, RECEIVER_WIDTH);
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_recv, RECEIVER_WIDTH);
+}
+
+// Reactor main. The sender is connected to the first input, which has its own bit in the STP input mask, and to the
+// last input, which shares the overflow bit.
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, sender_out, 2)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Main, sender_out, 2)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sender, sender, 1);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, receiver, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, sender_out, 1, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 2)
+  LF_CHILD_OUTPUT_CONNECTIONS(sender, out, 1, 1, 1);
+  LF_CHILD_OUTPUT_EFFECTS(sender, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(sender, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(receiver, in, 1, RECEIVER_WIDTH, 0);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(sender, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sender, sender, 1, &_sender_out_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(receiver, in, 1, RECEIVER_WIDTH);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, receiver, 1, &_receiver_in_args[0][0]);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, sender_out, 1, 1);
+  lf_connect(&self->sender_out[0][0].super.super, &self->sender->out[0].super, &self->receiver->in[0].super);
+  lf_connect(&self->sender_out[0][0].super.super, &self->sender->out[0].super,
+             &self->receiver->in[RECEIVER_WIDTH - 1].super);
+}
+
+LF_ENTRY_POINT(Main, 32, 32, MSEC((NUM_TAGS - 1)), false, true);
+
+void test_run(void) {
+  lf_start();
+  TEST_ASSERT_EQUAL(NUM_TAGS / 2, executed);
+  TEST_ASSERT_EQUAL(NUM_TAGS / 2, violations);
+
+  // Only the reaction with a violation handler checks its inputs, and it depends on all of them.
+  TEST_ASSERT_EQUAL(0, main_reactor.receiver[0].r_late.super.stp_inputs);
+  TEST_ASSERT_TRUE(main_reactor.receiver[0].r_recv.super.stp_inputs == UINT64_MAX);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_run);
+  return UNITY_END();
+}
@@ -33,8 +33,68 @@ LF_REACTOR_CTOR_SIGNATURE(TimerTest) {
 
 LF_ENTRY_POINT(TimerTest, 32, 32, MSEC(100), false, false);
 
+static size_t count_fired(Timer* fired, Timer* timers, bool* seen, size_t num_timers) {
+  size_t cnt = 0;
+  for (size_t i = 0; i < num_timers; i++) {
+    seen[i] = false;
+  }
+  for (Timer* group = fired; group != NULL; group = group->fired_next) {
+    for (Timer* timer = group; timer != NULL; timer = timer->group_next) {
+      TEST_ASSERT_FALSE(seen[timer - timers]);
+      seen[timer - timers] = true;
+      cnt++;
+    }
+  }
+  return cnt;
+}
+
+void test_timer_queue(void) {
+  TimerQueue q;
+  Timer timers[6];
+  bool seen[6];
+  TimerQueue_ctor(&q);
+  TEST_ASSERT_TRUE(q.empty(&q));
+  TEST_ASSERT_EQUAL(0, lf_tag_compare(q.next_tag(&q), FOREVER_TAG));
+
+  // Timers 0-2 have period 2, timers 3-4 period 3 and timer 5 is a single-shot timer. Timer 2 is offset by one
+  // period and must join the group of timers 0-1 once they are re-armed.
+  interval_t periods[6] = {2, 2, 2, 3, 3, NEVER};
+  instant_t offsets[6] = {0, 0, 2, 0, 0, 1};
+  for (size_t i = 0; i < 6; i++) {
+    timers[i].period = periods[i];
+    tag_t tag = {.time = offsets[i], .microstep = 0};
+    q.insert(&q, &timers[i], tag);
+  }
+
+  for (instant_t time = 0; time <= 12; time++) {
+    tag_t tag = {.time = time, .microstep = 0};
+    tag_t next = q.next_tag(&q);
+    TEST_ASSERT_TRUE(lf_tag_compare(next, tag) >= 0);
+    Timer* fired = q.pop(&q, tag);
+    size_t cnt = count_fired(fired, timers, seen, 6);
+    size_t expected = 0;
+    for (size_t i = 0; i < 6; i++) {
+      bool periodic = time > offsets[i] && periods[i] > NEVER && (time - offsets[i]) % periods[i] == 0;
+      bool due = time == offsets[i] || periodic;
+      TEST_ASSERT_EQUAL(due, seen[i]);
+      expected += due;
+    }
+    TEST_ASSERT_EQUAL(expected, cnt);
+    TEST_ASSERT_EQUAL(expected > 0, lf_tag_compare(next, tag) == 0);
+  }
+  TEST_ASSERT_FALSE(q.empty(&q));
+
+  // All period-2 timers share a single group after timer 2 has joined it.
+  size_t groups = 0;
+  for (Timer* group = q.head; group != NULL; group = group->next_group) {
+    groups++;
+  }
+  TEST_ASSERT_EQUAL(2, groups);
+}
+
 int main() {
   UNITY_BEGIN();
+  RUN_TEST(test_timer_queue);
   RUN_TEST(lf_start);
   return UNITY_END();
 }
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "reactor-uc/reactor-uc.h"
+#include "reactor-uc/schedulers/dynamic/scheduler.h"
+#include "unity.h"
+
+typedef struct {
+  int tick;
+  char data[4096];
+} Frame;
+
+// The sender holds at most two frames at a time, one in the delayed connection and the one of the current tag. Any
+// leaked reference exhausts the pool within a few tags.
+LF_DEFINE_TOKEN_POOL_STRUCT(FramePool, Frame, 3);
+static FramePool frames;
+
+// Reactor Sender
+LF_DEFINE_TIMER_STRUCT(Sender, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Sender, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Sender, r_send, 2);
+LF_DEFINE_REACTION_CTOR(Sender, r_send, 0, NULL, NULL);
+LF_DEFINE_REACTION_STRUCT(Sender, r_act, 0);
+LF_DEFINE_REACTION_CTOR(Sender, r_act, 1, NULL, NULL);
+LF_DEFINE_ACTION_STRUCT(Sender, act, LogicalAction, 1, 1, 0, 2, Token*);
+LF_DEFINE_ACTION_CTOR(Sender, act, LogicalAction, ACTION_POLICY_DEFER, 1, 1, 0, 2, Token*);
+LF_DEFINE_OUTPUT_STRUCT(Sender, out, 1, Token*);
+LF_DEFINE_OUTPUT_CTOR(Sender, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sender, r_send);
+  LF_REACTION_INSTANCE(Sender, r_act);
+  LF_TIMER_INSTANCE(Sender, t);
+  LF_ACTION_INSTANCE(Sender, act);
+  LF_PORT_INSTANCE(Sender, out, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(2, 3, 0);
+  int tick;
+} Sender;
+
+LF_DEFINE_REACTION_BODY(Sender, r_send) {
+  LF_SCOPE_SELF(Sender);
+  LF_SCOPE_PORT(Sender, out);
+  LF_SCOPE_ACTION(Sender, act);
+
+  Token* token = lf_new_token(&frames);
+  TEST_ASSERT_NOT_NULL(token);
+  Frame* frame = token->value;
+  frame->tick = self->tick++;
+  lf_set_token(out, token);
+  // Scheduling past the stop tag fails in the last tag, the action then drops its reference right away.
+  lf_schedule_token(act, MSEC(5), token);
+}
+
+LF_DEFINE_REACTION_BODY(Sender, r_act) {
+  LF_SCOPE_SELF(Sender);
+  LF_SCOPE_ENV();
+  LF_SCOPE_ACTION(Sender, act);
+  Frame* frame = lf_get_token(act)->value;
+  TEST_ASSERT_EQUAL((env->get_elapsed_logical_time(env) - MSEC(5)) / MSEC(10), frame->tick);
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sender, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sender);
+  LF_INITIALIZE_REACTION(Sender, r_send, NEVER);
+  LF_INITIALIZE_REACTION(Sender, r_act, NEVER);
+  LF_INITIALIZE_TIMER(Sender, t, MSEC(0), MSEC(10));
+  LF_INITIALIZE_ACTION(Sender, act, MSEC(0), MSEC(0));
+  LF_INITIALIZE_OUTPUT(Sender, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->r_send);
+  LF_ACTION_REGISTER_SOURCE(self->act, self->r_send);
+  LF_ACTION_REGISTER_EFFECT(self->act, self->r_act);
+  LF_PORT_REGISTER_SOURCE(self->out, self->r_send, 1);
+  self->tick = 0;
+}
+
+// Reactor Receiver, connected to the sender at the same tag.
+LF_DEFINE_REACTION_STRUCT(Receiver, r_recv, 0)
+LF_DEFINE_REACTION_CTOR(Receiver, r_recv, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Receiver, in, 1, 0, Token*, 0)
+LF_DEFINE_INPUT_CTOR(Receiver, in, 1, 0, Token*, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Receiver, r_recv);
+  LF_PORT_INSTANCE(Receiver, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+} Receiver;
+
+LF_DEFINE_REACTION_BODY(Receiver, r_recv) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Receiver, in);
+  Frame* frame = lf_get_token(in)->value;
+  TEST_ASSERT_EQUAL(env->get_elapsed_logical_time(env) / MSEC(10), frame->tick);
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Receiver, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Receiver);
+  LF_INITIALIZE_REACTION(Receiver, r_recv, NEVER);
+  LF_INITIALIZE_INPUT(Receiver, in, 1, in_external);
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_recv, 1);
+}
+
+// Reactor Delayed, connected to the sender through a delayed connection.
+LF_DEFINE_REACTION_STRUCT(Delayed, r_recv, 0)
+LF_DEFINE_REACTION_CTOR(Delayed, r_recv, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Delayed, in, 1, 0, Token*, 0)
+LF_DEFINE_INPUT_CTOR(Delayed, in, 1, 0, Token*, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Delayed, r_recv);
+  LF_PORT_INSTANCE(Delayed, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+} Delayed;
+
+LF_DEFINE_REACTION_BODY(Delayed, r_recv) {
+  LF_SCOPE_SELF(Delayed);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Delayed, in);
+  Token* token = lf_get_token(in);
+  Frame* frame = token->value;
+  TEST_ASSERT_EQUAL((env->get_elapsed_logical_time(env) - MSEC(15)) / MSEC(10), frame->tick);
+  // The event of the delayed connection dropped its reference when the input took one.
+  TEST_ASSERT_EQUAL(1, token->ref_count);
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Delayed, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Delayed);
+  LF_INITIALIZE_REACTION(Delayed, r_recv, NEVER);
+  LF_INITIALIZE_INPUT(Delayed, in, 1, in_external);
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_recv, 1);
+}
+
+// Reactor main
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, sender_out, 1)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Main, sender_out, 1)
+LF_DEFINE_DELAYED_CONNECTION_STRUCT(Main, sender_out_delayed, 1, Token*, 2)
+LF_DEFINE_DELAYED_CONNECTION_CTOR(Main, sender_out_delayed, 1, 2, false)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sender, sender, 1);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, receiver, 1);
+  LF_CHILD_REACTOR_INSTANCE(Delayed, delayed, 1);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, sender_out, 1, 1);
+  LF_DELAYED_CONNECTION_INSTANCE(Main, sender_out_delayed, 1, 1);
+  LF_CHILD_OUTPUT_CONNECTIONS(sender, out, 1, 1, 2);
+  LF_CHILD_OUTPUT_EFFECTS(sender, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(sender, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(receiver, in, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(delayed, in, 1, 1, 0);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 3);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(sender, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sender, sender, 1, &_sender_out_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(receiver, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, receiver, 1, &_receiver_in_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(delayed, in, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Delayed, delayed, 1, &_delayed_in_args[0][0]);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, sender_out, 1, 1);
+  LF_INITIALIZE_DELAYED_CONNECTION(Main, sender_out_delayed, MSEC(15), 1, 1);
+  lf_connect(&self->sender_out[0][0].super.super, &self->sender->out[0].super, &self->receiver->in[0].super);
+  lf_connect(&self->sender_out_delayed[0][0].super.super, &self->sender->out[0].super, &self->delayed->in[0].super);
+}
+
+LF_ENTRY_POINT(Main, 32, 32, MSEC(100), false, false);
+
+void test_release_unused_token(void) {
+  LF_INITIALIZE_TOKEN_POOL(&frames);
+  for (int i = 0; i < 10; i++) {
+    Token* token = lf_new_token(&frames);
+    TEST_ASSERT_NOT_NULL(token);
+    Token_release(token);
+  }
+}
+
+void test_reference_counting(void) {
+  LF_INITIALIZE_TOKEN_POOL(&frames);
+  Token* first = lf_new_token(&frames);
+  Token* slot = NULL;
+  Token_assign(&slot, first);
+  Token_retain(first);
+  TEST_ASSERT_EQUAL(2, first->ref_count);
+
+  // Replacing the token in the slot drops its reference, but the token survives with the one taken by retain.
+  Token* second = lf_new_token(&frames);
+  Token_assign(&slot, second);
+  TEST_ASSERT_EQUAL(1, first->ref_count);
+  TEST_ASSERT_EQUAL(1, second->ref_count);
+  TEST_ASSERT_NOT_NULL(lf_new_token(&frames));
+  TEST_ASSERT_NULL(lf_new_token(&frames));
+
+  Token_release(first);
+  Token_assign(&slot, NULL);
+  TEST_ASSERT_NULL(slot);
+  TEST_ASSERT_NOT_NULL(lf_new_token(&frames));
+  TEST_ASSERT_NOT_NULL(lf_new_token(&frames));
+}
+
+void test_zero_copy_fan_out(void) {
+  LF_INITIALIZE_TOKEN_POOL(&frames);
+  lf_start();
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_zero_copy_fan_out);
+  RUN_TEST(test_release_unused_token);
+  RUN_TEST(test_reference_counting);
+  return UNITY_END();
+}
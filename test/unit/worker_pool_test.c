@@ -0,0 +1,151 @@
+#include "reactor-uc/reactor-uc.h"
+#include "unity.h"
+
+#include <reactor-uc/schedulers/dynamic/scheduler.h>
+#include <stdatomic.h>
+
+#define NUM_RECEIVERS 4
+
+static int tags_sent = 0;
+static atomic_int received = 0;
+
+// Components of Reactor Sender
+LF_DEFINE_TIMER_STRUCT(Sender, t, 1, 0);
+LF_DEFINE_TIMER_CTOR(Sender, t, 1, 0);
+LF_DEFINE_REACTION_STRUCT(Sender, r_sender, 1);
+LF_DEFINE_REACTION_CTOR(Sender, r_sender, 0, NULL, NULL);
+LF_DEFINE_OUTPUT_STRUCT(Sender, out, 1, int);
+LF_DEFINE_OUTPUT_CTOR(Sender, out, 1);
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Sender, r_sender);
+  LF_TIMER_INSTANCE(Sender, t);
+  LF_PORT_INSTANCE(Sender, out, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0);
+} Sender;
+
+LF_DEFINE_REACTION_BODY(Sender, r_sender) {
+  LF_SCOPE_SELF(Sender);
+  LF_SCOPE_ENV();
+  LF_SCOPE_PORT(Sender, out);
+  (void)self;
+
+  // All receivers of the previous tag must have completed before the next tag starts.
+  TEST_ASSERT_EQUAL(NUM_RECEIVERS * tags_sent, atomic_load(&received));
+
+  // Switch between parallel and sequential execution while the program is running.
+  DynamicScheduler* scheduler = (DynamicScheduler*)env->scheduler;
+  if (tags_sent == 0) {
+    TEST_ASSERT_EQUAL(LF_OK, DynamicScheduler_set_num_workers(scheduler, NUM_RECEIVERS));
+  } else if (tags_sent == 10) {
+    TEST_ASSERT_EQUAL(LF_OK, DynamicScheduler_set_num_workers(scheduler, 1));
+  } else if (tags_sent == 20) {
+    TEST_ASSERT_EQUAL(LF_OK, DynamicScheduler_set_num_workers(scheduler, 2));
+    TEST_ASSERT_EQUAL(LF_OK, DynamicScheduler_set_worker_policy(scheduler, WORKER_POOL_CHAIN_RELEASE));
+  }
+  TEST_ASSERT_EQUAL(LF_INVALID_VALUE, DynamicScheduler_set_num_workers(scheduler, 0));
+  TEST_ASSERT_EQUAL(LF_INVALID_VALUE, DynamicScheduler_set_num_workers(scheduler, SCHEDULER_MAX_WORKERS + 1));
+
+  lf_set(out, tags_sent);
+  tags_sent++;
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Sender, OutputExternalCtorArgs* out_external) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Sender);
+  LF_INITIALIZE_REACTION(Sender, r_sender, NEVER);
+  LF_INITIALIZE_TIMER(Sender, t, MSEC(0), MSEC(1));
+  LF_INITIALIZE_OUTPUT(Sender, out, 1, out_external);
+
+  LF_TIMER_REGISTER_EFFECT(self->t, self->r_sender);
+  LF_PORT_REGISTER_SOURCE(self->out, self->r_sender, 1);
+}
+
+// Reactor Receiver
+LF_DEFINE_REACTION_STRUCT(Receiver, r_recv, 0)
+LF_DEFINE_REACTION_CTOR(Receiver, r_recv, 0, NULL, NULL)
+LF_DEFINE_INPUT_STRUCT(Receiver, in, 1, 0, int, 0)
+LF_DEFINE_INPUT_CTOR(Receiver, in, 1, 0, int, 0)
+
+typedef struct {
+  Reactor super;
+  LF_REACTION_INSTANCE(Receiver, r_recv);
+  LF_PORT_INSTANCE(Receiver, in, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(1, 1, 0)
+} Receiver;
+
+LF_DEFINE_REACTION_BODY(Receiver, r_recv) {
+  LF_SCOPE_SELF(Receiver);
+  LF_SCOPE_PORT(Receiver, in);
+  (void)self;
+
+  TEST_ASSERT_EQUAL(tags_sent - 1, in->value);
+  atomic_fetch_add(&received, 1);
+}
+
+LF_REACTOR_CTOR_SIGNATURE_WITH_PARAMETERS(Receiver, InputExternalCtorArgs* in_external) {
+  LF_REACTOR_CTOR(Receiver);
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_INITIALIZE_REACTION(Receiver, r_recv, NEVER);
+  LF_INITIALIZE_INPUT(Receiver, in, 1, in_external);
+
+  LF_PORT_REGISTER_EFFECT(self->in, self->r_recv, 1);
+}
+
+// Reactor main
+LF_DEFINE_LOGICAL_CONNECTION_STRUCT(Main, sender_out, NUM_RECEIVERS)
+LF_DEFINE_LOGICAL_CONNECTION_CTOR(Main, sender_out, NUM_RECEIVERS)
+
+typedef struct {
+  Reactor super;
+  LF_CHILD_REACTOR_INSTANCE(Sender, sender, 1);
+  LF_CHILD_REACTOR_INSTANCE(Receiver, receiver, NUM_RECEIVERS);
+  LF_LOGICAL_CONNECTION_INSTANCE(Main, sender_out, 1, 1);
+  LF_REACTOR_BOOKKEEPING_INSTANCES(0, 0, 1 + NUM_RECEIVERS)
+  LF_CHILD_OUTPUT_CONNECTIONS(sender, out, 1, 1, 1);
+  LF_CHILD_OUTPUT_EFFECTS(sender, out, 1, 1, 0);
+  LF_CHILD_OUTPUT_OBSERVERS(sender, out, 1, 1, 0);
+  LF_CHILD_INPUT_SOURCES(receiver, in, NUM_RECEIVERS, 1, 0);
+} Main;
+
+LF_REACTOR_CTOR_SIGNATURE(Main) {
+  LF_REACTOR_CTOR_PREAMBLE();
+  LF_REACTOR_CTOR(Main);
+
+  LF_DEFINE_CHILD_OUTPUT_ARGS(sender, out, 1, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Sender, sender, 1, &_sender_out_args[0][0]);
+  LF_DEFINE_CHILD_INPUT_ARGS(receiver, in, NUM_RECEIVERS, 1);
+  LF_INITIALIZE_CHILD_REACTOR_WITH_PARAMETERS(Receiver, receiver, NUM_RECEIVERS, &_receiver_in_args[i][0]);
+
+  LF_INITIALIZE_LOGICAL_CONNECTION(Main, sender_out, 1, 1);
+  for (int i = 0; i < NUM_RECEIVERS; i++) {
+    lf_connect(&self->sender_out[0][0].super.super, &self->sender->out[0].super, &self->receiver[i].in[0].super);
+  }
+}
+
+LF_ENTRY_POINT(Main, 32, 32, MSEC(30), false, true);
+
+void test_run(void) {
+  lf_start();
+  TEST_ASSERT_EQUAL(31, tags_sent);
+  TEST_ASSERT_EQUAL(NUM_RECEIVERS * tags_sent, atomic_load(&received));
+
+  // The sender is upstream of every receiver, while the receivers are independent of each other.
+  Reaction* sender = &main_reactor.sender[0].r_sender.super;
+  for (int i = 0; i < NUM_RECEIVERS; i++) {
+    Reaction* receiver = &main_reactor.receiver[i].r_recv.super;
+    TEST_ASSERT_TRUE((sender->chain_id & receiver->chain_id) != 0);
+    for (int j = i + 1; j < NUM_RECEIVERS; j++) {
+      TEST_ASSERT_EQUAL(0, receiver->chain_id & main_reactor.receiver[j].r_recv.super.chain_id);
+    }
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+#if SCHEDULER_MAX_WORKERS > 1
+  RUN_TEST(test_run);
+#endif
+  return UNITY_END();
+}
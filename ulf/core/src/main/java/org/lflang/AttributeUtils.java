@@ -252,6 +252,14 @@ public class AttributeUtils {
     }
   }
 
+  /**
+   * Return true if the connection has an {@code @alias} attribute, i.e. the downstream inputs read
+   * the value from the buffer of the upstream output instead of getting a copy of it.
+   */
+  public static boolean isAliasingConnection(Connection node) {
+    return findAttributeByName(node, "alias") != null;
+  }
+
   public static Attribute getLinkAttribute(Connection node) {
     return findAttributeByName(node, "link");
   }
@@ -345,6 +353,19 @@ public class AttributeUtils {
     }
   }
 
+  /**
+   * Return the value of the `@scheduler` attribute of the main reactor, or the empty string if it
+   * is not annotated.
+   */
+  public static String getSchedulerAttrValue(Reactor node) {
+    Attribute attr = findAttributeByName(node, "scheduler");
+    if (attr != null) {
+      return StringUtil.removeQuotes(attr.getAttrParms().get(0).getValue());
+    } else {
+      return "";
+    }
+  }
+
   /*
    * Return the Fast Attribute value set on the main reactor
    */
@@ -284,6 +284,8 @@ public class AttributeSpec {
     ATTRIBUTE_SPECS_BY_NAME.put(
         "buffer",
         new AttributeSpec(List.of(new AttrParamSpec(VALUE_ATTR, AttrParamType.INT, false))));
+    // @alias
+    ATTRIBUTE_SPECS_BY_NAME.put("alias", new AttributeSpec(null));
     // @interface_tcp(name="string", address="string") e.g. @interface:tcp(name="if1",
     // address="127.0.0.1")
 
@@ -461,6 +463,24 @@ public class AttributeSpec {
         "keepalive",
         new AttributeSpec(List.of(new AttrParamSpec(VALUE_ATTR, AttrParamType.BOOLEAN, false))));
 
+    // @scheduler("STATIC")
+    ATTRIBUTE_SPECS_BY_NAME_REACTOR.put(
+        "scheduler",
+        new AttributeSpec(
+            List.of(
+                new AttrParamSpec(
+                    VALUE_ATTR,
+                    AttrParamType.STRING,
+                    false,
+                    (v, a) -> {
+                      if (!List.of("DYNAMIC", "STATIC")
+                          .contains(StringUtil.removeQuotes(a.getValue()))) {
+                        v.error(
+                            "Incorrect type: scheduler should have value \"DYNAMIC\" or"
+                                + " \"STATIC\".",
+                            Literals.ATTRIBUTE__ATTR_NAME);
+                      }
+                    }))));
     // @build_type("RELEASE")
     // Only for the native platform
     ATTRIBUTE_SPECS_BY_NAME_REACTOR.put(
@@ -480,5 +500,32 @@ public class AttributeSpec {
                             Literals.ATTRIBUTE__ATTR_NAME);
                       }
                     }))));
+    // @rt_profile(policy="FIFO", priority=80, cpu=1, lock_memory=true)
+    // Only for the native platform
+    ATTRIBUTE_SPECS_BY_NAME_REACTOR.put(
+        "rt_profile",
+        new AttributeSpec(
+            List.of(
+                new AttrParamSpec(
+                    "policy", AttrParamType.STRING, true, AttributeSpec::checkSchedulingPolicy),
+                new AttrParamSpec("priority", AttrParamType.INT, true),
+                new AttrParamSpec("cpu", AttrParamType.INT, true),
+                new AttrParamSpec(
+                    "channel_policy",
+                    AttrParamType.STRING,
+                    true,
+                    AttributeSpec::checkSchedulingPolicy),
+                new AttrParamSpec("channel_priority", AttrParamType.INT, true),
+                new AttrParamSpec("channel_cpu", AttrParamType.INT, true),
+                new AttrParamSpec("lock_memory", AttrParamType.BOOLEAN, true),
+                new AttrParamSpec("prefault_stack", AttrParamType.INT, true))));
+  }
+
+  private static void checkSchedulingPolicy(LFValidator v, AttrParm a) {
+    if (!List.of("FIFO", "RR", "OTHER").contains(StringUtil.removeQuotes(a.getValue()))) {
+      v.error(
+          "Incorrect type: " + a.getName() + " should have value \"FIFO\", \"RR\" or \"OTHER\".",
+          Literals.ATTRIBUTE__ATTR_NAME);
+    }
   }
 }
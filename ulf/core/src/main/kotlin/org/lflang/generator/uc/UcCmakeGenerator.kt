@@ -19,6 +19,8 @@ abstract class UcCmakeGenerator(
 
   abstract fun generateIncludeCmake(sources: List<Path>): String
 
+  open fun generateSchedulerOption(): String = ""
+
   fun doGenerateIncludeCmake(sources: List<Path>, compileDefs: List<String>) =
       with(PrependOperator) {
         """ |# This file was generated by the Lingua Franca Compiler for the program $mainTarget
@@ -33,6 +35,7 @@ abstract class UcCmakeGenerator(
             |set(LFC_GEN_MAIN "$S{CMAKE_CURRENT_LIST_DIR}/lf_main.c")
             |set(RUNTIME_PATH $S{CMAKE_CURRENT_LIST_DIR}/reactor-uc)
             |set(LFC_GEN_INCLUDE_DIRS $S{CMAKE_CURRENT_LIST_DIR})
+            |${generateSchedulerOption()}
         """
             .trimMargin()
       }
@@ -75,6 +78,12 @@ open class UcCmakeGeneratorNonFederated(
 ) : UcCmakeGenerator(UcLoggingLevelAttribute(mainDef.reactor), buildType, fileConfig) {
   override val mainTarget = fileConfig.name
 
+  // The runtime must be built with the scheduler which executes the generated schedule.
+  override fun generateSchedulerOption() =
+      if (UcStaticScheduleGenerator.isEnabled(mainDef.reactor))
+          "set(SCHEDULER STATIC CACHE STRING \"Scheduler to use (DYNAMIC or STATIC)\")"
+      else ""
+
   override fun generateIncludeCmake(sources: List<Path>) =
       doGenerateIncludeCmake(sources, emptyList())
 }
@@ -59,6 +59,10 @@ open class UcGroupedConnection(
 
   val isDelayed = lfConn.isPhysical || !isLogical // We define physical connections as delayed.
 
+  // Downstream inputs of an aliasing connection read the value from the buffer of the upstream
+  // output, they must use `lf_get` instead of `->value`. Only applies to logical connections.
+  val isAliasing = isLogical && AttributeUtils.isAliasingConnection(lfConn)
+
   private var uid: Int = -1
 
   val bankWidth = srcInst?.codeWidth ?: 1
@@ -31,6 +31,7 @@ object UcGeneratorFactory {
    * @param numEvents Number of events in the system
    * @param numReactions Number of reactions in the system
    * @param fileConfig File configuration for path resolution
+   * @param scheduleGenerator The static schedule, if the program is executed by the StaticScheduler
    * @return A platform-specific UcMainGeneratorNonFederated instance
    */
   fun createMainGenerator(
@@ -38,7 +39,12 @@ object UcGeneratorFactory {
       numEvents: Int,
       numReactions: Int,
       fileConfig: UcFileConfig,
+      scheduleGenerator: UcStaticScheduleGenerator? = null,
   ): UcMainGeneratorNonFederated {
+    if (scheduleGenerator != null) {
+      return UcMainGeneratorStatic(main, numEvents, numReactions, fileConfig, scheduleGenerator)
+    }
+
     val platform = AttributeUtils.getPlatform(main)
 
     return when (platform) {
@@ -57,6 +57,8 @@ abstract class UcMainGenerator(
 
   fun fast() = if (AttributeUtils.getFastAttrValue(reactor)) "true" else "false"
 
+  fun generateSetRtProfile() = UcRtProfileGenerator(reactor).generateSetRtProfile()
+
   fun generateDefineQueues() =
       with(PrependOperator) {
         """
@@ -162,8 +164,54 @@ open class UcMainGeneratorNonFederated(
         ${" |  "..generateInitializeQueues()}
         ${" |  "..generateInitializeScheduler()}
             |    Environment_ctor(&lf_environment, (Reactor *)&main_reactor, scheduler, ${fast()});
+        ${" |    "..generateSetRtProfile()}
+            |    ${main.codeType}_ctor(&main_reactor, NULL, _lf_environment ${ucParameterGenerator.generateReactorCtorDefaultArguments()});
+            |    _lf_environment->assemble(_lf_environment);
+            |    _lf_environment->start(_lf_environment);
+            |    lf_exit();
+            |}
+        """
+            .trimMargin()
+      }
+}
+
+/**
+ * Generates the entry point of a program which is executed by the StaticScheduler. There are no
+ * event or reaction queues, the schedule generated by [UcStaticScheduleGenerator] decides when
+ * each reaction executes.
+ */
+class UcMainGeneratorStatic(
+    main: Reactor,
+    numEvents: Int,
+    numReactions: Int,
+    fileConfig: UcFileConfig,
+    private val scheduleGenerator: UcStaticScheduleGenerator,
+) : UcMainGeneratorNonFederated(main, numEvents, numReactions, fileConfig) {
+  private val scheduleName = UcStaticScheduleGenerator.scheduleName
+
+  override fun generateStartSource() =
+      with(PrependOperator) {
+        """
+            |#include "reactor-uc/reactor-uc.h"
+            |#include "reactor-uc/schedulers/static/scheduler.h"
+            |#include "reactor-uc/schedulers/static/instructions.h"
+            |#include "${fileConfig.getReactorHeaderPath(main).toUnixString()}"
+            |static ${main.codeType} main_reactor;
+            |static Environment lf_environment;
+            |Environment *_lf_environment = &lf_environment;
+            |static StaticScheduler _scheduler;
+            |static Scheduler* scheduler = &_scheduler.super;
+        ${" |"..scheduleGenerator.generateDefineSchedule()}
+            |void lf_exit(void) {
+            |   Environment_free(&lf_environment);
+            |}
+            |void lf_start(void) {
+            |    StaticScheduler_ctor(&_scheduler, _lf_environment, ${scheduleName}, 1, ${getTimeout()});
+            |    Environment_ctor(&lf_environment, (Reactor *)&main_reactor, scheduler, ${fast()});
+        ${" |    "..generateSetRtProfile()}
             |    ${main.codeType}_ctor(&main_reactor, NULL, _lf_environment ${ucParameterGenerator.generateReactorCtorDefaultArguments()});
             |    _lf_environment->assemble(_lf_environment);
+            |    ${scheduleGenerator.generateSortSchedule()}
             |    _lf_environment->start(_lf_environment);
             |    lf_exit();
             |}
@@ -239,6 +287,7 @@ class UcMainGeneratorFederated(
             |    FederatedEnvironment_ctor(&lf_environment, (Reactor *)&main_reactor, scheduler, ${fast()},  
             |                     (FederatedConnectionBundle **) &main_reactor._bundles, ${netBundlesSize}, &main_reactor.${UcStartupCoordinatorGenerator.instName}.super, 
             |                     &main_reactor.${UcShutdownCoordinatorGenerator.instName}.super, ${if (clockSyncGenerator.enabled()) "&main_reactor.${UcClockSyncGenerator.instName}.super" else "NULL"});
+        ${" |    "..generateSetRtProfile()}
             |    ${currentFederate.codeType}_ctor(&main_reactor, NULL, _lf_environment);
             |    _lf_environment->assemble(_lf_environment);
             |    _lf_environment->start(_lf_environment);
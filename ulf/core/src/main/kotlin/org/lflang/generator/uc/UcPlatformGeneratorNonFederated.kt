@@ -12,6 +12,12 @@ class UcPlatformGeneratorNonFederated(generator: UcGenerator, override val srcGe
   override fun generatePlatformFiles() {
     val numEventsAndReactions = generator.totalNumEventsAndReactions(generator.mainDef.reactor)
 
+    var scheduleGenerator: UcStaticScheduleGenerator? = null
+    if (UcStaticScheduleGenerator.isEnabled(mainReactor)) {
+      scheduleGenerator = UcStaticScheduleGenerator(mainReactor, messageReporter)
+      if (!scheduleGenerator.prepare()) return
+    }
+
     // Use factory to create the appropriate platform-specific generators
     val mainGenerator =
         UcGeneratorFactory.createMainGenerator(
@@ -19,6 +25,7 @@ class UcPlatformGeneratorNonFederated(generator: UcGenerator, override val srcGe
             numEventsAndReactions.first,
             numEventsAndReactions.second,
             generator.fileConfig,
+            scheduleGenerator,
         )
 
     val cmakeGenerator =
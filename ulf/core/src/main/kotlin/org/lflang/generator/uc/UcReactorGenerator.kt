@@ -122,8 +122,9 @@ class UcReactorGenerator(
     }
   }
 
+  // Timers are kept in the TimerQueue of the scheduler and need no space in the event queue.
   fun getMaxNumPendingEvents(): Int {
-    var numEvents = reactor.allTimers.count()
+    var numEvents = 0
     for (action in reactor.allActions) {
       numEvents += action.maxNumPendingEvents
     }
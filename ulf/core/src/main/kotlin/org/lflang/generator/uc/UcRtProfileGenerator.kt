@@ -0,0 +1,78 @@
+package org.lflang.generator.uc
+
+import org.lflang.*
+import org.lflang.generator.PrependOperator
+import org.lflang.lf.*
+
+/** The scheduling of one thread, as given by the `@rt_profile` attribute. */
+data class UcThreadProfile(val policy: String, val priority: Int, val cpu: Int?) {
+  fun toCCode() = "{.policy = SCHED_${policy}, .priority = ${priority}, .cpu = ${cpu ?: -1}}"
+}
+
+data class UcRtProfileParameters(
+    val scheduler: UcThreadProfile,
+    val channel: UcThreadProfile,
+    val lockMemory: Boolean = UcRtProfileParameters.DEFAULT_LOCK_MEMORY,
+    val prefaultStack: Int = UcRtProfileParameters.DEFAULT_PREFAULT_STACK,
+) {
+  companion object {
+    const val DEFAULT_POLICY = "FIFO"
+    const val DEFAULT_RT_PRIORITY = 50
+    const val DEFAULT_LOCK_MEMORY = true
+    const val DEFAULT_PREFAULT_STACK = 0
+
+    // Real-time policies need a priority of at least 1, SCHED_OTHER only accepts 0.
+    private fun defaultPriority(policy: String) = if (policy == "OTHER") 0 else DEFAULT_RT_PRIORITY
+
+    // Initializes the parameters from an Attribute object. The channel worker threads are scheduled
+    // like the scheduler thread, unless configured otherwise.
+    fun fromAttribute(attr: Attribute): UcRtProfileParameters {
+      val policy = attr.getParamString("policy") ?: DEFAULT_POLICY
+      val priority = attr.getParamInt("priority") ?: defaultPriority(policy)
+      val channelPolicy = attr.getParamString("channel_policy") ?: policy
+      val channelPriority =
+          attr.getParamInt("channel_priority")
+              ?: if (channelPolicy == policy) priority else defaultPriority(channelPolicy)
+      return UcRtProfileParameters(
+          scheduler = UcThreadProfile(policy, priority, attr.getParamInt("cpu")),
+          channel =
+              UcThreadProfile(channelPolicy, channelPriority, attr.getParamInt("channel_cpu")),
+          lockMemory = attr.getParamBool("lock_memory") ?: DEFAULT_LOCK_MEMORY,
+          prefaultStack = attr.getParamInt("prefault_stack") ?: DEFAULT_PREFAULT_STACK,
+      )
+    }
+  }
+}
+
+/**
+ * Generates the code which applies the `@rt_profile` of the main reactor. The profile must be set
+ * after the environment, and thereby the platform, is constructed and before the reactors are, as
+ * the TcpIpChannels start their worker threads in their constructors. Only the POSIX platform
+ * supports profiles, on other platforms the attribute has no effect.
+ */
+class UcRtProfileGenerator(main: Reactor) {
+  private val params =
+      AttributeUtils.findAttributeByName(main, "rt_profile")?.let {
+        UcRtProfileParameters.fromAttribute(it)
+      }
+
+  fun generateSetRtProfile() =
+      if (params == null) ""
+      else
+          with(PrependOperator) {
+            """
+            |#if defined(PLATFORM_POSIX)
+            |{
+            |  static const RtProfilePosix rt_profile = {
+            |    .scheduler = ${params.scheduler.toCCode()},
+            |    .channel = ${params.channel.toCCode()},
+            |    .lock_memory = ${params.lockMemory},
+            |    .prefault_stack_size = ${params.prefaultStack},
+            |  };
+            |  PlatformPosix_set_rt_profile((PlatformPosix*)_lf_environment->platform, &rt_profile);
+            |}
+            |#endif
+            """
+                .trimMargin()
+          }
+}
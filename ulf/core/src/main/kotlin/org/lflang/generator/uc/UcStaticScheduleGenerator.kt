@@ -0,0 +1,275 @@
+package org.lflang.generator.uc
+
+import org.eclipse.emf.ecore.EObject
+import org.lflang.*
+import org.lflang.ast.ASTUtils
+import org.lflang.generator.PrependOperator
+import org.lflang.generator.uc.UcInstanceGenerator.Companion.codeWidth
+import org.lflang.generator.uc.UcReactorGenerator.Companion.hasShutdown
+import org.lflang.lf.*
+import org.lflang.target.PlatformType
+
+/**
+ * Generates the instructions which the StaticScheduler executes instead of popping events and
+ * reactions off queues. This is only possible for programs whose reactions are driven by startup,
+ * timers with literal offsets and periods, and logical connections. The timers fire periodically
+ * with the hyperperiod of their periods, so the schedule consists of a prologue with the tags
+ * before all timers are in phase, followed by a loop over the tags of one hyperperiod.
+ *
+ * Every tag waits for physical time to reach it and then executes the reactions triggered by
+ * startup or the timers firing at the tag unconditionally. Reactions triggered by ports are
+ * executed with a conditional EXE, which skips them unless an upstream reaction has set the port
+ * at the current tag. The runtime orders the reactions of each tag by level once the program has
+ * been assembled, see `StaticScheduler_sort_by_level`.
+ *
+ * The schedule is executed by a single worker.
+ */
+class UcStaticScheduleGenerator(
+    private val main: Reactor,
+    private val messageReporter: MessageReporter,
+) {
+  companion object {
+    val scheduleName = "Main_Schedule"
+
+    // Upper bound on the number of tags in the schedule, to not generate huge schedules when the
+    // periods of the timers have a large least common multiple.
+    const val MAX_TAGS = 4096
+
+    fun isEnabled(main: Reactor) =
+        AttributeUtils.getSchedulerAttrValue(main).equals("STATIC", ignoreCase = true)
+  }
+
+  /** A reaction in the instance hierarchy and its C expression, which starts at `main_reactor`. */
+  private class ReactionInstance(val reaction: Reaction, val path: String) {
+    val isTriggeredByStartup =
+        reaction.triggers.any { it is BuiltinTriggerRef && it.type == BuiltinTrigger.STARTUP }
+    val timers =
+        reaction.triggers.filterIsInstance<VarRef>().map { it.variable }.filterIsInstance<Timer>()
+    val isTriggeredByPort = reaction.triggers.any { it is VarRef && it.variable is Port }
+  }
+
+  /** Offset and period of a timer in nanoseconds. A period of 0 means that the timer fires once. */
+  private data class TimerTiming(val offset: Long, val period: Long)
+
+  private val reactions = mutableListOf<ReactionInstance>()
+  private val timings = mutableMapOf<Timer, TimerTiming>()
+
+  /** Times of the tags before the loop and of the tags in one hyperperiod, relative to start. */
+  private var prologue = listOf<Long>()
+  private var loop = listOf<Long>()
+  private var hyperperiod = 0L
+
+  private val timeReg = "reg = &_scheduler.time_reg"
+
+  private fun Reactor.reactionCodeName(reaction: Reaction) =
+      reaction.name ?: "reaction${allReactions.indexOf(reaction)}"
+
+  private fun collectReactions(reactor: Reactor, path: String) {
+    for (reaction in reactor.allReactions) {
+      reactions.add(ReactionInstance(reaction, "${path}.${reactor.reactionCodeName(reaction)}"))
+    }
+    for (inst in reactor.allInstantiations) {
+      for (i in 0 until inst.codeWidth) {
+        collectReactions(inst.reactor, "${path}.${inst.name}[${i}]")
+      }
+    }
+  }
+
+  private fun Expression?.toNanoSeconds(): Long? =
+      when {
+        this == null -> 0L
+        this is Time -> ASTUtils.toTimeValue(this).toNanoSeconds()
+        this is Literal && ASTUtils.isZero(literal) -> 0L
+        else -> null
+      }
+
+  /** Report every construct the StaticScheduler cannot execute. Returns false if there was any. */
+  private fun checkSupported(reactor: Reactor): Boolean {
+    var supported = true
+    fun unsupported(node: EObject, msg: String) {
+      messageReporter.at(node).error("The static scheduler does not support ${msg}")
+      supported = false
+    }
+
+    for (action in reactor.allActions) {
+      unsupported(action, "actions")
+    }
+    if (reactor.hasShutdown) {
+      unsupported(reactor, "shutdown reactions")
+    }
+    for (conn in reactor.allConnections) {
+      if (conn.isPhysical || conn.delay != null) {
+        unsupported(conn, "delayed or physical connections")
+      }
+    }
+    for (timer in reactor.allTimers) {
+      val offset = timer.offset.toNanoSeconds()
+      val period = timer.period.toNanoSeconds()
+      if (offset == null || period == null) {
+        unsupported(timer, "timers whose offset or period is not a time literal")
+      } else {
+        timings[timer] = TimerTiming(offset, period)
+      }
+    }
+    for (inst in reactor.allInstantiations) {
+      supported = checkSupported(inst.reactor) && supported
+    }
+    return supported
+  }
+
+  private fun gcd(a: Long, b: Long): Long = if (b == 0L) a else gcd(b, a % b)
+
+  /** Compute the tags of the prologue and of the loop. Returns false if there are too many. */
+  private fun computeTags(): Boolean {
+    val used = reactions.flatMap { it.timers }.distinct().mapNotNull { timings[it] }
+    val periodic = used.filter { it.period > 0 }
+    val oneShots = used.filter { it.period == 0L }
+    val hasStartup = reactions.any { it.isTriggeredByStartup }
+
+    try {
+      hyperperiod =
+          periodic.fold(0L) { h, t ->
+            if (h == 0L) t.period else Math.multiplyExact(h / gcd(h, t.period), t.period)
+          }
+    } catch (e: ArithmeticException) {
+      messageReporter
+          .at(main)
+          .error("The hyperperiod of the timers is too long for the static scheduler")
+      return false
+    }
+
+    // The loop starts once all periodic timers have started and all other triggers have fired.
+    val loopStart =
+        (periodic.map { it.offset } +
+                oneShots.map { it.offset + 1 } +
+                (if (hasStartup) listOf(1L) else listOf()))
+            .maxOrNull() ?: 0L
+    val numTags =
+        periodic.sumOf { (loopStart + hyperperiod - it.offset) / it.period + 1 } + oneShots.size + 1
+    if (numTags > MAX_TAGS) {
+      messageReporter
+          .at(main)
+          .error("The static schedule would have more than ${MAX_TAGS} tags")
+      return false
+    }
+
+    val firings = mutableSetOf<Long>()
+    if (hasStartup) firings.add(0L)
+    oneShots.forEach { firings.add(it.offset) }
+    for (timer in periodic) {
+      var time = timer.offset
+      while (time < loopStart + hyperperiod) {
+        firings.add(time)
+        time += timer.period
+      }
+    }
+    prologue = firings.filter { it < loopStart }.sorted()
+    loop = firings.filter { it >= loopStart }.sorted()
+    return true
+  }
+
+  /**
+   * Check that the program can be executed by the StaticScheduler and compute its tags. Returns
+   * false and reports an error otherwise.
+   */
+  fun prepare(): Boolean {
+    val platform = AttributeUtils.getPlatform(main)
+    when (platform) {
+      PlatformType.Platform.RIOT,
+      PlatformType.Platform.PATMOS,
+      PlatformType.Platform.FREERTOS,
+      PlatformType.Platform.ESPIDF -> {
+        messageReporter.at(main).error("The static scheduler is not supported on ${platform}")
+        return false
+      }
+      else -> {}
+    }
+    if (!checkSupported(main)) return false
+    collectReactions(main, "main_reactor")
+    return computeTags()
+  }
+
+  private fun ReactionInstance.firesAt(time: Long) =
+      timers.any { timer ->
+        val timing = timings[timer]!!
+        if (timing.period == 0L) time == timing.offset
+        else time >= timing.offset && (time - timing.offset) % timing.period == 0L
+      }
+
+  private fun generateInst(
+      opcode: String,
+      op1: String? = null,
+      op2: String? = null,
+      op3: String? = null,
+  ) =
+      listOfNotNull(
+              ".func = execute_inst_${opcode}",
+              ".opcode = ${opcode}",
+              op1?.let { ".op1.${it}" },
+              op2?.let { ".op2.${it}" },
+              op3?.let { ".op3.${it}" })
+          .joinToString(prefix = "{", separator = ", ", postfix = "}")
+
+  /**
+   * The instructions of the tag at [time], which continue with the tag at [next]. The schedule
+   * branches to [end] once the tag is past the stop time.
+   */
+  private fun generateTag(time: Long, next: Long?, end: Int): List<String> {
+    val insts = mutableListOf<String>()
+    insts.add(generateInst("BLT", "reg = &_scheduler.stop_time_reg", timeReg, "imm = ${end}"))
+    insts.add(generateInst("DU", timeReg, "imm = 0"))
+    for (r in reactions) {
+      val unconditional = (r.isTriggeredByStartup && time == 0L) || r.firesAt(time)
+      if (unconditional || r.isTriggeredByPort) {
+        val condition = if (unconditional) null else "imm = 1"
+        insts.add(generateInst("EXE", null, "reg = (reg_t*)&${r.path}.super", condition))
+      }
+    }
+    if (next != null) {
+      insts.add(generateInst("ADVI", timeReg, timeReg, "imm = ${next - time}LL"))
+    }
+    return insts
+  }
+
+  /** The instructions of the schedule, which ends with the STP instruction at [end]. */
+  private fun generateInstructions(end: Int): List<String> {
+    val insts = mutableListOf<String>()
+    val first = prologue.firstOrNull() ?: loop.firstOrNull()
+    if (first != null && first != 0L) {
+      insts.add(
+          generateInst("ADDI", timeReg, "reg = &_scheduler.start_time_reg", "imm = ${first}LL"))
+    }
+    prologue.forEachIndexed { i, time ->
+      insts.addAll(generateTag(time, prologue.getOrNull(i + 1) ?: loop.firstOrNull(), end))
+    }
+    val loopStart = insts.size
+    loop.forEachIndexed { i, time ->
+      insts.addAll(generateTag(time, loop.getOrNull(i + 1) ?: (loop.first() + hyperperiod), end))
+    }
+    if (loop.isNotEmpty()) {
+      insts.add(generateInst("JAL", "reg = NULL", "imm = ${loopStart}"))
+    }
+    insts.add(generateInst("STP"))
+    return insts
+  }
+
+  // The index of the STP instruction is only known once the other instructions are generated.
+  private fun generateInstructions() = generateInstructions(generateInstructions(0).size - 1)
+
+  fun generateDefineSchedule() =
+      with(PrependOperator) {
+        """
+            |// Static schedule with a prologue of ${prologue.size} tags, followed by a loop over
+            |// ${loop.size} tags which repeats every ${hyperperiod} nsec. It is not const, because
+            |// the reactions of each tag are sorted by level at startup.
+            |static inst_t ${scheduleName}_worker0[] = {
+        ${" |  "..generateInstructions().joinToString(",\n")}
+            |};
+            |static const inst_t* ${scheduleName}[1] = {${scheduleName}_worker0};
+        """
+            .trimMargin()
+      }
+
+  fun generateSortSchedule() =
+      "StaticScheduler_sort_by_level(${scheduleName}_worker0, sizeof(${scheduleName}_worker0) / sizeof(inst_t));"
+}